@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "SchemaConfig.hpp"
+#include "ColumnType.hpp"
+#include "ColumnConfigInstance.hpp"
+#include "TableNameList.hpp"
+
+
+// Child table names and their tag values, computed once per job and shared by
+// the steps that need them (create-child-table, insert), so every step sees the
+// same tags for a table. Generator tags are produced in parallel chunks.
+class TableCatalog {
+public:
+    // Names and tags of the schema's child tables, generating tags on up to
+    // threads threads (0: one per core)
+    static std::shared_ptr<const TableCatalog> build(const SchemaConfig& schema, size_t threads = 0);
+
+    // The catalog in the schema's slot, built on first use. A cached catalog
+    // without tags is rebuilt for a schema that has them.
+    static std::shared_ptr<const TableCatalog> shared(const SchemaConfig& schema);
+
+    // Tag rows for names: fresh generators per chunk, one per table when a
+    // tag is an expression (it may use the table name), a single serial
+    // generator when a tag carries state across tables (e.g. order)
+    static std::vector<RowType> generate_tags(const TableNameList& names,
+                                              const ColumnConfigInstanceVector& instances,
+                                              std::optional<uint64_t> seed,
+                                              size_t threads = 0);
+
+    // Drop the catalog cached in the schema's slot once the last step that
+    // reads it has taken its tags; a later step sharing the slot rebuilds it
+    static void release(const SchemaConfig& schema);
+
+    const TableNameList& names() const { return names_; }
+    size_t size() const { return names_.size(); }
+
+    bool has_tags() const { return tags_.size() > 0; }
+    // Tag values of a table, decoded from the packed rows
+    RowType tags(size_t table) const { return tags_.at(table); }
+
+private:
+    // Rows back to back: each value is its variant index and then its fixed
+    // width bytes, or a 32-bit length and the bytes of a string-like value
+    struct PackedRows {
+        std::vector<char> bytes;
+        std::vector<uint64_t> offsets{0};   // size() + 1 entries
+
+        size_t size() const { return offsets.size() - 1; }
+        void append(const RowType& row);
+        void append(const PackedRows& other);
+        RowType at(size_t row) const;
+    };
+
+    static PackedRows generate_packed(const TableNameList& names,
+                                      const ColumnConfigInstanceVector& instances,
+                                      std::optional<uint64_t> seed,
+                                      size_t threads);
+
+    TableNameList names_;
+    PackedRows tags_;                   // Empty, or one row per table
+};
@@ -0,0 +1,293 @@
+#include "TableCatalog.hpp"
+#include "TableNameGenerator.hpp"
+#include "TableNameCSVReader.hpp"
+#include "TagsCSVReader.hpp"
+#include "RowGenerator.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+// Fewer tables than this per thread are not worth a thread
+static constexpr size_t MIN_TABLES_PER_THREAD = 4096;
+
+// Rows generated at once by an unseeded chunk before they are packed
+static constexpr size_t PACK_BATCH_ROWS = 1024;
+
+namespace {
+    void put_bytes(std::vector<char>& out, const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    void put_text(std::vector<char>& out, const void* data, size_t size) {
+        const uint32_t length = static_cast<uint32_t>(size);
+        put_bytes(out, &length, sizeof(length));
+        put_bytes(out, data, size);
+    }
+
+    template<typename T>
+    void put_value(std::vector<char>& out, const T& value) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            put_bytes(out, &value, sizeof(value));
+        } else if constexpr (std::is_same_v<T, Decimal>) {
+            put_text(out, value.value.data(), value.value.size());
+        } else if constexpr (std::is_same_v<T, JsonValue>) {
+            put_text(out, value.raw_json.data(), value.raw_json.size());
+        } else if constexpr (std::is_same_v<T, Geometry>) {
+            put_text(out, value.wkt.data(), value.wkt.size());
+        } else {
+            // std::string, std::u16string, std::vector<uint8_t>
+            put_text(out, value.data(), value.size() * sizeof(typename T::value_type));
+        }
+    }
+
+    template<typename T>
+    T get_value(const char*& in) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            T value;
+            std::memcpy(&value, in, sizeof(value));
+            in += sizeof(value);
+            return value;
+        } else {
+            uint32_t length;
+            std::memcpy(&length, in, sizeof(length));
+            in += sizeof(length);
+            const char* data = in;
+            in += length;
+
+            if constexpr (std::is_same_v<T, Decimal>) {
+                return Decimal{std::string(data, length)};
+            } else if constexpr (std::is_same_v<T, JsonValue>) {
+                return JsonValue{std::string(data, length)};
+            } else if constexpr (std::is_same_v<T, Geometry>) {
+                return Geometry{std::string(data, length)};
+            } else {
+                T value(length / sizeof(typename T::value_type), typename T::value_type{});
+                std::memcpy(value.data(), data, length);
+                return value;
+            }
+        }
+    }
+
+    template<size_t... I>
+    ColumnType get_any(size_t index, const char*& in, std::index_sequence<I...>) {
+        using Getter = ColumnType (*)(const char*&);
+        static constexpr Getter getters[] = {
+            [](const char*& p) -> ColumnType { return get_value<std::variant_alternative_t<I, ColumnType>>(p); }...
+        };
+        return getters[index](in);
+    }
+}
+
+void TableCatalog::PackedRows::append(const RowType& row) {
+    for (const auto& value : row) {
+        bytes.push_back(static_cast<char>(value.index()));
+        std::visit([this](const auto& v) { put_value(bytes, v); }, value);
+    }
+    offsets.push_back(bytes.size());
+}
+
+void TableCatalog::PackedRows::append(const PackedRows& other) {
+    const uint64_t base = bytes.size();
+    bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+    offsets.reserve(offsets.size() + other.size());
+    for (size_t i = 1; i < other.offsets.size(); ++i) {
+        offsets.push_back(base + other.offsets[i]);
+    }
+}
+
+RowType TableCatalog::PackedRows::at(size_t row) const {
+    RowType values;
+    const char* in = bytes.data() + offsets[row];
+    const char* end = bytes.data() + offsets[row + 1];
+    while (in < end) {
+        const size_t index = static_cast<unsigned char>(*in++);
+        values.push_back(get_any(index, in, std::make_index_sequence<std::variant_size_v<ColumnType>>()));
+    }
+    return values;
+}
+
+std::shared_ptr<const TableCatalog> TableCatalog::build(const SchemaConfig& schema, size_t threads) {
+    auto catalog = std::make_shared<TableCatalog>();
+
+    if (schema.tbname.source_type == "generator") {
+        TableNameGenerator generator(schema.tbname.generator);
+        catalog->names_ = generator.names();
+    } else if (schema.tbname.source_type == "csv") {
+        TableNameCSVReader csv_reader(schema.tbname.csv);
+        catalog->names_ = TableNameList::intern(csv_reader.generate());
+    } else {
+        throw std::runtime_error("Unsupported table name source type: " + schema.tbname.source_type);
+    }
+
+    const auto& tag_schema = schema.tags_cfg.get_schema();
+    if (tag_schema.empty() || catalog->names_.empty()) {
+        return catalog;
+    }
+
+    auto instances = ColumnConfigInstanceFactory::create(tag_schema);
+    if (schema.tags_cfg.source_type == "generator") {
+        catalog->tags_ = generate_packed(catalog->names_, instances, schema.generation.seed, threads);
+    } else if (schema.tags_cfg.source_type == "csv") {
+        TagsCSVReader tags_csv(schema.tags_cfg.csv, instances);
+        const auto rows = tags_csv.generate();
+        if (rows.size() != catalog->names_.size()) {
+            throw std::runtime_error(
+                "Number of tags (" + std::to_string(rows.size()) +
+                ") does not match number of table names (" + std::to_string(catalog->names_.size()) + ")"
+            );
+        }
+        for (const auto& row : rows) {
+            catalog->tags_.append(row);
+        }
+    } else {
+        throw std::runtime_error("Unsupported tags source type: " + schema.tags_cfg.source_type);
+    }
+
+    return catalog;
+}
+
+std::shared_ptr<const TableCatalog> TableCatalog::shared(const SchemaConfig& schema) {
+    if (!schema.catalog) {
+        return build(schema);
+    }
+
+    std::lock_guard<std::mutex> lock(schema.catalog->mutex);
+    const auto& cached = schema.catalog->catalog;
+    const bool needs_tags = !schema.tags_cfg.get_schema().empty();
+    if (!cached || (needs_tags && !cached->has_tags() && !cached->names_.empty())) {
+        schema.catalog->catalog = build(schema);
+    }
+    return schema.catalog->catalog;
+}
+
+void TableCatalog::release(const SchemaConfig& schema) {
+    if (!schema.catalog) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(schema.catalog->mutex);
+    schema.catalog->catalog.reset();
+}
+
+std::vector<RowType> TableCatalog::generate_tags(const TableNameList& names,
+                                                 const ColumnConfigInstanceVector& instances,
+                                                 std::optional<uint64_t> seed,
+                                                 size_t threads) {
+    const auto packed = generate_packed(names, instances, seed, threads);
+    std::vector<RowType> rows;
+    rows.reserve(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        rows.push_back(packed.size() > 0 ? packed.at(i) : RowType{});
+    }
+    return rows;
+}
+
+TableCatalog::PackedRows TableCatalog::generate_packed(const TableNameList& names,
+                                                       const ColumnConfigInstanceVector& instances,
+                                                       std::optional<uint64_t> seed,
+                                                       size_t threads) {
+    const size_t count = names.size();
+    PackedRows packed;
+    if (count == 0 || instances.empty()) {
+        return packed;
+    }
+
+    const bool named = std::any_of(instances.begin(), instances.end(), [](const ColumnConfigInstance& instance) {
+        return instance.config().gen_type == "expression";
+    });
+
+    bool stateful = false;
+    if (!named) {
+        RowGenerator probe(instances);
+        for (const auto& gen : probe.column_generators()) {
+            stateful = stateful || gen->state_words() > 0;
+        }
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, (count + MIN_TABLES_PER_THREAD - 1) / MIN_TABLES_PER_THREAD);
+    if (stateful) {
+        threads = 1;
+    }
+
+    const std::optional<uint64_t> key = seed
+        ? std::optional<uint64_t>(RandomKernels::stream_key(*seed, "tags"))
+        : std::nullopt;
+
+    // With a seed every row is drawn at its table index, so the split does not
+    // change the values. Rows are packed as they are drawn
+    auto fill_chunk = [&](size_t begin, size_t end, PackedRows& out) {
+        RandomKernels::CounterScope scope(key);
+
+        if (named) {
+            std::string buffer;
+            for (size_t i = begin; i < end; ++i) {
+                RowGenerator generator(std::string(names.at(i, buffer)), instances);
+                if (scope.active()) scope.seek(i, 0);
+                out.append(generator.generate());
+            }
+            return;
+        }
+
+        RowGenerator generator(instances);
+        if (scope.active()) {
+            for (size_t i = begin; i < end; ++i) {
+                scope.seek(i, 0);
+                out.append(generator.generate());
+            }
+            return;
+        }
+
+        for (size_t i = begin; i < end; i += PACK_BATCH_ROWS) {
+            for (const auto& row : generator.generate(std::min(PACK_BATCH_ROWS, end - i))) {
+                out.append(row);
+            }
+        }
+    };
+
+    if (threads <= 1) {
+        fill_chunk(0, count, packed);
+        return packed;
+    }
+
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<PackedRows> chunks(threads);
+    workers.reserve(threads);
+
+    const size_t per_thread = (count + threads - 1) / threads;
+    for (size_t t = 0; t < threads; ++t) {
+        const size_t begin = t * per_thread;
+        const size_t end = std::min(begin + per_thread, count);
+        if (begin >= end) break;
+
+        workers.emplace_back([&, t, begin, end] {
+            try {
+                fill_chunk(begin, end, chunks[t]);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    for (auto& chunk : chunks) {
+        packed.append(chunk);
+        chunk = PackedRows();
+    }
+    return packed;
+}
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <cassert>
+#include "TableCatalog.hpp"
+
+SchemaConfig make_schema(int tables) {
+    SchemaConfig schema;
+    schema.tbname.source_type = "generator";
+    schema.tbname.generator.prefix = "d";
+    schema.tbname.generator.count = tables;
+    schema.tags = {
+        {"groupid", "int", "random", 1, 10},
+        {"level", "double", "random", 0.0, 1.0}
+    };
+    schema.apply();
+    return schema;
+}
+
+ColumnConfigInstanceVector make_instances(const ColumnConfigVector& configs) {
+    ColumnConfigInstanceVector instances;
+    for (const auto& config : configs) {
+        instances.emplace_back(config);
+    }
+    return instances;
+}
+
+// Rows of an int and a float tag
+bool same_rows(const std::vector<RowType>& a, const std::vector<RowType>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::get<int>(a[i][0]) != std::get<int>(b[i][0])) return false;
+        if (std::get<float>(a[i][1]) != std::get<float>(b[i][1])) return false;
+    }
+    return true;
+}
+
+void test_build_names_and_tags() {
+    auto schema = make_schema(10000);
+    auto catalog = TableCatalog::build(schema, 4);
+
+    assert(catalog->size() == 10000);
+    assert(catalog->names()[0] == "d0");
+    assert(catalog->names()[9999] == "d9999");
+    assert(catalog->has_tags());
+
+    for (size_t i = 0; i < catalog->size(); ++i) {
+        const auto& tags = catalog->tags(i);
+        assert(tags.size() == 2);
+        const int groupid = std::get<int>(tags[0]);
+        assert(groupid >= 1 && groupid < 10);
+        const double level = std::get<double>(tags[1]);
+        assert(level >= 0.0 && level < 1.0);
+    }
+
+    std::cout << "test_build_names_and_tags passed.\n";
+}
+
+void test_build_without_tags() {
+    auto schema = make_schema(100);
+    schema.tags.clear();
+    schema.apply();
+
+    auto catalog = TableCatalog::build(schema);
+    assert(catalog->size() == 100);
+    assert(!catalog->has_tags());
+
+    std::cout << "test_build_without_tags passed.\n";
+}
+
+void test_seeded_tags_ignore_thread_count() {
+    auto names = TableNameList::sequence("t", 0, 20000);
+    ColumnConfigVector configs = {
+        {"a", "int", "random", 0, 1000000},
+        {"b", "float", "random", 0.0, 1.0}
+    };
+    auto instances = make_instances(configs);
+
+    auto serial = TableCatalog::generate_tags(names, instances, 42, 1);
+    auto parallel = TableCatalog::generate_tags(names, instances, 42, 8);
+    assert(serial.size() == 20000);
+    assert(same_rows(serial, parallel));
+
+    auto other = TableCatalog::generate_tags(names, instances, 43, 8);
+    assert(!same_rows(other, serial));
+
+    std::cout << "test_seeded_tags_ignore_thread_count passed.\n";
+}
+
+void test_stateful_tags_stay_serial() {
+    ColumnConfig order("id", "bigint", "order");
+    order.order_min = 0;
+    order.order_max = 1000000;
+    auto instances = make_instances({order});
+
+    auto names = TableNameList::sequence("t", 0, 50000);
+    auto rows = TableCatalog::generate_tags(names, instances, std::nullopt, 8);
+    assert(rows.size() == 50000);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        assert(std::get<int64_t>(rows[i][0]) == static_cast<int64_t>(i));
+    }
+
+    std::cout << "test_stateful_tags_stay_serial passed.\n";
+}
+
+void test_packed_tags_round_trip() {
+    ColumnConfig flag("on", "bool", "random");
+    ColumnConfig big("id", "bigint", "order");
+    big.order_min = 0;
+    big.order_max = 1000000;
+    ColumnConfig label("label", "varchar(16)", "random");
+    ColumnConfig wide("wide", "nchar(8)", "random");
+    auto instances = make_instances({flag, big, label, wide});
+
+    // One serial generator keeps the order tag counting across tables
+    auto names = TableNameList::sequence("t", 0, 3000);
+    auto rows = TableCatalog::generate_tags(names, instances, std::nullopt, 4);
+    assert(rows.size() == 3000);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        assert(rows[i].size() == 4);
+        assert(std::holds_alternative<bool>(rows[i][0]));
+        assert(std::get<int64_t>(rows[i][1]) == static_cast<int64_t>(i));
+        assert(std::get<std::string>(rows[i][2]).size() == 16);
+        assert(std::get<std::u16string>(rows[i][3]).size() == 8);
+    }
+
+    std::cout << "test_packed_tags_round_trip passed.\n";
+}
+
+void test_release_catalog() {
+    auto schema = make_schema(100);
+    auto first = TableCatalog::shared(schema);
+
+    // Holders keep their copy; the slot builds a new one on next use
+    TableCatalog::release(schema);
+    assert(first->has_tags() && first->size() == 100);
+    auto second = TableCatalog::shared(schema);
+    assert(second != first);
+    assert(second->names()[99] == "d99");
+
+    std::cout << "test_release_catalog passed.\n";
+}
+
+void test_shared_catalog() {
+    auto schema = make_schema(1000);
+    SchemaConfig copy = schema;
+
+    auto first = TableCatalog::shared(schema);
+    auto second = TableCatalog::shared(copy);
+    assert(first == second);
+    assert(first->has_tags());
+
+    // A schema with its own slot gets its own catalog
+    SchemaConfig other = schema;
+    other.catalog = std::make_shared<TableCatalogSlot>();
+    assert(TableCatalog::shared(other) != first);
+
+    // Built without tags, rebuilt once a step needs them
+    SchemaConfig bare = make_schema(1000);
+    bare.tags.clear();
+    bare.apply();
+    SchemaConfig tagged = make_schema(1000);
+    tagged.catalog = bare.catalog;
+
+    auto untagged = TableCatalog::shared(bare);
+    assert(!untagged->has_tags());
+    auto rebuilt = TableCatalog::shared(tagged);
+    assert(rebuilt->has_tags());
+    assert(TableCatalog::shared(bare) == rebuilt);
+
+    std::cout << "test_shared_catalog passed.\n";
+}
+
+int main() {
+    test_build_names_and_tags();
+    test_build_without_tags();
+    test_seeded_tags_ignore_thread_count();
+    test_stateful_tags_stay_serial();
+    test_packed_tags_round_trip();
+    test_shared_catalog();
+    test_release_catalog();
+
+    std::cout << "All TableCatalog tests passed.\n";
+    return 0;
+}
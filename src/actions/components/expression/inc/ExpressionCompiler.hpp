@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Native evaluator for the arithmetic subset of Lua expressions.
+// Supported: numbers, true/false, _i, _last, + - * / % ^, comparisons,
+// and/or/not, parentheses, math.* functions/constants and square().
+// Anything else (strings, _table, tables, user functions) is left to Lua.
+class CompiledExpression {
+public:
+    struct Value {
+        double number = 0.0;
+        bool is_bool = false;
+    };
+
+    // Returns nullptr if the expression is outside the supported subset
+    static std::unique_ptr<CompiledExpression> compile(const std::string& expression);
+
+    // Evaluate with the given call index and last numeric result
+    Value evaluate(int64_t call_index, double last_value) const;
+
+    // Evaluate a run of rows, feeding each numeric result back as _last;
+    // throws if the expression yields a boolean
+    void evaluate_numbers(double* out, size_t count, int64_t& call_index, double& last_value) const;
+
+private:
+    enum class Op : uint8_t {
+        PUSH_NUMBER, PUSH_BOOL, PUSH_INDEX, PUSH_LAST,
+        NEG, NOT,
+        ADD, SUB, MUL, DIV, MOD, POW,
+        EQ, NE, LT, LE, GT, GE,
+        CALL1, CALL2, MIN, MAX, RANDOM, SQUARE,
+        AND_JUMP, OR_JUMP
+    };
+
+    struct Instruction {
+        Op op;
+        int32_t arg = 0;               // argument count or jump target
+        double value = 0.0;            // constant
+        double (*fn1)(double) = nullptr;
+        double (*fn2)(double, double) = nullptr;
+    };
+
+    class Parser;
+
+    std::vector<Instruction> code_;
+    size_t max_stack_ = 0;
+};
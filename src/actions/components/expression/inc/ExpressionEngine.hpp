@@ -1,5 +1,6 @@
 #pragma once
 #include "ColumnType.hpp"
+#include "ExpressionCompiler.hpp"
 #include <memory>
 #include <string>
 #include <variant>
@@ -18,6 +19,25 @@ public:
 
     Result evaluate();
 
+    // True if the expression cannot change between rows of one table: it is
+    // built only from _table, literals, string.*, tonumber, tostring and
+    // indexing. Anything else is per row unless configured per_table: true
+    static bool is_table_invariant(const std::string& expression);
+
+    // Whether the expression runs on the native evaluator instead of Lua
+    bool is_compiled() const { return compiled_ != nullptr; }
+
+    // Native path only: evaluate count numeric results in one call
+    void evaluate_numbers(double* out, size_t count);
+
+    // Batch mode: wrap the Lua formula in a loop that stores each result as
+    // ctype (e.g. "int32_t") through a LuaJIT FFI pointer; false if unavailable
+    bool prepare_batch(const std::string& ctype);
+    bool has_batch() const { return state_ && state_->batch_ref != LUA_NOREF; }
+
+    // Evaluate count rows with a single pcall, writing straight into out
+    void evaluate_batch(void* out, size_t count);
+
     // Disable copy and move
     ExpressionEngine(const ExpressionEngine&) = delete;
     ExpressionEngine& operator=(const ExpressionEngine&) = delete;
@@ -44,12 +64,14 @@ private:
         int call_index = 0;
         std::string table_name;
         double last_value = 0.0;
+        int batch_ref = LUA_NOREF;
 
         ExpressionState(std::shared_ptr<ExpressionTemplate> tpl, const std::string& tbl_name)
             : template_(std::move(tpl)), call_index(0), table_name(tbl_name) {}
     };
 
     std::unique_ptr<ExpressionState> state_;
+    std::unique_ptr<CompiledExpression> compiled_;
 
     // Get thread-local context
     static ThreadLocalContext& get_thread_context();
@@ -0,0 +1,519 @@
+#include "ExpressionCompiler.hpp"
+#include "MathFunctions.hpp"
+#include "RandomKernels.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    constexpr size_t MAX_STACK_DEPTH = 64;
+
+    // Thrown while parsing when the expression leaves the supported subset
+    struct Unsupported {};
+
+    enum class TokenType { NUMBER, NAME, OP, END };
+
+    struct Token {
+        TokenType type = TokenType::END;
+        std::string text;
+        double number = 0.0;
+    };
+
+    using Fn1 = double(*)(double);
+    using Fn2 = double(*)(double, double);
+
+    const std::unordered_map<std::string, Fn1>& unary_math_functions() {
+        static const std::unordered_map<std::string, Fn1> functions = {
+            {"abs",   [](double x) { return std::fabs(x); }},
+            {"ceil",  [](double x) { return std::ceil(x); }},
+            {"floor", [](double x) { return std::floor(x); }},
+            {"sqrt",  [](double x) { return std::sqrt(x); }},
+            {"sin",   [](double x) { return std::sin(x); }},
+            {"cos",   [](double x) { return std::cos(x); }},
+            {"tan",   [](double x) { return std::tan(x); }},
+            {"asin",  [](double x) { return std::asin(x); }},
+            {"acos",  [](double x) { return std::acos(x); }},
+            {"atan",  [](double x) { return std::atan(x); }},
+            {"sinh",  [](double x) { return std::sinh(x); }},
+            {"cosh",  [](double x) { return std::cosh(x); }},
+            {"tanh",  [](double x) { return std::tanh(x); }},
+            {"exp",   [](double x) { return std::exp(x); }},
+            {"log",   [](double x) { return std::log(x); }},
+            {"log10", [](double x) { return std::log10(x); }},
+            {"deg",   [](double x) { return x * (180.0 / M_PI); }},
+            {"rad",   [](double x) { return x * (M_PI / 180.0); }},
+        };
+        return functions;
+    }
+
+    const std::unordered_map<std::string, Fn2>& binary_math_functions() {
+        static const std::unordered_map<std::string, Fn2> functions = {
+            {"fmod",  [](double x, double y) { return std::fmod(x, y); }},
+            {"pow",   [](double x, double y) { return std::pow(x, y); }},
+            {"atan2", [](double y, double x) { return std::atan2(y, x); }},
+            {"log",   [](double x, double base) { return std::log(x) / std::log(base); }},
+        };
+        return functions;
+    }
+
+    inline bool truthy(const CompiledExpression::Value& v) {
+        return !(v.is_bool && v.number == 0.0);
+    }
+
+    inline void check_arith(const CompiledExpression::Value& a, const CompiledExpression::Value& b) {
+        if (a.is_bool || b.is_bool) {
+            throw std::runtime_error("Runtime error: attempt to perform arithmetic on a boolean value");
+        }
+    }
+
+    inline void check_compare(const CompiledExpression::Value& a, const CompiledExpression::Value& b) {
+        if (a.is_bool || b.is_bool) {
+            throw std::runtime_error("Runtime error: attempt to compare boolean values");
+        }
+    }
+}
+
+// Recursive-descent parser emitting postfix code; precedence follows Lua 5.1
+class CompiledExpression::Parser {
+public:
+    Parser(const std::string& source, CompiledExpression& out) : src_(source), out_(out) {
+        next();
+    }
+
+    void parse() {
+        parse_or();
+        if (tok_.type != TokenType::END) throw Unsupported{};
+    }
+
+private:
+    const std::string& src_;
+    size_t pos_ = 0;
+    Token tok_;
+    CompiledExpression& out_;
+    size_t depth_ = 0;
+
+    void next() {
+        while (pos_ < src_.size() && std::isspace(static_cast<unsigned char>(src_[pos_]))) ++pos_;
+
+        tok_ = Token{};
+        if (pos_ >= src_.size()) return;
+
+        const char c = src_[pos_];
+        if (std::isdigit(static_cast<unsigned char>(c)) ||
+            (c == '.' && pos_ + 1 < src_.size() && std::isdigit(static_cast<unsigned char>(src_[pos_ + 1])))) {
+            const char* begin = src_.c_str() + pos_;
+            char* end = nullptr;
+            tok_.number = std::strtod(begin, &end);
+            pos_ += static_cast<size_t>(end - begin);
+            if (pos_ < src_.size() && (std::isalnum(static_cast<unsigned char>(src_[pos_])) || src_[pos_] == '_' || src_[pos_] == '.')) {
+                throw Unsupported{};
+            }
+            tok_.type = TokenType::NUMBER;
+            return;
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = pos_;
+            while (pos_ < src_.size() && (std::isalnum(static_cast<unsigned char>(src_[pos_])) || src_[pos_] == '_')) ++pos_;
+            tok_.type = TokenType::NAME;
+            tok_.text = src_.substr(start, pos_ - start);
+            return;
+        }
+
+        static const char* two_char_ops[] = {"==", "~=", "<=", ">="};
+        for (const char* op : two_char_ops) {
+            if (src_.compare(pos_, 2, op) == 0) {
+                tok_.type = TokenType::OP;
+                tok_.text = op;
+                pos_ += 2;
+                return;
+            }
+        }
+
+        // "--" starts a Lua comment, ".." is concatenation: both left to Lua
+        if (src_.compare(pos_, 2, "--") == 0 || src_.compare(pos_, 2, "..") == 0) {
+            throw Unsupported{};
+        }
+
+        if (std::string("+-*/%^()<>,.").find(c) != std::string::npos) {
+            tok_.type = TokenType::OP;
+            tok_.text = std::string(1, c);
+            ++pos_;
+            return;
+        }
+
+        throw Unsupported{};
+    }
+
+    bool is_op(const char* op) const {
+        return tok_.type == TokenType::OP && tok_.text == op;
+    }
+
+    bool is_name(const char* name) const {
+        return tok_.type == TokenType::NAME && tok_.text == name;
+    }
+
+    void expect_op(const char* op) {
+        if (!is_op(op)) throw Unsupported{};
+        next();
+    }
+
+    size_t emit(Op op, int32_t arg = 0, double value = 0.0) {
+        Instruction ins;
+        ins.op = op;
+        ins.arg = arg;
+        ins.value = value;
+        out_.code_.push_back(ins);
+        return out_.code_.size() - 1;
+    }
+
+    void push_depth() {
+        ++depth_;
+        if (depth_ > MAX_STACK_DEPTH) throw Unsupported{};
+        if (depth_ > out_.max_stack_) out_.max_stack_ = depth_;
+    }
+
+    void pop_depth(size_t n) {
+        depth_ -= n;
+    }
+
+    void parse_or() {
+        parse_and();
+        while (is_name("or")) {
+            next();
+            size_t jump = emit(Op::OR_JUMP);
+            pop_depth(1);
+            parse_and();
+            out_.code_[jump].arg = static_cast<int32_t>(out_.code_.size());
+        }
+    }
+
+    void parse_and() {
+        parse_comparison();
+        while (is_name("and")) {
+            next();
+            size_t jump = emit(Op::AND_JUMP);
+            pop_depth(1);
+            parse_comparison();
+            out_.code_[jump].arg = static_cast<int32_t>(out_.code_.size());
+        }
+    }
+
+    void parse_comparison() {
+        parse_additive();
+        while (true) {
+            Op op;
+            if (is_op("==")) op = Op::EQ;
+            else if (is_op("~=")) op = Op::NE;
+            else if (is_op("<")) op = Op::LT;
+            else if (is_op("<=")) op = Op::LE;
+            else if (is_op(">")) op = Op::GT;
+            else if (is_op(">=")) op = Op::GE;
+            else break;
+            next();
+            parse_additive();
+            emit(op);
+            pop_depth(1);
+        }
+    }
+
+    void parse_additive() {
+        parse_multiplicative();
+        while (is_op("+") || is_op("-")) {
+            Op op = is_op("+") ? Op::ADD : Op::SUB;
+            next();
+            parse_multiplicative();
+            emit(op);
+            pop_depth(1);
+        }
+    }
+
+    void parse_multiplicative() {
+        parse_unary();
+        while (is_op("*") || is_op("/") || is_op("%")) {
+            Op op = is_op("*") ? Op::MUL : (is_op("/") ? Op::DIV : Op::MOD);
+            next();
+            parse_unary();
+            emit(op);
+            pop_depth(1);
+        }
+    }
+
+    void parse_unary() {
+        if (is_name("not")) {
+            next();
+            parse_unary();
+            emit(Op::NOT);
+        } else if (is_op("-")) {
+            next();
+            parse_unary();
+            emit(Op::NEG);
+        } else {
+            parse_power();
+        }
+    }
+
+    void parse_power() {
+        parse_primary();
+        if (is_op("^")) {
+            next();
+            parse_unary();   // right associative, exponent may carry a sign
+            emit(Op::POW);
+            pop_depth(1);
+        }
+    }
+
+    size_t parse_arguments() {
+        expect_op("(");
+        size_t argc = 0;
+        if (!is_op(")")) {
+            parse_or();
+            ++argc;
+            while (is_op(",")) {
+                next();
+                parse_or();
+                ++argc;
+            }
+        }
+        expect_op(")");
+        return argc;
+    }
+
+    void parse_primary() {
+        if (tok_.type == TokenType::NUMBER) {
+            emit(Op::PUSH_NUMBER, 0, tok_.number);
+            push_depth();
+            next();
+            return;
+        }
+
+        if (is_op("(")) {
+            next();
+            parse_or();
+            expect_op(")");
+            return;
+        }
+
+        if (tok_.type != TokenType::NAME) throw Unsupported{};
+
+        const std::string name = tok_.text;
+        next();
+
+        if (name == "_i") {
+            emit(Op::PUSH_INDEX);
+            push_depth();
+        } else if (name == "_last") {
+            emit(Op::PUSH_LAST);
+            push_depth();
+        } else if (name == "true" || name == "false") {
+            emit(Op::PUSH_BOOL, 0, name == "true" ? 1.0 : 0.0);
+            push_depth();
+        } else if (name == "math") {
+            expect_op(".");
+            if (tok_.type != TokenType::NAME) throw Unsupported{};
+            parse_math(tok_.text);
+        } else if (name == "square") {
+            if (parse_arguments() != 4) throw Unsupported{};
+            emit(Op::SQUARE);
+            pop_depth(3);
+        } else {
+            throw Unsupported{};
+        }
+    }
+
+    void parse_math(const std::string member) {
+        next();
+
+        if (member == "pi" || member == "huge") {
+            emit(Op::PUSH_NUMBER, 0, member == "pi" ? M_PI : HUGE_VAL);
+            push_depth();
+            return;
+        }
+
+        const size_t argc = parse_arguments();
+
+        if (member == "min" || member == "max") {
+            if (argc == 0) throw Unsupported{};
+            emit(member == "min" ? Op::MIN : Op::MAX, static_cast<int32_t>(argc));
+            pop_depth(argc - 1);
+        } else if (member == "random") {
+            if (argc > 2) throw Unsupported{};
+            emit(Op::RANDOM, static_cast<int32_t>(argc));
+            if (argc == 0) push_depth();
+            else pop_depth(argc - 1);
+        } else if (argc == 1 && unary_math_functions().count(member)) {
+            out_.code_[emit(Op::CALL1)].fn1 = unary_math_functions().at(member);
+        } else if (argc == 2 && binary_math_functions().count(member)) {
+            out_.code_[emit(Op::CALL2)].fn2 = binary_math_functions().at(member);
+            pop_depth(1);
+        } else {
+            throw Unsupported{};
+        }
+    }
+};
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(const std::string& expression) {
+    auto compiled = std::unique_ptr<CompiledExpression>(new CompiledExpression());
+    try {
+        Parser parser(expression, *compiled);
+        parser.parse();
+    } catch (const Unsupported&) {
+        return nullptr;
+    }
+    return compiled;
+}
+
+CompiledExpression::Value CompiledExpression::evaluate(int64_t call_index, double last_value) const {
+    Value stack[MAX_STACK_DEPTH];
+    size_t sp = 0;
+    const size_t code_size = code_.size();
+
+    for (size_t pc = 0; pc < code_size; ++pc) {
+        const Instruction& ins = code_[pc];
+        switch (ins.op) {
+            case Op::PUSH_NUMBER:
+                stack[sp++] = Value{ins.value, false};
+                break;
+            case Op::PUSH_BOOL:
+                stack[sp++] = Value{ins.value, true};
+                break;
+            case Op::PUSH_INDEX:
+                stack[sp++] = Value{static_cast<double>(call_index), false};
+                break;
+            case Op::PUSH_LAST:
+                stack[sp++] = Value{last_value, false};
+                break;
+            case Op::NEG:
+                check_arith(stack[sp - 1], stack[sp - 1]);
+                stack[sp - 1].number = -stack[sp - 1].number;
+                break;
+            case Op::NOT:
+                stack[sp - 1] = Value{truthy(stack[sp - 1]) ? 0.0 : 1.0, true};
+                break;
+            case Op::ADD:
+            case Op::SUB:
+            case Op::MUL:
+            case Op::DIV:
+            case Op::MOD:
+            case Op::POW: {
+                const Value b = stack[--sp];
+                Value& a = stack[sp - 1];
+                check_arith(a, b);
+                switch (ins.op) {
+                    case Op::ADD: a.number += b.number; break;
+                    case Op::SUB: a.number -= b.number; break;
+                    case Op::MUL: a.number *= b.number; break;
+                    case Op::DIV: a.number /= b.number; break;
+                    case Op::MOD: a.number = a.number - std::floor(a.number / b.number) * b.number; break;
+                    default:      a.number = std::pow(a.number, b.number); break;
+                }
+                break;
+            }
+            case Op::EQ:
+            case Op::NE: {
+                const Value b = stack[--sp];
+                Value& a = stack[sp - 1];
+                bool equal = (a.is_bool == b.is_bool) && (a.number == b.number);
+                a = Value{(equal == (ins.op == Op::EQ)) ? 1.0 : 0.0, true};
+                break;
+            }
+            case Op::LT:
+            case Op::LE:
+            case Op::GT:
+            case Op::GE: {
+                const Value b = stack[--sp];
+                Value& a = stack[sp - 1];
+                check_compare(a, b);
+                bool r;
+                switch (ins.op) {
+                    case Op::LT: r = a.number < b.number; break;
+                    case Op::LE: r = a.number <= b.number; break;
+                    case Op::GT: r = a.number > b.number; break;
+                    default:     r = a.number >= b.number; break;
+                }
+                a = Value{r ? 1.0 : 0.0, true};
+                break;
+            }
+            case Op::CALL1:
+                check_arith(stack[sp - 1], stack[sp - 1]);
+                stack[sp - 1].number = ins.fn1(stack[sp - 1].number);
+                break;
+            case Op::CALL2: {
+                const Value b = stack[--sp];
+                Value& a = stack[sp - 1];
+                check_arith(a, b);
+                a.number = ins.fn2(a.number, b.number);
+                break;
+            }
+            case Op::MIN:
+            case Op::MAX: {
+                const size_t argc = static_cast<size_t>(ins.arg);
+                Value* args = stack + sp - argc;
+                double r = args[0].number;
+                for (size_t k = 0; k < argc; ++k) {
+                    check_arith(args[k], args[k]);
+                    r = (ins.op == Op::MIN) ? std::min(r, args[k].number) : std::max(r, args[k].number);
+                }
+                sp -= argc - 1;
+                stack[sp - 1] = Value{r, false};
+                break;
+            }
+            case Op::RANDOM: {
+                // Same mapping as LuaJIT: [0,1), [1,m] or [m,n]; drawn from
+                // RandomKernels so a seeded run reproduces it
+                const double u = RandomKernels::next_unit();
+                if (ins.arg == 0) {
+                    stack[sp++] = Value{u, false};
+                } else if (ins.arg == 1) {
+                    check_arith(stack[sp - 1], stack[sp - 1]);
+                    stack[sp - 1].number = std::floor(u * stack[sp - 1].number) + 1.0;
+                } else {
+                    const Value n = stack[--sp];
+                    Value& m = stack[sp - 1];
+                    check_arith(m, n);
+                    m.number = std::floor(u * (n.number - m.number + 1.0)) + m.number;
+                }
+                break;
+            }
+            case Op::SQUARE: {
+                sp -= 3;
+                Value* args = stack + sp - 1;
+                for (size_t k = 0; k < 4; ++k) check_arith(args[k], args[k]);
+                args[0] = Value{MathFunctions::square_wave(static_cast<int>(call_index),
+                                                           args[0].number, args[1].number,
+                                                           static_cast<int>(args[2].number),
+                                                           static_cast<int>(args[3].number)), false};
+                break;
+            }
+            case Op::AND_JUMP:
+                if (!truthy(stack[sp - 1])) {
+                    pc = static_cast<size_t>(ins.arg) - 1;
+                } else {
+                    --sp;
+                }
+                break;
+            case Op::OR_JUMP:
+                if (truthy(stack[sp - 1])) {
+                    pc = static_cast<size_t>(ins.arg) - 1;
+                } else {
+                    --sp;
+                }
+                break;
+        }
+    }
+
+    return stack[0];
+}
+
+void CompiledExpression::evaluate_numbers(double* out, size_t count, int64_t& call_index, double& last_value) const {
+    for (size_t i = 0; i < count; ++i) {
+        const Value v = evaluate(call_index++, last_value);
+        if (v.is_bool) {
+            throw std::runtime_error("Invalid return type");
+        }
+        out[i] = v.number;
+        last_value = v.number;
+    }
+}
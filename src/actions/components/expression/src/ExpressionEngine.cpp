@@ -1,8 +1,13 @@
 #include "ExpressionEngine.hpp"
 #include "RegistryFunctions.hpp"
+#include "RandomKernels.hpp"
 #include <stdexcept>
 #include <sstream>
 #include <cassert>
+#include <cctype>
+#include <cstring>
+#include <unordered_set>
+#include <cmath>
 
 // Explicitly register all modules
 void register_all_custom_modules() {
@@ -12,6 +17,49 @@ void register_all_custom_modules() {
     // Add more modules...
 }
 
+namespace {
+    // math.random with LuaJIT's argument mapping, drawn from RandomKernels so
+    // Lua-fallback and batch formulas follow the run seed like compiled ones
+    int lua_math_random(lua_State* L) {
+        const double u = RandomKernels::next_unit();
+        switch (lua_gettop(L)) {
+            case 0:
+                lua_pushnumber(L, u);
+                break;
+            case 1: {
+                const double m = luaL_checknumber(L, 1);
+                luaL_argcheck(L, 1.0 <= m, 1, "interval is empty");
+                lua_pushnumber(L, std::floor(u * m) + 1.0);
+                break;
+            }
+            case 2: {
+                const double m = luaL_checknumber(L, 1);
+                const double n = luaL_checknumber(L, 2);
+                luaL_argcheck(L, m <= n, 2, "interval is empty");
+                lua_pushnumber(L, std::floor(u * (n - m + 1.0)) + m);
+                break;
+            }
+            default:
+                return luaL_error(L, "wrong number of arguments");
+        }
+        return 1;
+    }
+
+    // Seeding is owned by the run seed; a formula cannot reseed the stream
+    int lua_math_randomseed(lua_State*) {
+        return 0;
+    }
+
+    void override_math_random(lua_State* L) {
+        lua_getglobal(L, "math");
+        lua_pushcfunction(L, lua_math_random);
+        lua_setfield(L, -2, "random");
+        lua_pushcfunction(L, lua_math_randomseed);
+        lua_setfield(L, -2, "randomseed");
+        lua_pop(L, 1);
+    }
+}
+
 // --------------------------
 // ThreadLocalContext implementation
 // --------------------------
@@ -25,6 +73,7 @@ ExpressionEngine::ThreadLocalContext::ThreadLocalContext() {
 
     // Open base libraries
     luaL_openlibs(lua_vm);
+    override_math_random(lua_vm);
 
     // Register all custom functions
     FunctionRegistry::instance().register_all(lua_vm);
@@ -97,6 +146,13 @@ ExpressionEngine::get_template(const std::string& expression, ThreadLocalContext
 // ExpressionEngine implementation
 // --------------------------
 ExpressionEngine::ExpressionEngine(const std::string& table_name, const std::string& expression) {
+    // Prefer the native evaluator, Lua is only needed for what it cannot handle
+    compiled_ = CompiledExpression::compile(expression);
+    if (compiled_) {
+        state_ = std::make_unique<ExpressionState>(nullptr, table_name);
+        return;
+    }
+
     // Get thread-local context
     auto& context = get_thread_context();
 
@@ -115,6 +171,15 @@ ExpressionEngine::Result ExpressionEngine::evaluate() {
     //     throw std::runtime_error("Expression engine not initialized");
     // }
 
+    if (compiled_) {
+        auto value = compiled_->evaluate(state_->call_index++, state_->last_value);
+        if (value.is_bool) {
+            return value.number != 0.0;
+        }
+        state_->last_value = value.number;
+        return value.number;
+    }
+
     // Get thread-local context
     auto& context = get_thread_context();
     lua_State* L = context.lua_vm;
@@ -162,4 +227,197 @@ ExpressionEngine::Result ExpressionEngine::evaluate() {
 
     lua_pop(L, 1);
     return result;
-}
\ No newline at end of file
+}
+
+bool ExpressionEngine::is_table_invariant(const std::string& expression) {
+    // Names known not to change between rows of one table; anything else
+    // (_i, _last, math.*, registered functions, globals) needs per_table: true
+    static const std::unordered_set<std::string> allowed = {
+        "_table", "tonumber", "tostring", "and", "or", "not", "nil", "true", "false"
+    };
+    static const std::unordered_set<std::string> string_functions = {
+        "byte", "char", "find", "format", "gsub", "len", "lower", "match", "rep", "reverse", "sub", "upper"
+    };
+
+    const size_t n = expression.size();
+    auto is_ident_start = [](char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; };
+    auto is_ident_char = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+    auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+
+    // Length of a long bracket opener "[[" / "[==[" at pos, 0 if none
+    auto long_bracket = [&](size_t pos) -> size_t {
+        if (expression[pos] != '[') return 0;
+        size_t k = pos + 1;
+        while (k < n && expression[k] == '=') ++k;
+        return (k < n && expression[k] == '[') ? k - pos + 1 : 0;
+    };
+
+    // Skip a long string/comment whose opener of the given length starts at pos
+    auto skip_long = [&](size_t pos, size_t open_len) -> size_t {
+        const std::string close = "]" + std::string(open_len - 2, '=') + "]";
+        size_t end = expression.find(close, pos + open_len);
+        return end == std::string::npos ? n : end + close.size();
+    };
+
+    auto read_ident = [&](size_t& pos) {
+        const size_t start = pos;
+        while (pos < n && is_ident_char(expression[pos])) ++pos;
+        return expression.substr(start, pos - start);
+    };
+
+    auto next_char = [&](size_t pos) {
+        while (pos < n && std::isspace(static_cast<unsigned char>(expression[pos]))) ++pos;
+        return pos;
+    };
+
+    for (size_t i = 0; i < n; ) {
+        const char c = expression[i];
+
+        if (c == '"' || c == '\'') {
+            for (++i; i < n && expression[i] != c; ++i) {
+                if (expression[i] == '\\') ++i;
+            }
+            ++i;
+        } else if (c == '-' && i + 1 < n && expression[i + 1] == '-') {
+            size_t open_len = (i + 2 < n) ? long_bracket(i + 2) : 0;
+            if (open_len) {
+                i = skip_long(i + 2, open_len);
+            } else {
+                size_t eol = expression.find('\n', i);
+                i = eol == std::string::npos ? n : eol + 1;
+            }
+        } else if (size_t open_len = long_bracket(i)) {
+            i = skip_long(i, open_len);
+        } else if (is_digit(c) || (c == '.' && i + 1 < n && is_digit(expression[i + 1]))) {
+            // Numeral, including exponents and hex digits
+            while (i < n && (is_ident_char(expression[i]) || expression[i] == '.' ||
+                             ((expression[i] == '+' || expression[i] == '-') &&
+                              std::strchr("eEpP", expression[i - 1])))) {
+                ++i;
+            }
+        } else if (c == '.' && i + 1 < n && expression[i + 1] == '.') {
+            // Concatenation
+            i += 2;
+        } else if (c == '.' || c == ':') {
+            // A field of an allowed value, or a string method such as _table:sub
+            const bool method = c == ':';
+            i = next_char(i + 1);
+            if (i < n && is_ident_start(expression[i])) {
+                const std::string field = read_ident(i);
+                if (method && !string_functions.count(field)) {
+                    return false;
+                }
+            }
+        } else if (is_ident_start(c)) {
+            const std::string name = read_ident(i);
+            size_t next = next_char(i);
+
+            if (name == "string" && next < n && expression[next] == '.') {
+                size_t field_pos = next_char(next + 1);
+                const std::string field = read_ident(field_pos);
+                if (!string_functions.count(field)) {
+                    return false;
+                }
+                i = field_pos;
+            } else if (next < n && expression[next] == '=' && (next + 1 >= n || expression[next + 1] != '=')) {
+                // Key of a table constructor field, e.g. {a = 1}
+                i = next + 1;
+            } else if (!allowed.count(name)) {
+                return false;
+            }
+        } else {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+void ExpressionEngine::evaluate_numbers(double* out, size_t count) {
+    if (!compiled_) {
+        throw std::runtime_error("evaluate_numbers requires a compiled expression");
+    }
+
+    int64_t call_index = state_->call_index;
+    compiled_->evaluate_numbers(out, count, call_index, state_->last_value);
+    state_->call_index = static_cast<int>(call_index);
+}
+
+// --------------------------
+// Batch mode
+// --------------------------
+bool ExpressionEngine::prepare_batch(const std::string& ctype) {
+    if (compiled_ || !state_ || !state_->template_) {
+        return false;
+    }
+
+    auto& context = get_thread_context();
+    const std::string& expression = state_->template_->expression;
+    const std::string key = "batch:" + ctype + ":" + expression;
+
+    auto it = context.template_cache.find(key);
+    if (it != context.template_cache.end()) {
+        state_->batch_ref = it->second;
+        return it->second != LUA_NOREF;
+    }
+
+    // _i, _last and _table become loop locals; _i is mirrored into the global
+    // table for registered C functions such as square()
+    std::ostringstream chunk;
+    chunk << "local ffi = require('ffi')\n"
+          << "local type = type\n"
+          << "local __G = _G\n"
+          << "return function(__out, __n, _i, _last, _table)\n"
+          << "  local __buf = ffi.cast('" << ctype << "*', __out)\n"
+          << "  for __k = 0, __n - 1 do\n"
+          << "    __G._i = _i\n"
+          << "    local __v = (" << expression << ")\n"
+          << "    __buf[__k] = __v\n"
+          << "    if type(__v) == 'number' then _last = __v end\n"
+          << "    _i = _i + 1\n"
+          << "  end\n"
+          << "  return _i, _last\n"
+          << "end\n";
+
+    lua_State* L = context.lua_vm;
+    int ref = LUA_NOREF;
+    if (luaL_loadstring(L, chunk.str().c_str()) == 0 && lua_pcall(L, 0, 1, 0) == 0 && lua_isfunction(L, -1)) {
+        ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    } else {
+        // No FFI (plain Lua) or formula not valid in statement context
+        lua_pop(L, 1);
+    }
+
+    context.template_cache[key] = ref;
+    state_->batch_ref = ref;
+    return ref != LUA_NOREF;
+}
+
+void ExpressionEngine::evaluate_batch(void* out, size_t count) {
+    if (!has_batch()) {
+        throw std::runtime_error("evaluate_batch requires prepare_batch");
+    }
+    if (count == 0) {
+        return;
+    }
+
+    auto& context = get_thread_context();
+    lua_State* L = context.lua_vm;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, state_->batch_ref);
+    lua_pushlightuserdata(L, out);
+    lua_pushinteger(L, static_cast<lua_Integer>(count));
+    lua_pushinteger(L, state_->call_index);
+    lua_pushnumber(L, state_->last_value);
+    lua_pushstring(L, state_->table_name.c_str());
+
+    if (lua_pcall(L, 5, 2, 0)) {
+        std::string err = lua_tostring(L, -1);
+        lua_pop(L, 1);
+        throw std::runtime_error("Runtime error: " + err);
+    }
+
+    state_->call_index = static_cast<int>(lua_tointeger(L, -2));
+    state_->last_value = lua_tonumber(L, -1);
+    lua_pop(L, 2);
+}
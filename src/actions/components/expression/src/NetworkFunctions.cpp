@@ -1,12 +1,12 @@
 #include "NetworkFunctions.hpp"
-#include "pcg_random.hpp"
+#include "RandomKernels.hpp"
 #include <random>
 #include <sstream>
 
 // Random IPv4 generator
 std::string NetworkFunctions::random_ipv4() {
-    // thread_local std::mt19937 gen(std::random_device{}());
-    thread_local pcg32_fast gen(pcg_extras::seed_seq_from<std::random_device>{});
+    // Drawn from RandomKernels so a seeded run reproduces it
+    auto& gen = RandomKernels::word_engine;
     std::uniform_int_distribution<int> dist(0, 255);
     
     std::ostringstream oss;
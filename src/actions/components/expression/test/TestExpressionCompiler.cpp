@@ -0,0 +1,182 @@
+#include "ExpressionCompiler.hpp"
+#include "RandomKernels.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static double eval_number(const std::string& expr, int64_t index = 0, double last = 0.0) {
+    auto compiled = CompiledExpression::compile(expr);
+    assert(compiled);
+    auto value = compiled->evaluate(index, last);
+    assert(!value.is_bool);
+    return value.number;
+}
+
+static bool eval_bool(const std::string& expr, int64_t index = 0, double last = 0.0) {
+    auto compiled = CompiledExpression::compile(expr);
+    assert(compiled);
+    auto value = compiled->evaluate(index, last);
+    assert(value.is_bool);
+    return value.number != 0.0;
+}
+
+void test_arithmetic_precedence() {
+    assert(eval_number("1 + 2 * 3") == 7.0);
+    assert(eval_number("(1 + 2) * 3") == 9.0);
+    assert(eval_number("2 ^ 3 ^ 2") == 512.0);
+    assert(eval_number("-2 ^ 2") == -4.0);
+    assert(eval_number("2 ^ -1") == 0.5);
+    assert(eval_number("10 - 4 - 3") == 3.0);
+    assert(eval_number("1.5e2 + 0x10") == 166.0);
+    std::cout << "test_arithmetic_precedence passed.\n";
+}
+
+void test_floored_modulo() {
+    assert(eval_number("7 % 3") == 1.0);
+    assert(eval_number("-7 % 3") == 2.0);
+    assert(eval_number("7 % -3") == -2.0);
+    assert(std::abs(eval_number("5.5 % 2") - 1.5) < 1e-12);
+    std::cout << "test_floored_modulo passed.\n";
+}
+
+void test_variables() {
+    assert(eval_number("_i * 2", 21) == 42.0);
+    assert(eval_number("_last + 1", 0, 9.0) == 10.0);
+
+    // Formula from conf/tdengine-gen.yaml
+    const double expected = std::fmod(5 * M_PI, 180.0);
+    assert(std::abs(eval_number("_i * math.pi % 180", 5) - expected) < 1e-9);
+    std::cout << "test_variables passed.\n";
+}
+
+void test_logic_operators() {
+    assert(eval_bool("1 > 2") == false);
+    assert(eval_bool("1 <= 1") == true);
+    assert(eval_bool("1 ~= 2") == true);
+    assert(eval_bool("not 1 == 2") == false);
+    assert(eval_bool("true and false") == false);
+    assert(eval_bool("not false") == true);
+
+    // and/or return operands, 0 is truthy as in Lua
+    assert(eval_number("0 or 5") == 0.0);
+    assert(eval_number("false or 5") == 5.0);
+    assert(eval_number("_last <= 410 and 430 or 400", 0, 100.0) == 430.0);
+    assert(eval_number("_last <= 410 and 430 or 400", 0, 500.0) == 400.0);
+    std::cout << "test_logic_operators passed.\n";
+}
+
+void test_math_functions() {
+    assert(std::abs(eval_number("math.sin(_i / 10)", 5) - std::sin(0.5)) < 1e-12);
+    assert(eval_number("math.floor(3.7) + math.ceil(1.2)") == 5.0);
+    assert(eval_number("math.max(1, 7, 3) - math.min(4, 2, 8)") == 5.0);
+    assert(eval_number("math.abs(-3) * math.sqrt(16)") == 12.0);
+    assert(eval_number("math.fmod(7, 4)") == 3.0);
+    assert(std::abs(eval_number("math.log(8, 2)") - 3.0) < 1e-12);
+    assert(eval_number("square(1, 10, 4, 0)", 2) == 1.0);
+    assert(eval_number("square(1, 10, 4, 0)", 0) == 10.0);
+    std::cout << "test_math_functions passed.\n";
+}
+
+void test_math_random() {
+    auto unit = CompiledExpression::compile("math.random()");
+    auto dice = CompiledExpression::compile("math.random(6)");
+    auto range = CompiledExpression::compile("math.random(10, 12)");
+    assert(unit && dice && range);
+
+    for (int i = 0; i < 1000; ++i) {
+        double u = unit->evaluate(i, 0).number;
+        double d = dice->evaluate(i, 0).number;
+        double r = range->evaluate(i, 0).number;
+        (void)u;
+        (void)d;
+        (void)r;
+        assert(u >= 0.0 && u < 1.0);
+        assert(d >= 1.0 && d <= 6.0 && d == std::floor(d));
+        assert(r >= 10.0 && r <= 12.0 && r == std::floor(r));
+    }
+    std::cout << "test_math_random passed.\n";
+}
+
+void test_math_random_seeded() {
+    auto formula = CompiledExpression::compile("math.random(1, 1000) + math.random()");
+    assert(formula);
+
+    auto run = [&formula](uint64_t key) {
+        RandomKernels::CounterScope scope(key);
+        std::vector<double> values;
+        for (uint64_t row = 0; row < 100; ++row) {
+            scope.seek(row, 0);
+            values.push_back(formula->evaluate(static_cast<int64_t>(row), 0).number);
+        }
+        return values;
+    };
+
+    // A seeded stream reproduces every draw, another seed does not
+    const uint64_t key = RandomKernels::stream_key(42, "d0");
+    assert(run(key) == run(key));
+    assert(run(key) != run(RandomKernels::stream_key(43, "d0")));
+    std::cout << "test_math_random_seeded passed.\n";
+}
+
+void test_unsupported_expressions() {
+    assert(!CompiledExpression::compile("_table"));
+    assert(!CompiledExpression::compile("'abc'"));
+    assert(!CompiledExpression::compile("1 .. 2"));
+    assert(!CompiledExpression::compile("1 -- comment"));
+    assert(!CompiledExpression::compile("rand_ipv4()"));
+    assert(!CompiledExpression::compile("math.unknown(1)"));
+    assert(!CompiledExpression::compile("({1, 2})[1]"));
+    assert(!CompiledExpression::compile("1 +"));
+    assert(!CompiledExpression::compile(""));
+    std::cout << "test_unsupported_expressions passed.\n";
+}
+
+void test_boolean_arithmetic_error() {
+    auto compiled = CompiledExpression::compile("true + 1");
+    assert(compiled);
+    try {
+        compiled->evaluate(0, 0);
+        assert(false && "Expected runtime error");
+    } catch (const std::runtime_error& e) {
+        assert(std::string(e.what()).find("arithmetic") != std::string::npos);
+    }
+    std::cout << "test_boolean_arithmetic_error passed.\n";
+}
+
+void test_evaluate_numbers() {
+    auto compiled = CompiledExpression::compile("_last + _i");
+    assert(compiled);
+
+    double out[5];
+    int64_t index = 0;
+    double last = 0.0;
+    compiled->evaluate_numbers(out, 5, index, last);
+
+    // Running sum 0, 1, 3, 6, 10
+    const double expected[] = {0, 1, 3, 6, 10};
+    for (int i = 0; i < 5; ++i) {
+        (void)expected;
+        assert(out[i] == expected[i]);
+    }
+    assert(index == 5);
+    assert(last == 10.0);
+    std::cout << "test_evaluate_numbers passed.\n";
+}
+
+int main() {
+    test_arithmetic_precedence();
+    test_floored_modulo();
+    test_variables();
+    test_logic_operators();
+    test_math_functions();
+    test_math_random();
+    test_math_random_seeded();
+    test_unsupported_expressions();
+    test_boolean_arithmetic_error();
+    test_evaluate_numbers();
+
+    std::cout << "All tests passed.\n";
+    return 0;
+}
@@ -1,10 +1,12 @@
 #include "ExpressionEngine.hpp"
 #include "RegistryFunctions.hpp"
+#include "RandomKernels.hpp"
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <string>
 #include <variant>
+#include <vector>
 
 void test_evaluate_bool_expression() {
     // Lua expression returns true
@@ -108,13 +110,122 @@ void test_evaluate_last_value_env() {
     std::cout << "test_evaluate_last_value_env passed.\n";
 }
 
+void test_native_compiled_path() {
+    // Arithmetic formulas bypass Lua
+    ExpressionEngine engine("_i * 2 + _last");
+    assert(engine.is_compiled());
+
+    auto result = engine.evaluate();
+    assert(std::holds_alternative<double>(result));
+    assert(std::get<double>(result) == 0.0);
+
+    double values[3];
+    engine.evaluate_numbers(values, 3);
+    // _i = 1, 2, 3 with running _last
+    assert(values[0] == 2.0);
+    assert(values[1] == 6.0);
+    assert(values[2] == 12.0);
+
+    ExpressionEngine lua_engine("rand_ipv4()");
+    assert(!lua_engine.is_compiled());
+
+    std::cout << "test_native_compiled_path passed.\n";
+}
+
+void test_batch_evaluation() {
+    // string.len keeps the formula on Lua; the batch loop fills a C buffer
+    ExpressionEngine engine("tbl_3", "_i + string.len(_table)");
+    assert(!engine.is_compiled());
+    assert(engine.prepare_batch("int32_t"));
+
+    int32_t values[4] = {0};
+    engine.evaluate_batch(values, 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(values[i] == i + 5);
+    }
+
+    // Row-wise evaluation continues the same _i sequence
+    auto next = engine.evaluate();
+    assert(std::holds_alternative<double>(next));
+    assert(std::get<double>(next) == 9.0);
+
+    // _last is carried through the batch
+    ExpressionEngine running("tbl", "_last + string.len(_table)");
+    assert(running.prepare_batch("double"));
+    double sums[3] = {0};
+    running.evaluate_batch(sums, 3);
+    assert(sums[0] == 3.0 && sums[1] == 6.0 && sums[2] == 9.0);
+
+    std::cout << "test_batch_evaluation passed.\n";
+}
+
+void test_lua_math_random_seeded() {
+    // Strings keep these formulas on Lua; the number one is compiled
+    ExpressionEngine lua_draw("tostring(math.random(1, 1000))");
+    ExpressionEngine lua_ip("rand_ipv4()");
+    ExpressionEngine native_draw("math.random(1, 1000)");
+    assert(!lua_draw.is_compiled() && native_draw.is_compiled());
+
+    auto run = [&](uint64_t key) {
+        RandomKernels::CounterScope scope(key);
+        std::vector<std::string> values;
+        for (uint32_t row = 0; row < 50; ++row) {
+            scope.seek(row, 0);
+            const std::string drawn = std::get<std::string>(lua_draw.evaluate());
+            scope.seek(row, 0);
+            const double native = std::get<double>(native_draw.evaluate());
+            assert(std::stod(drawn) == native);
+
+            scope.seek(row, 1);
+            values.push_back(drawn + " " + std::get<std::string>(lua_ip.evaluate()));
+        }
+        return values;
+    };
+
+    // Lua draws follow the seeded stream and match the compiled path
+    const uint64_t key = RandomKernels::stream_key(42, "d0");
+    assert(run(key) == run(key));
+    assert(run(key) != run(RandomKernels::stream_key(43, "d0")));
+    std::cout << "test_lua_math_random_seeded passed.\n";
+}
+
+void test_table_invariant_detection() {
+    assert(ExpressionEngine::is_table_invariant("({\"a\", \"b\"})[tonumber(string.match(_table, \"%d+\"))]"));
+    assert(ExpressionEngine::is_table_invariant("_table .. '_x'"));
+    assert(ExpressionEngine::is_table_invariant("3.7 + 2"));
+    assert(ExpressionEngine::is_table_invariant("'_i and _last' .. [[math.random]]"));
+    assert(ExpressionEngine::is_table_invariant("_table:upper() .. tostring(1e-3) .. string.rep('x', 0x2)"));
+    assert(ExpressionEngine::is_table_invariant("({a = 1, b = 2}).a + #_table"));
+
+    assert(!ExpressionEngine::is_table_invariant("_i * 2"));
+    assert(!ExpressionEngine::is_table_invariant("_last + 1"));
+    assert(!ExpressionEngine::is_table_invariant("math.random(1, 10)"));
+    assert(!ExpressionEngine::is_table_invariant("rand_ipv4()"));
+    assert(!ExpressionEngine::is_table_invariant("square(1, 10, 4, 0)"));
+    assert(!ExpressionEngine::is_table_invariant("os.time()"));
+
+    // Only known-pure names are detected; the rest needs per_table: true
+    assert(!ExpressionEngine::is_table_invariant("math.floor(2.5)"));
+    assert(!ExpressionEngine::is_table_invariant("_table..os.time()"));
+    assert(!ExpressionEngine::is_table_invariant("counter"));
+    assert(!ExpressionEngine::is_table_invariant("string.dump(print)"));
+    assert(!ExpressionEngine::is_table_invariant("_table:gmatch('.')()"));
+    assert(!ExpressionEngine::is_table_invariant("({x = _i}).x"));
+
+    std::cout << "test_table_invariant_detection passed.\n";
+}
+
 int main() {
+    test_table_invariant_detection();
     test_evaluate_bool_expression();
     test_evaluate_square_wave();
     test_evaluate_random_ipv4();
     test_evaluate_mixed_expression();
     test_evaluate_table_env();
     test_evaluate_last_value_env();
+    test_native_compiled_path();
+    test_batch_evaluation();
+    test_lua_math_random_seeded();
     std::cout << "All ExpressionEngine tests passed.\n";
     return 0;
 }
\ No newline at end of file
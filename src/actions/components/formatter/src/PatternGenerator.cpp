@@ -49,6 +49,9 @@ std::string PatternGenerator::get_value_as_string(const std::string& key, const
     auto it = col_index_map_.find(key);
     if (it != col_index_map_.end()) {
         try {
+            if (data.get_column_flag(row_index, it->second) != CELL_VALUE) {
+                return "null";
+            }
             return data.get_column_cell_as_string(row_index, it->second);
         } catch (const std::exception& e) {
             return "{ERROR:" + std::string(e.what()) + "}";
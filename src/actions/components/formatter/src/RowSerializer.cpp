@@ -56,8 +56,15 @@ nlohmann::ordered_json RowSerializer::to_json(
         }
     };
 
-    // Add data columns
+    // Add data columns; NULL cells become null, NONE cells are omitted
     for (size_t i = 0; i < col_instances.size(); ++i) {
+        const char flag = table.get_column_flag(row_index, i);
+        if (flag == CELL_NULL) {
+            json_data[col_instances[i].name()] = nullptr;
+            continue;
+        }
+        if (flag == CELL_NONE) continue;
+
         serialize_cell(col_instances, i, "column",
                        [&](size_t r, size_t c) -> ColumnType {
                            return table.get_column_cell(r, c);
@@ -128,8 +135,15 @@ void RowSerializer::to_json_inplace(
         }
     };
 
-    // Add data columns
+    // Add data columns; NULL cells become null, NONE cells are omitted
     for (size_t i = 0; i < col_instances.size(); ++i) {
+        const char flag = table.get_column_flag(row_index, i);
+        if (flag == CELL_NULL) {
+            out[col_instances[i].name()] = nullptr;
+            continue;
+        }
+        if (flag == CELL_NONE) continue;
+
         serialize_cell(col_instances, i, "column",
                     [&](size_t r, size_t c) -> ColumnType {
                         return table.get_column_cell(r, c);
@@ -218,9 +232,11 @@ void RowSerializer::to_influx_inplace(
     // Space separator
     out.push_back(' ');
 
-    // Fields
+    // Fields; line protocol has no null, so NULL and NONE cells are left out
     bool first_field = true;
     for (size_t col_idx = 0; col_idx < col_instances.size(); ++col_idx) {
+        if (table.get_column_flag(row_index, col_idx) != CELL_VALUE) continue;
+
         const auto& inst = col_instances[col_idx];
         if (!first_field) out.push_back(',');
         first_field = false;
@@ -68,6 +68,11 @@ StmtV2Data::StmtV2Data(const ColumnConfigInstanceVector& col_instances, MultiBat
                                                    : col_config.config().get_fixed_type_size();
 
             mem.is_nulls.assign(row_count, 0);
+            for (size_t row_idx = 0; row_idx < row_count; ++row_idx) {
+                if (!rows[row_idx].nulls.empty()) {
+                    mem.is_nulls[row_idx] = rows[row_idx].nulls[col_idx];
+                }
+            }
             
             if (!is_var_len) {
                 mem.buffer.resize(row_count * element_size);
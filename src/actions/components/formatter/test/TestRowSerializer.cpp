@@ -313,6 +313,48 @@ void test_influx_inplace_escaping() {
     std::cout << "test_influx_inplace_escaping passed." << std::endl;
 }
 
+void test_null_and_none_cells() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"temp", "FLOAT"});
+    col_instances.emplace_back(ColumnConfig{"humidity", "INT"});
+    col_instances.emplace_back(ColumnConfig{"location", "VARCHAR(20)"});
+
+    MultiBatch batch;
+    std::vector<RowData> rows;
+    RowData row{1609459200000, {25.5f, 0, std::string()}};
+    row.nulls = {CELL_VALUE, CELL_NULL, CELL_NONE};
+    rows.push_back(row);
+    batch.table_batches.emplace_back("weather", std::move(rows));
+    batch.update_metadata();
+
+    MemoryPool pool(1, 1, 1, col_instances, tag_instances);
+    auto* block = pool.convert_to_memory_block(std::move(batch));
+    const auto& tb = block->tables[0];
+
+    // NULL becomes null, NONE is left out
+    nlohmann::ordered_json result = RowSerializer::to_json(col_instances, tag_instances, tb, 0, "");
+    assert(result["temp"] == 25.5f);
+    assert(result.contains("humidity") && result["humidity"].is_null());
+    assert(!result.contains("location"));
+    (void)result;
+
+    nlohmann::ordered_json result_inplace;
+    RowSerializer::to_json_inplace(col_instances, tag_instances, tb, 0, "", result_inplace);
+    assert(result_inplace.contains("humidity") && result_inplace["humidity"].is_null());
+    assert(!result_inplace.contains("location"));
+    (void)result_inplace;
+
+    // Line protocol drops both
+    fmt::memory_buffer buf;
+    RowSerializer::to_influx_inplace(col_instances, tag_instances, tb, 0, buf);
+    auto ilp = fmt::to_string(buf);
+    assert(ilp == "weather temp=25.5 1609459200000");
+    (void)ilp;
+
+    std::cout << "test_null_and_none_cells passed." << std::endl;
+}
+
 int main() {
     test_basic_serialization();
     test_without_tbname_key();
@@ -321,6 +363,7 @@ int main() {
     test_serialization_with_tags();
     test_influx_inplace_multiple_types_and_bool();
     test_influx_inplace_escaping();
+    test_null_and_none_cells();
 
     std::cout << "All RowSerializer tests passed." << std::endl;
     return 0;
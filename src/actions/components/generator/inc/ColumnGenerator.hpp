@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <variant>
+#include <cstdint>
 #include "ColumnConfigInstance.hpp"
 
 
@@ -8,10 +9,29 @@ class ColumnGenerator {
 public:
     explicit ColumnGenerator(const ColumnConfigInstance& instance) : instance_(instance) {}
     virtual ~ColumnGenerator() = default;
-    
+
     virtual ColumnType generate() const = 0;
-    
+
     virtual ColumnTypeVector generate(size_t count) const = 0;
 
+    // Columnar fill: write count fixed-length values back to back into dest
+    virtual void fill(void* dest, size_t count) const;
+
+    // Columnar fill: write count var-length values back to back into dest,
+    // per-row byte lengths into lengths; returns total bytes written
+    virtual size_t fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const;
+
+    // Model state for generators shared by many tables: state_words() int64
+    // slots that save_state() / load_state() move between the generator and a
+    // table's own storage. Stateless generators have none.
+    virtual size_t state_words() const { return 0; }
+    virtual void save_state(int64_t* /*state*/) const {}
+    virtual void load_state(const int64_t* /*state*/) const {}
+
     ColumnConfigInstance instance_;
+
+protected:
+    // Encode a single generated value into column storage
+    static void write_fixed(const ColumnType& value, void* dest);
+    static size_t write_var(const ColumnType& value, char* dest, size_t max_length);
 };
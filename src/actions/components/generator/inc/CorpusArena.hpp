@@ -0,0 +1,40 @@
+#pragma once
+#include "ColumnConfig.hpp"
+#include "Samplers.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// Source text of a VARCHAR/BINARY random column, packed into one arena.
+// Alphabet mode ('corpus' without whitespace, default a-z) draws characters
+// from block random fills; word mode ('words', or a 'corpus' text) copies
+// whole words. Lengths follow min/max (max exclusive, default len) and
+// 'distribution'.
+class CorpusArena {
+public:
+    explicit CorpusArena(const ColumnConfig& config);
+
+    bool word_mode() const { return word_mode_; }
+    size_t word_count() const { return word_offsets_.size(); }
+
+    std::string generate() const;
+
+    // Write count strings back to back into dest; returns total bytes
+    size_t fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const;
+
+private:
+    void draw_lengths(uint32_t* out, size_t count, size_t max_length) const;
+    void write_chars(char* dest, size_t size) const;
+    size_t write_words(char* dest, size_t target) const;
+
+    std::vector<char> arena_;               // Alphabet, or words back to back
+    std::vector<uint32_t> word_offsets_;
+    std::vector<uint32_t> word_lengths_;
+    bool word_mode_ = false;
+
+    uint32_t min_len_ = 0;
+    uint32_t max_len_ = 0;                  // Inclusive
+    std::unique_ptr<Sampler> length_sampler_;
+};
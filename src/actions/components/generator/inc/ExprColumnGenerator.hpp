@@ -13,7 +13,19 @@ public:
     ColumnType generate() const override;
     ColumnTypeVector generate(size_t count) const override;
 
+    void fill(void* dest, size_t count) const override;
+    size_t fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const override;
+
+    // Whether the value was evaluated once for the table and is replayed
+    bool is_per_table() const { return per_table_; }
+
 private:
+    ColumnType convert(ColumnType value) const;
+
     // mutable int64_t counter_ = 0;
     mutable ExpressionEngine engine_;
+
+    bool per_table_ = false;
+    ColumnType cached_;
+    std::string cached_bytes_;      // cached_ encoded for var-length columns
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "ColumnConfig.hpp"
+#include <cstddef>
+#include <cstdint>
+
+
+// Draws CELL_NULL / CELL_NONE flags for one column at the configured
+// null_ratio / none_ratio, consuming one random 64-row bitmask at a time
+class NullGenerator {
+public:
+    NullGenerator() = default;
+    NullGenerator(double null_ratio, double none_ratio);
+    explicit NullGenerator(const ColumnConfig& config);
+
+    // Whether any cell can be NULL or NONE
+    bool enabled() const { return any_ratio_ > 0; }
+
+    // Flag for the next row
+    char next();
+
+    // Flags for count rows; returns how many of them carry a value
+    size_t fill(char* flags, size_t count);
+
+private:
+    void refill();
+
+    double any_ratio_ = 0;      // P(NULL or NONE)
+    double null_share_ = 0;     // P(NULL | NULL or NONE)
+    uint64_t any_mask_ = 0;
+    uint64_t null_mask_ = 0;
+    unsigned remaining_ = 0;
+};
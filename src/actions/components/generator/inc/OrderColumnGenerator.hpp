@@ -12,7 +12,18 @@ public:
     ColumnType generate() const override;
     ColumnTypeVector generate(size_t count) const override;
 
+    using ColumnGenerator::fill;
+    void fill(void* dest, size_t count) const override;
+
+    // Position in the sequence
+    size_t state_words() const override { return 1; }
+    void save_state(int64_t* state) const override { state[0] = current_; }
+    void load_state(const int64_t* state) const override { current_ = state[0]; }
+
 private:
+    template<typename T>
+    void fill_sequence(void* dest, size_t count) const;
+
     int64_t min_;
     int64_t max_;
     mutable int64_t current_;
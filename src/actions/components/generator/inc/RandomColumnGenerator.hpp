@@ -2,6 +2,10 @@
 #include "ColumnGenerator.hpp"
 #include <vector>
 #include <functional>
+#include <memory>
+
+class AliasTable;
+class ValueDictionary;
 
 class RandomColumnGenerator : public ColumnGenerator {
 public:
@@ -11,9 +15,25 @@ public:
     ColumnType generate() const override;
     ColumnTypeVector generate(size_t count) const override;
 
+    void fill(void* dest, size_t count) const override;
+    size_t fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const override;
+
 private:
     void initialize_generator();
+    void initialize_filler();
+    void initialize_sampler();
+
+    // Numeric ranges delegate to the typed generator; the members below
+    // serve values lists and strings
+    std::unique_ptr<ColumnGenerator> typed_;
 
     std::function<ColumnType()> generator_;
-    std::vector<ColumnType> cached_values_;
+
+    // 'values' columns: encoded entries and an optional weighted picker
+    std::shared_ptr<const ValueDictionary> dictionary_;
+    std::shared_ptr<const AliasTable> picker_;
+
+    // Columnar fillers, empty when the column falls back to generate()
+    std::function<void(void*, size_t)> fixed_filler_;
+    std::function<size_t(char*, int32_t*, size_t, size_t)> var_filler_;
 };
\ No newline at end of file
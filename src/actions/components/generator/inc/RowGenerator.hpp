@@ -20,6 +20,11 @@ public:
 
     std::vector<RowType> generate(size_t count) const;
 
+    // Per-column generators, used for columnar fills
+    const std::vector<std::unique_ptr<ColumnGenerator>>& column_generators() const {
+        return column_gens_;
+    }
+
 private:
     std::string table_name_;
     std::unique_ptr<TimestampGenerator> timestamp_gen_;
@@ -0,0 +1,56 @@
+#pragma once
+#include "ColumnConfig.hpp"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+
+// Non-uniform samplers behind the 'distribution' column option.
+// All draws come from the RandomKernels stream; normal and exponential use
+// ziggurat tables, zipf uses rejection-inversion, weighted picks use alias tables.
+class Sampler {
+public:
+    virtual ~Sampler() = default;
+
+    // Draw count values (before clamping to the column range)
+    virtual void sample(double* out, size_t count) const = 0;
+
+    // Sampler for a numeric column, nullptr when the distribution is uniform
+    static std::unique_ptr<Sampler> create(const ColumnConfig& config);
+};
+
+
+// Vose alias table: O(1) weighted index selection
+class AliasTable {
+public:
+    explicit AliasTable(const std::vector<double>& weights);
+
+    void sample(uint32_t* out, size_t count) const;
+    uint32_t sample() const;
+
+    size_t size() const { return alias_.size(); }
+
+    // Picker for a values list ('weights' or zipf ranks), nullptr when uniform
+    static std::unique_ptr<AliasTable> for_values(const ColumnConfig& config);
+
+private:
+    std::vector<uint64_t> threshold_;   // Keep probability scaled by 2^32
+    std::vector<uint32_t> alias_;
+};
+
+
+// Round (integers) and clamp samples into [lo, hi]
+template<typename T>
+void store_clamped(const double* in, T* out, size_t count, T lo, T hi) {
+    const double dlo = static_cast<double>(lo);
+    const double dhi = static_cast<double>(hi);
+    for (size_t i = 0; i < count; ++i) {
+        double x = in[i];
+        if constexpr (std::is_integral_v<T>) {
+            x = std::nearbyint(x);
+        }
+        out[i] = x <= dlo ? lo : (x >= dhi ? hi : static_cast<T>(x));
+    }
+}
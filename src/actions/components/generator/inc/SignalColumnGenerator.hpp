@@ -0,0 +1,82 @@
+#pragma once
+#include "TypedColumnGenerator.hpp"
+#include <memory>
+#include <string>
+
+
+// Time-series shapes behind the signal gen_types. Values are computed in
+// double a block at a time; the state (row position, walk level) belongs to
+// one generator and therefore to one table.
+//   random_walk  level + N(drift, stddev) per row, kept in [min, max]
+//   sine         mean + amplitude * sin(2 pi t / period + phase) + noise
+//   seasonal     daily-like cycle: fundamental plus a half-amplitude second harmonic
+//   sawtooth     ramp from min to max every period rows
+//   step         level held for about period rows, then a new level in [min, max]
+class SignalModel {
+public:
+    enum class Kind { RANDOM_WALK, SINE, SEASONAL, SAWTOOTH, STEP };
+
+    explicit SignalModel(const ColumnConfig& config);
+
+    static bool is_signal(const std::string& gen_type);
+
+    void fill(double* out, size_t count);
+
+    // Row position and level
+    static constexpr size_t STATE_WORDS = 2;
+    void save_state(int64_t* state) const;
+    void load_state(const int64_t* state);
+
+    double min() const { return min_; }
+    double max() const { return max_; }
+
+private:
+    void fill_random_walk(double* out, size_t count);
+    void fill_step(double* out, size_t count);
+    void fill_periodic(double* out, size_t count);
+
+    Kind kind_;
+    double min_;
+    double max_;
+    double mean_;
+    double amplitude_;
+    double period_;
+    double phase_;              // Fraction of a period
+    bool wrap_ = false;         // random_walk: re-enter from the opposite bound instead of reflecting
+
+    uint64_t row_ = 0;          // Position of the next value
+    double level_;              // random_walk / step state
+    std::unique_ptr<Sampler> steps_;    // random_walk increments
+    std::unique_ptr<Sampler> noise_;    // Gaussian noise, nullptr when noise is 0
+};
+
+
+// Signal values for one numeric type, clamped into [min, max]
+template<ColumnTypeTag Tag>
+class SignalColumnGenerator final : public TypedColumnGenerator<ColumnTypeOf_t<Tag>> {
+public:
+    using T = ColumnTypeOf_t<Tag>;
+
+    explicit SignalColumnGenerator(const ColumnConfigInstance& instance);
+
+    ColumnType generate() const override;
+    ColumnTypeVector generate(size_t count) const override {
+        return TypedColumnGenerator<T>::generate(count);
+    }
+
+    using TypedColumnGenerator<T>::fill;
+    void fill(T* out, size_t count) const override;
+
+    size_t state_words() const override { return SignalModel::STATE_WORDS; }
+    void save_state(int64_t* state) const override { model_.save_state(state); }
+    void load_state(const int64_t* state) const override { model_.load_state(state); }
+
+private:
+    mutable SignalModel model_;
+    T lo_;
+    T hi_;
+};
+
+
+// Generator for a signal gen_type; throws for non-numeric columns
+std::unique_ptr<ColumnGenerator> create_signal_generator(const ColumnConfigInstance& instance);
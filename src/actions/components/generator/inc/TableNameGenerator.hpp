@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include "TableNameConfig.hpp"
+#include "TableNameList.hpp"
 
 
 class TableNameGenerator {
@@ -12,6 +13,9 @@ public:
 
     std::vector<std::string> generate() const;
 
+    // Same names, formatted on demand
+    TableNameList names() const;
+
 private:
     TableNameConfig::Generator config_;
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// Child table names without one std::string per table. Prefix + index names
+// are formatted on demand into a caller buffer; any other names are interned
+// back to back in one shared arena with offsets. Slices share the arena, so
+// splitting the list between threads copies nothing.
+class TableNameList {
+public:
+    TableNameList() = default;
+
+    // prefix + from, prefix + (from + 1), ... count names
+    static TableNameList sequence(std::string prefix, int64_t from, size_t count);
+
+    // Names copied once into an arena
+    static TableNameList intern(const std::vector<std::string>& names);
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Name of table index; sequence names are written into buffer, so the view
+    // is valid until buffer changes
+    std::string_view at(size_t index, std::string& buffer) const;
+
+    // NUL-terminated name of table index: into the arena for interned names,
+    // else formatted into buffer
+    const char* c_str(size_t index, std::string& buffer) const;
+
+    // Owning copy, for tests and diagnostics
+    std::string operator[](size_t index) const;
+
+    // count names starting at begin
+    TableNameList slice(size_t begin, size_t count) const;
+
+    // Index of the first name in the original, unsliced list
+    size_t offset() const { return begin_; }
+
+private:
+    struct Arena {
+        std::vector<char> chars;            // Each name followed by a NUL
+        std::vector<uint64_t> offsets;      // size() + 1 entries
+    };
+
+    std::string prefix_;
+    int64_t from_ = 0;
+    std::shared_ptr<const Arena> arena_;    // Set for interned names
+    size_t begin_ = 0;
+    size_t size_ = 0;
+};
@@ -15,8 +15,15 @@ public:
 
     std::vector<Timestamp> generate(size_t count) const;
 
+    // Write the next count timestamps (step sequence plus jitter) into out
+    void fill(int64_t* out, size_t count) const;
+
     const std::string& timestamp_precision() const;
 
+    // Next timestamp before jitter; lets one generator serve several tables
+    int64_t position() const { return current_; }
+    void seek(int64_t position) const { current_ = position; }
+
     static std::unique_ptr<TimestampGenerator> create(const TimestampGeneratorConfig& config) {
         return std::make_unique<TimestampGenerator>(config);
     }
@@ -25,4 +32,5 @@ private:
     TimestampGeneratorConfig config_;
     mutable int64_t current_ = 0;
     Timestamp timestamp_step_;
+    Timestamp timestamp_jitter_ = 0;
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include "ColumnGenerator.hpp"
+#include "Samplers.hpp"
+#include <memory>
+#include <random>
+#include <type_traits>
+
+
+// C++ storage type of each fixed-width ColumnTypeTag
+template<ColumnTypeTag Tag> struct ColumnTypeOf;
+template<> struct ColumnTypeOf<ColumnTypeTag::BOOL>              { using type = bool; };
+template<> struct ColumnTypeOf<ColumnTypeTag::TINYINT>           { using type = int8_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::TINYINT_UNSIGNED>  { using type = uint8_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::SMALLINT>          { using type = int16_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::SMALLINT_UNSIGNED> { using type = uint16_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::INT>               { using type = int32_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::INT_UNSIGNED>      { using type = uint32_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::BIGINT>            { using type = int64_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::BIGINT_UNSIGNED>   { using type = uint64_t; };
+template<> struct ColumnTypeOf<ColumnTypeTag::FLOAT>             { using type = float; };
+template<> struct ColumnTypeOf<ColumnTypeTag::DOUBLE>            { using type = double; };
+
+template<ColumnTypeTag Tag>
+using ColumnTypeOf_t = typename ColumnTypeOf<Tag>::type;
+
+
+// Generator that knows its value type at compile time and fills raw T arrays
+// without going through ColumnType
+template<typename T>
+class TypedColumnGenerator : public ColumnGenerator {
+public:
+    using value_type = T;
+    using ColumnGenerator::ColumnGenerator;
+
+    virtual void fill(T* out, size_t count) const = 0;
+
+    using ColumnGenerator::fill;
+    void fill(void* dest, size_t count) const final {
+        fill(static_cast<T*>(dest), count);
+    }
+
+    ColumnTypeVector generate(size_t count) const override {
+        std::unique_ptr<T[]> buffer(new T[count]);
+        fill(buffer.get(), count);
+        return ColumnTypeVector(buffer.get(), buffer.get() + count);
+    }
+
+    using ColumnGenerator::generate;
+};
+
+
+// Random values for one fixed-width type, picked by the factory
+template<ColumnTypeTag Tag>
+class TypedRandomColumnGenerator final : public TypedColumnGenerator<ColumnTypeOf_t<Tag>> {
+public:
+    using T = ColumnTypeOf_t<Tag>;
+
+    explicit TypedRandomColumnGenerator(const ColumnConfigInstance& instance);
+
+    ColumnType generate() const override;
+    ColumnTypeVector generate(size_t count) const override {
+        return TypedColumnGenerator<T>::generate(count);
+    }
+
+    using TypedColumnGenerator<T>::fill;
+    void fill(T* out, size_t count) const override;
+
+private:
+    using Distribution = std::conditional_t<std::is_same_v<T, bool>, std::bernoulli_distribution,
+                         std::conditional_t<std::is_floating_point_v<T>, std::uniform_real_distribution<T>,
+                         std::conditional_t<std::is_signed_v<T>, std::uniform_int_distribution<int64_t>,
+                                                                 std::uniform_int_distribution<uint64_t>>>>;
+
+    T lo_{};
+    T hi_{};
+    mutable Distribution dist_;
+    std::unique_ptr<Sampler> sampler_;      // Non-uniform 'distribution', numeric types only
+};
+
+
+// TypedRandomColumnGenerator for the column's type, resolved once so fills run
+// without ColumnType or std::function; nullptr for non-numeric types
+std::unique_ptr<ColumnGenerator> create_typed_random_generator(const ColumnConfigInstance& instance);
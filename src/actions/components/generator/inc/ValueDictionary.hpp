@@ -0,0 +1,32 @@
+#pragma once
+#include "ColumnConfig.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+// A column's 'values' list, encoded once into column storage bytes.
+// Fixed entries sit element_size apart; var entries are packed with
+// offsets and lengths, so filling a column is one memcpy per row.
+class ValueDictionary {
+public:
+    explicit ValueDictionary(const ColumnConfig& config);
+
+    size_t size() const { return values_.size(); }
+    bool is_fixed() const { return is_fixed_; }
+
+    const ColumnType& value(uint32_t index) const { return values_[index]; }
+    std::string_view bytes(uint32_t index) const;
+
+    // Write the entries selected by indices into column storage
+    void fill(const uint32_t* indices, void* dest, size_t count) const;
+    size_t fill(const uint32_t* indices, char* dest, int32_t* lengths, size_t max_length, size_t count) const;
+
+private:
+    bool is_fixed_;
+    size_t element_size_;
+    std::vector<ColumnType> values_;
+    std::vector<char> data_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> lengths_;
+};
@@ -0,0 +1,65 @@
+#include "ColumnGenerator.hpp"
+#include "StringUtils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+
+void ColumnGenerator::write_fixed(const ColumnType& value, void* dest) {
+    std::visit([dest](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<T>) {
+            std::memcpy(dest, &v, sizeof(T));
+        } else if constexpr (std::is_same_v<T, Decimal>) {
+            new (dest) Decimal(v);
+        } else {
+            throw std::runtime_error("ColumnGenerator: value is not a fixed-length type");
+        }
+    }, value);
+}
+
+size_t ColumnGenerator::write_var(const ColumnType& value, char* dest, size_t max_length) {
+    return std::visit([dest, max_length](const auto& v) -> size_t {
+        using T = std::decay_t<decltype(v)>;
+        auto copy = [dest, max_length](const auto* data, size_t size) {
+            size_t len = std::min(size, max_length);
+            std::memcpy(dest, data, len);
+            return len;
+        };
+
+        if constexpr (std::is_same_v<T, std::string>) {
+            return copy(v.data(), v.size());
+        } else if constexpr (std::is_same_v<T, std::u16string>) {
+            return StringUtils::u16string_to_utf8(v, dest, max_length);
+        } else if constexpr (std::is_same_v<T, JsonValue>) {
+            return copy(v.raw_json.data(), v.raw_json.size());
+        } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+            return copy(v.data(), v.size());
+        } else {
+            throw std::runtime_error("ColumnGenerator: value is not a var-length type");
+        }
+    }, value);
+}
+
+void ColumnGenerator::fill(void* dest, size_t count) const {
+    const size_t element_size = instance_.config().get_fixed_type_size();
+    char* out = static_cast<char*>(dest);
+
+    for (size_t i = 0; i < count; ++i) {
+        write_fixed(generate(), out + i * element_size);
+    }
+}
+
+size_t ColumnGenerator::fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const {
+    size_t offset = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t len = write_var(generate(), dest + offset, max_length);
+        lengths[i] = static_cast<int32_t>(len);
+        offset += len;
+    }
+
+    return offset;
+}
@@ -4,7 +4,8 @@
 #include "RandomColumnGenerator.hpp"
 #include "OrderColumnGenerator.hpp"
 #include "ExprColumnGenerator.hpp"
-
+#include "TypedColumnGenerator.hpp"
+#include "SignalColumnGenerator.hpp"
 
 std::unique_ptr<ColumnGenerator> ColumnGeneratorFactory::create(const std::string& table_name, const ColumnConfigInstance& instance) {
     if (!instance.config().gen_type) return nullptr;
@@ -12,6 +13,11 @@ std::unique_ptr<ColumnGenerator> ColumnGeneratorFactory::create(const std::strin
     const std::string& gen_type = *instance.config().gen_type;
 
     if (gen_type == "random") {
+        if (instance.config().values_count <= 0) {
+            if (auto typed = create_typed_random_generator(instance)) {
+                return typed;
+            }
+        }
         return std::make_unique<RandomColumnGenerator>(instance);
     }
     else if (gen_type == "order") {
@@ -20,6 +26,9 @@ std::unique_ptr<ColumnGenerator> ColumnGeneratorFactory::create(const std::strin
     else if (gen_type == "expression") {
         return std::make_unique<ExprColumnGenerator>(table_name, instance);
     }
+    else if (SignalModel::is_signal(gen_type)) {
+        return create_signal_generator(instance);
+    }
 
     throw std::runtime_error("Unsupported generator type: " + gen_type);
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "CorpusArena.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t CHUNK = 256;
+    const std::string DEFAULT_ALPHABET = "abcdefghijklmnopqrstuvwxyz";
+
+    std::vector<std::string> split_words(const std::string& text) {
+        std::vector<std::string> words;
+        std::string word;
+        for (char c : text) {
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                if (!word.empty()) words.push_back(std::move(word));
+                word.clear();
+            } else {
+                word.push_back(c);
+            }
+        }
+        if (!word.empty()) words.push_back(std::move(word));
+        return words;
+    }
+
+    bool has_space(const std::string& text) {
+        return std::any_of(text.begin(), text.end(), [](char c) {
+            return std::isspace(static_cast<unsigned char>(c));
+        });
+    }
+
+    // Word indices drawn ahead, one block fill per CHUNK picks. In counter
+    // mode picks are drawn one at a time from the current cell's stream
+    struct WordPicks {
+        uint32_t buffer[CHUNK];
+        size_t pos = 0;
+        size_t size = 0;
+        size_t bound = 0;
+
+        uint32_t peek(size_t word_count) {
+            if (pos == size || bound != word_count) {
+                size = RandomKernels::counter_mode() ? 1 : CHUNK;
+                RandomKernels::fill_bounded(buffer, size, 0, static_cast<int64_t>(word_count - 1));
+                bound = word_count;
+                pos = 0;
+            }
+            return buffer[pos];
+        }
+
+        void advance() { ++pos; }
+
+        // Drop picks drawn for an earlier cell
+        void restart() { pos = size; }
+    };
+
+    thread_local WordPicks word_picks;
+}
+
+CorpusArena::CorpusArena(const ColumnConfig& config) {
+    std::vector<std::string> words = config.words;
+    if (words.empty() && config.corpus && has_space(*config.corpus)) {
+        words = split_words(*config.corpus);
+    }
+
+    if (!words.empty()) {
+        word_mode_ = true;
+        for (const auto& word : words) {
+            if (word.empty()) continue;
+            word_offsets_.push_back(static_cast<uint32_t>(arena_.size()));
+            word_lengths_.push_back(static_cast<uint32_t>(word.size()));
+            arena_.insert(arena_.end(), word.begin(), word.end());
+        }
+        if (word_offsets_.empty()) {
+            throw std::runtime_error("words must not all be empty for column: " + config.name);
+        }
+    } else {
+        const std::string& alphabet = config.corpus ? *config.corpus : DEFAULT_ALPHABET;
+        if (alphabet.empty()) {
+            throw std::runtime_error("corpus must not be empty for column: " + config.name);
+        }
+        arena_.assign(alphabet.begin(), alphabet.end());
+    }
+
+    // Length bounds: min/max when given (var columns default them to -1), else exactly len
+    const int len = config.len.value_or(0);
+    const double min = config.min.value_or(-1);
+    const double max = config.max.value_or(-1);
+    min_len_ = static_cast<uint32_t>(min >= 0 ? min : len);
+    max_len_ = max > 0 ? static_cast<uint32_t>(max - 1) : std::max<uint32_t>(min_len_, len);
+    if (max_len_ < min_len_) {
+        throw std::runtime_error("min must be less than max for column: " + config.name);
+    }
+
+    if (config.distribution && *config.distribution != "uniform") {
+        ColumnConfig length_config = config;
+        length_config.min = min_len_;
+        length_config.max = static_cast<double>(max_len_) + 1;
+        length_sampler_ = Sampler::create(length_config);
+    }
+}
+
+std::string CorpusArena::generate() const {
+    std::string result(max_len_, '\0');
+    int32_t length;
+    fill(result.data(), &length, max_len_, 1);
+    result.resize(length);
+    return result;
+}
+
+void CorpusArena::draw_lengths(uint32_t* out, size_t count, size_t max_length) const {
+    if (length_sampler_) {
+        double buffer[CHUNK];
+        length_sampler_->sample(buffer, count);
+        store_clamped(buffer, out, count, min_len_, max_len_);
+    } else if (min_len_ == max_len_) {
+        std::fill(out, out + count, min_len_);
+    } else {
+        RandomKernels::fill_bounded(out, count, min_len_, max_len_);
+    }
+
+    const uint32_t cap = static_cast<uint32_t>(std::min<size_t>(max_length, UINT32_MAX));
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::min(out[i], cap);
+    }
+}
+
+void CorpusArena::write_chars(char* dest, size_t size) const {
+    // Two characters per random word, 16 bits each through a multiply-shift
+    const uint32_t k = static_cast<uint32_t>(arena_.size());
+    const char* alphabet = arena_.data();
+    uint32_t words[CHUNK];
+
+    for (size_t done = 0; done < size; ) {
+        const size_t n = std::min(CHUNK, (size - done + 1) / 2);
+        RandomKernels::fill_u32(words, n);
+        for (size_t i = 0; i < n && done < size; ++i) {
+            dest[done++] = alphabet[((words[i] & 0xFFFF) * k) >> 16];
+            if (done < size) {
+                dest[done++] = alphabet[((words[i] >> 16) * k) >> 16];
+            }
+        }
+    }
+}
+
+size_t CorpusArena::write_words(char* dest, size_t target) const {
+    // Whole words joined by spaces while they fit; a first word that is too
+    // long is cut to the target length
+    const size_t word_count = word_offsets_.size();
+    size_t written = 0;
+    if (RandomKernels::counter_mode()) {
+        word_picks.restart();
+    }
+
+    while (written < target) {
+        const uint32_t index = word_picks.peek(word_count);
+        const size_t len = word_lengths_[index];
+        const size_t needed = written == 0 ? len : len + 1;
+
+        if (written + needed > target) {
+            if (written == 0) {
+                std::memcpy(dest, arena_.data() + word_offsets_[index], target);
+                written = target;
+                word_picks.advance();
+            }
+            break;
+        }
+
+        if (written > 0) dest[written++] = ' ';
+        std::memcpy(dest + written, arena_.data() + word_offsets_[index], len);
+        written += len;
+        word_picks.advance();
+    }
+    return written;
+}
+
+size_t CorpusArena::fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const {
+    uint32_t targets[CHUNK];
+    size_t offset = 0;
+
+    for (size_t done = 0; done < count; ) {
+        const size_t n = std::min(CHUNK, count - done);
+        draw_lengths(targets, n, max_length);
+
+        if (word_mode_) {
+            for (size_t i = 0; i < n; ++i) {
+                const size_t len = write_words(dest + offset, targets[i]);
+                lengths[done + i] = static_cast<int32_t>(len);
+                offset += len;
+            }
+        } else {
+            // One block fill covers the whole chunk
+            size_t total = 0;
+            for (size_t i = 0; i < n; ++i) {
+                lengths[done + i] = static_cast<int32_t>(targets[i]);
+                total += targets[i];
+            }
+            write_chars(dest + offset, total);
+            offset += total;
+        }
+        done += n;
+    }
+    return offset;
+}
@@ -3,6 +3,8 @@
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <algorithm>
+#include <cstring>
 
 using ConvertFunc = ColumnType(*)(const ColumnType&);
 namespace {
@@ -57,17 +59,87 @@ namespace {
         nullptr,                // vector<uint8_t>
         nullptr                 // Geometry
     };
+
+    template<typename T>
+    void store_numbers(void* dest, size_t offset, const double* src, size_t count) {
+        T* out = static_cast<T*>(dest) + offset;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<T>(src[i]);
+        }
+    }
+
+    // Upper bound of the bytes write_var produces for a value
+    size_t encoded_size_bound(const ColumnType& value) {
+        return std::visit([](const auto& v) -> size_t {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8_t>>) {
+                return v.size();
+            } else if constexpr (std::is_same_v<T, std::u16string>) {
+                return v.size() * 3;
+            } else if constexpr (std::is_same_v<T, JsonValue>) {
+                return v.raw_json.size();
+            } else {
+                return 0;
+            }
+        }, value);
+    }
 }
 
 ExprColumnGenerator::ExprColumnGenerator(const std::string& table_name, const ColumnConfigInstance& instance)
     : ColumnGenerator(instance),
-      engine_(table_name, *instance.config().formula) {}
+      engine_(table_name, *instance.config().formula) {
+
+    // Device metadata such as lookups keyed by _table is evaluated once here
+    const auto& config = instance.config();
+    per_table_ = config.per_table.value_or(ExpressionEngine::is_table_invariant(*config.formula));
+    if (per_table_) {
+        try {
+            cached_ = convert(engine_.evaluate());
+            if (config.is_var_length()) {
+                cached_bytes_.resize(encoded_size_bound(cached_));
+                cached_bytes_.resize(write_var(cached_, cached_bytes_.data(), cached_bytes_.size()));
+            }
+            return;
+        } catch (const std::runtime_error&) {
+            // Leave the error to be reported by generate() as before
+            per_table_ = false;
+        }
+    }
+
+    // Lua formulas on fixed-width columns run as one FFI loop per batch
+    if (!engine_.is_compiled()) {
+        static const char* ctypes[] = {
+            nullptr,        // UNKNOWN
+            "bool",         // BOOL
+            "int8_t",       // TINYINT
+            "uint8_t",      // TINYINT_UNSIGNED
+            "int16_t",      // SMALLINT
+            "uint16_t",     // SMALLINT_UNSIGNED
+            "int32_t",      // INT
+            "uint32_t",     // INT_UNSIGNED
+            "int64_t",      // BIGINT
+            "uint64_t",     // BIGINT_UNSIGNED
+            "float",        // FLOAT
+            "double",       // DOUBLE
+        };
+        const auto tag = static_cast<size_t>(instance.config().type_tag);
+        if (tag < std::size(ctypes) && ctypes[tag]) {
+            engine_.prepare_batch(ctypes[tag]);
+        }
+    }
+}
 
 ExprColumnGenerator::ExprColumnGenerator(const ColumnConfigInstance& instance)
     : ExprColumnGenerator("", instance) {}
 
 ColumnType ExprColumnGenerator::generate() const {
-    ColumnType value = engine_.evaluate();
+    if (per_table_) {
+        return cached_;
+    }
+    return convert(engine_.evaluate());
+}
+
+ColumnType ExprColumnGenerator::convert(ColumnType value) const {
     auto target_index = instance_.config().type_index;
     auto source_index = value.index();
 
@@ -105,4 +177,65 @@ ColumnTypeVector ExprColumnGenerator::generate(size_t count) const {
     }
 
     return values;
+}
+
+void ExprColumnGenerator::fill(void* dest, size_t count) const {
+    if (per_table_) {
+        const size_t element_size = instance_.config().get_fixed_type_size();
+        char* out = static_cast<char*>(dest);
+        for (size_t i = 0; i < count; ++i) {
+            write_fixed(cached_, out + i * element_size);
+        }
+        return;
+    }
+
+    using StoreFunc = void(*)(void*, size_t, const double*, size_t);
+    StoreFunc store = nullptr;
+
+    switch (instance_.config().type_tag) {
+        case ColumnTypeTag::TINYINT:           store = store_numbers<int8_t>; break;
+        case ColumnTypeTag::TINYINT_UNSIGNED:  store = store_numbers<uint8_t>; break;
+        case ColumnTypeTag::SMALLINT:          store = store_numbers<int16_t>; break;
+        case ColumnTypeTag::SMALLINT_UNSIGNED: store = store_numbers<uint16_t>; break;
+        case ColumnTypeTag::INT:               store = store_numbers<int32_t>; break;
+        case ColumnTypeTag::INT_UNSIGNED:      store = store_numbers<uint32_t>; break;
+        case ColumnTypeTag::BIGINT:            store = store_numbers<int64_t>; break;
+        case ColumnTypeTag::BIGINT_UNSIGNED:   store = store_numbers<uint64_t>; break;
+        case ColumnTypeTag::FLOAT:             store = store_numbers<float>; break;
+        case ColumnTypeTag::DOUBLE:            store = store_numbers<double>; break;
+        default: break;
+    }
+
+    if (engine_.has_batch()) {
+        engine_.evaluate_batch(dest, count);
+        return;
+    }
+
+    // Remaining Lua formulas and non-numeric targets go through generate()
+    if (!store || !engine_.is_compiled()) {
+        ColumnGenerator::fill(dest, count);
+        return;
+    }
+
+    constexpr size_t CHUNK = 256;
+    double buffer[CHUNK];
+    for (size_t done = 0; done < count; ) {
+        const size_t n = std::min(CHUNK, count - done);
+        engine_.evaluate_numbers(buffer, n);
+        store(dest, done, buffer, n);
+        done += n;
+    }
+}
+
+size_t ExprColumnGenerator::fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const {
+    if (!per_table_) {
+        return ColumnGenerator::fill(dest, lengths, max_length, count);
+    }
+
+    const size_t len = std::min(cached_bytes_.size(), max_length);
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(dest + i * len, cached_bytes_.data(), len);
+        lengths[i] = static_cast<int32_t>(len);
+    }
+    return len * count;
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "NullGenerator.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+
+NullGenerator::NullGenerator(double null_ratio, double none_ratio) {
+    if (null_ratio < 0 || none_ratio < 0 || null_ratio + none_ratio > 1) {
+        throw std::runtime_error("null_ratio and none_ratio must be in [0, 1] and sum to at most 1");
+    }
+    any_ratio_ = null_ratio + none_ratio;
+    null_share_ = any_ratio_ > 0 ? null_ratio / any_ratio_ : 0;
+}
+
+NullGenerator::NullGenerator(const ColumnConfig& config)
+    : NullGenerator(config.null_ratio.value_or(0.0f), config.none_ratio.value_or(0.0f)) {}
+
+void NullGenerator::refill() {
+    RandomKernels::fill_mask(&any_mask_, 1, any_ratio_);
+    RandomKernels::fill_mask(&null_mask_, 1, null_share_);
+    remaining_ = 64;
+}
+
+char NullGenerator::next() {
+    if (!enabled()) {
+        return CELL_VALUE;
+    }
+    // In counter mode each row draws its own masks so it does not depend on
+    // the rows generated before it
+    if (remaining_ == 0 || RandomKernels::counter_mode()) {
+        refill();
+    }
+
+    const bool missing = any_mask_ & 1;
+    const bool is_null = null_mask_ & 1;
+    any_mask_ >>= 1;
+    null_mask_ >>= 1;
+    --remaining_;
+
+    if (!missing) {
+        return CELL_VALUE;
+    }
+    return is_null ? CELL_NULL : CELL_NONE;
+}
+
+size_t NullGenerator::fill(char* flags, size_t count) {
+    if (!enabled()) {
+        std::fill(flags, flags + count, CELL_VALUE);
+        return count;
+    }
+
+    size_t values = 0;
+    for (size_t i = 0; i < count; ++i) {
+        flags[i] = next();
+        values += flags[i] == CELL_VALUE;
+    }
+    return values;
+}
@@ -71,4 +71,39 @@ ColumnTypeVector OrderColumnGenerator::generate(size_t count) const {
     }
 
     return values;
-}
\ No newline at end of file
+}
+
+template<typename T>
+void OrderColumnGenerator::fill_sequence(void* dest, size_t count) const {
+    T* out = static_cast<T*>(dest);
+    for (size_t i = 0; i < count; ++i) {
+        if (current_ >= max_) {
+            current_ = min_;
+        }
+        out[i] = static_cast<T>(current_++);
+    }
+}
+
+void OrderColumnGenerator::fill(void* dest, size_t count) const {
+    switch (instance_.config().type_tag) {
+        case ColumnTypeTag::BOOL:
+            for (size_t i = 0; i < count; ++i) {
+                if (current_ >= max_) {
+                    current_ = min_;
+                }
+                static_cast<bool*>(dest)[i] = (current_++ != 0);
+            }
+            break;
+        case ColumnTypeTag::TINYINT:           fill_sequence<int8_t>(dest, count); break;
+        case ColumnTypeTag::TINYINT_UNSIGNED:  fill_sequence<uint8_t>(dest, count); break;
+        case ColumnTypeTag::SMALLINT:          fill_sequence<int16_t>(dest, count); break;
+        case ColumnTypeTag::SMALLINT_UNSIGNED: fill_sequence<uint16_t>(dest, count); break;
+        case ColumnTypeTag::INT:               fill_sequence<int32_t>(dest, count); break;
+        case ColumnTypeTag::INT_UNSIGNED:      fill_sequence<uint32_t>(dest, count); break;
+        case ColumnTypeTag::BIGINT:            fill_sequence<int64_t>(dest, count); break;
+        case ColumnTypeTag::BIGINT_UNSIGNED:   fill_sequence<uint64_t>(dest, count); break;
+        default:
+            ColumnGenerator::fill(dest, count);
+            break;
+    }
+}
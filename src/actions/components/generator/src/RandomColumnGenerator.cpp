@@ -1,233 +1,192 @@
 #include "RandomColumnGenerator.hpp"
+#include "TypedColumnGenerator.hpp"
+#include "RandomKernels.hpp"
+#include "CorpusArena.hpp"
+#include "Samplers.hpp"
+#include "ValueDictionary.hpp"
 #include "StringUtils.hpp"
-#include "pcg_random.hpp"
 #include <random>
 #include <stdexcept>
 #include <algorithm>
 #include <charconv>
 
-// Thread-local random number engine
-// static thread_local std::mt19937_64 random_engine(std::random_device{}());
-// static thread_local std::minstd_rand random_engine(std::random_device{}());
-static thread_local pcg32_fast random_engine(pcg_extras::seed_seq_from<std::random_device>{});
+namespace {
+    // Dictionary indices or code points drawn per round
+    constexpr size_t INDEX_CHUNK = 256;
+
+    // Random NCHAR characters: CJK Unified Ideographs
+    constexpr int64_t CJK_FIRST = 0x4E00;
+    constexpr int64_t CJK_LAST = 0x9FA5;
+}
 
 RandomColumnGenerator::RandomColumnGenerator(const ColumnConfigInstance& instance)
     : ColumnGenerator(instance) {
+    // Numeric ranges are generated by the typed generator
+    if (instance_.config().values_count <= 0) {
+        typed_ = create_typed_random_generator(instance_);
+        if (typed_) {
+            return;
+        }
+    }
     initialize_generator();
+    initialize_filler();
+    initialize_sampler();
 }
 
 void RandomColumnGenerator::initialize_generator() {
-    // If values are configured, use values first
+    // If values are configured, pick entries of the pre-encoded dictionary
     if (instance_.config().values_count > 0) {
-        cached_values_.reserve(instance_.config().values_count);
-
-        if (!instance_.config().is_var_length()) {
-            for (const auto& dbl_value : instance_.config().dbl_values) {
-                switch (instance_.config().type_tag) {
-                    case ColumnTypeTag::BOOL:
-                        cached_values_.push_back(dbl_value != 0.0);
-                        break;
-                    case ColumnTypeTag::TINYINT:
-                        cached_values_.push_back(static_cast<int8_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::TINYINT_UNSIGNED:
-                        cached_values_.push_back(static_cast<uint8_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::SMALLINT:
-                        cached_values_.push_back(static_cast<int16_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::SMALLINT_UNSIGNED:
-                        cached_values_.push_back(static_cast<uint16_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::INT:
-                        cached_values_.push_back(static_cast<int32_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::INT_UNSIGNED:
-                        cached_values_.push_back(static_cast<uint32_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::BIGINT:
-                        cached_values_.push_back(static_cast<int64_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::BIGINT_UNSIGNED:
-                        cached_values_.push_back(static_cast<uint64_t>(dbl_value));
-                        break;
-                    case ColumnTypeTag::FLOAT:
-                        cached_values_.push_back(static_cast<float>(dbl_value));
-                        break;
-                    case ColumnTypeTag::DOUBLE:
-                        cached_values_.push_back(dbl_value);
-                        break;
-                    default:
-                        throw std::runtime_error("Values not supported for this type");
-                }
-            }
-        } else {
-            for (const auto& str_value : instance_.config().str_values) {
-                switch (instance_.config().type_tag) {
-                    case ColumnTypeTag::NCHAR:
-                        cached_values_.push_back(StringUtils::utf8_to_u16string(str_value));
-                        break;
-                    case ColumnTypeTag::VARCHAR:
-                    case ColumnTypeTag::BINARY:
-                        cached_values_.push_back(str_value);
-                        break;
-                    default:
-                        throw std::runtime_error("Values not supported for this type");
-                }
-            }
+        dictionary_ = std::make_shared<ValueDictionary>(instance_.config());
+
+        // Weighted or zipf picks go through an alias table
+        picker_ = AliasTable::for_values(instance_.config());
+        if (picker_) {
+            generator_ = [this]() {
+                return dictionary_->value(picker_->sample());
+            };
+            return;
         }
 
         // Create distribution object
-        auto dist = std::uniform_int_distribution<size_t>(0, cached_values_.size() - 1);
+        auto dist = std::uniform_int_distribution<uint32_t>(0, static_cast<uint32_t>(dictionary_->size() - 1));
 
         // Set generator to randomly select from values
         generator_ = [this, dist]() mutable {
-            return cached_values_[dist(random_engine)];
+            return dictionary_->value(dist(RandomKernels::word_engine));
         };
 
     } else {
-        // Use min/max range to generate
+        // Strings; numeric columns never get here
         switch (instance_.config().type_tag) {
-            case ColumnTypeTag::BOOL:
-                generator_ = []() {
-                    std::bernoulli_distribution dist(0.5);
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::TINYINT:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<int8_t> dist(
-                        static_cast<int8_t>(*instance_.config().min),
-                        static_cast<int8_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::TINYINT_UNSIGNED:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<uint8_t> dist(
-                        static_cast<uint8_t>(*instance_.config().min),
-                        static_cast<uint8_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::SMALLINT:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<int16_t> dist(
-                        static_cast<int16_t>(*instance_.config().min),
-                        static_cast<int16_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::SMALLINT_UNSIGNED:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<uint16_t> dist(
-                        static_cast<uint16_t>(*instance_.config().min),
-                        static_cast<uint16_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::INT:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<int32_t> dist(
-                        static_cast<int32_t>(*instance_.config().min),
-                        static_cast<int32_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::INT_UNSIGNED:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<uint32_t> dist(
-                        static_cast<uint32_t>(*instance_.config().min),
-                        static_cast<uint32_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::BIGINT:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<int64_t> dist(
-                        static_cast<int64_t>(*instance_.config().min),
-                        static_cast<int64_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::BIGINT_UNSIGNED:
-                generator_ = [this]() {
-                    std::uniform_int_distribution<uint64_t> dist(
-                        static_cast<uint64_t>(*instance_.config().min),
-                        static_cast<uint64_t>(*instance_.config().max - 1)
-                    );
-                    return dist(random_engine);
+            case ColumnTypeTag::NCHAR: {
+                const size_t len = static_cast<size_t>(*instance_.config().len);
+                generator_ = [len]() -> ColumnType {
+                    std::vector<uint16_t> code_points(len);
+                    RandomKernels::fill_bounded(code_points.data(), len, CJK_FIRST, CJK_LAST);
+                    return std::u16string(code_points.begin(), code_points.end());
                 };
                 break;
-            case ColumnTypeTag::FLOAT:
-                generator_ = [this]() {
-                    std::uniform_real_distribution<float> dist(
-                        static_cast<float>(*instance_.config().min),
-                        static_cast<float>(*instance_.config().max)
-                    );
-                    return dist(random_engine);
-                };
-                break;
-            case ColumnTypeTag::DOUBLE:
-                generator_ = [this]() {
-                    std::uniform_real_distribution<double> dist(
-                        *instance_.config().min,
-                        *instance_.config().max
-                    );
-                    return dist(random_engine);
+            }
+            case ColumnTypeTag::VARCHAR:
+            case ColumnTypeTag::BINARY: {
+                auto arena = std::make_shared<const CorpusArena>(instance_.config());
+                generator_ = [arena]() -> ColumnType {
+                    return arena->generate();
                 };
-                break;
-            case ColumnTypeTag::NCHAR:
-                generator_ = [this]() {
-                    int len = *instance_.config().len;
-                    std::uniform_int_distribution<uint16_t> dist(0x4E00, 0x9FA5);
-                    std::u16string result;
-                    result.reserve(len);
-                    for (int i = 0; i < len; ++i) {
-                        result.push_back(static_cast<char16_t>(dist(random_engine)));
-                    }
-                    return result;
+                var_filler_ = [arena](char* dest, int32_t* lengths, size_t max_length, size_t count) {
+                    return arena->fill(dest, lengths, max_length, count);
                 };
                 break;
-            case ColumnTypeTag::VARCHAR:
-            case ColumnTypeTag::BINARY:
-                if (instance_.config().corpus) {
-                    const auto& corpus = instance_.config().corpus.value();
-                    std::uniform_int_distribution<size_t> dist(0, corpus.size() - 1);
-                    generator_ = [corpus, dist]() mutable {
-                        return std::string(1, corpus[dist(random_engine)]);
-                    };
-                } else {
-                    static const std::string default_corpus = "abcdefghijklmnopqrstuvwxyz";
-                    std::uniform_int_distribution<size_t> dist(0, default_corpus.size() - 1);
-                    generator_ = [this, dist]() mutable {
-                        std::string result;
-                        result.reserve(*instance_.config().len);
-                        for (int i = 0; i < *instance_.config().len; ++i) {
-                            result.push_back(default_corpus[dist(random_engine)]);
-                        }
-                        return result;
-                    };
-                }
-                break;
+            }
             default:
                 throw std::runtime_error("Unsupported column type for random generation");
         }
     }
 }
 
+void RandomColumnGenerator::initialize_filler() {
+    // Values lists fill from the dictionary, everything else gets a columnar filler
+    if (dictionary_) {
+        auto dictionary = dictionary_;
+        auto picker = picker_;
+        auto pick = [dictionary, picker](uint32_t* indices, size_t count) {
+            if (picker) {
+                picker->sample(indices, count);
+            } else {
+                RandomKernels::fill_bounded(indices, count, 0, static_cast<int64_t>(dictionary->size() - 1));
+            }
+        };
+
+        if (dictionary->is_fixed()) {
+            const size_t element_size = instance_.config().get_fixed_type_size();
+            fixed_filler_ = [dictionary, pick, element_size](void* dest, size_t count) {
+                uint32_t indices[INDEX_CHUNK];
+                char* out = static_cast<char*>(dest);
+                for (size_t done = 0; done < count; ) {
+                    const size_t n = std::min(INDEX_CHUNK, count - done);
+                    pick(indices, n);
+                    dictionary->fill(indices, out + done * element_size, n);
+                    done += n;
+                }
+            };
+        } else {
+            var_filler_ = [dictionary, pick](char* dest, int32_t* lengths, size_t max_length, size_t count) {
+                uint32_t indices[INDEX_CHUNK];
+                size_t offset = 0;
+                for (size_t done = 0; done < count; ) {
+                    const size_t n = std::min(INDEX_CHUNK, count - done);
+                    pick(indices, n);
+                    offset += dictionary->fill(indices, dest + offset, lengths + done, max_length, n);
+                    done += n;
+                }
+                return offset;
+            };
+        }
+        return;
+    }
+
+    const auto& config = instance_.config();
+    switch (config.type_tag) {
+        case ColumnTypeTag::NCHAR: {
+            // Encode CJK code points straight to UTF-8 (3 bytes each), no u16string
+            const size_t len = static_cast<size_t>(config.len.value_or(0));
+            var_filler_ = [len](char* dest, int32_t* lengths, size_t max_length, size_t count) {
+                const size_t chars = std::min(len, max_length / 3);
+                const size_t total = chars * count;
+                uint16_t code_points[INDEX_CHUNK];
+                char* out = dest;
+
+                for (size_t done = 0; done < total; ) {
+                    const size_t n = std::min(INDEX_CHUNK, total - done);
+                    RandomKernels::fill_bounded(code_points, n, CJK_FIRST, CJK_LAST);
+                    for (size_t j = 0; j < n; ++j) {
+                        const uint16_t cp = code_points[j];
+                        *out++ = static_cast<char>(0xE0 | (cp >> 12));
+                        *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                        *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+                    }
+                    done += n;
+                }
+                std::fill(lengths, lengths + count, static_cast<int32_t>(chars * 3));
+                return total * 3;
+            };
+            break;
+        }
+        case ColumnTypeTag::VARCHAR:
+        case ColumnTypeTag::BINARY:
+            // Bound to the corpus arena by initialize_generator()
+            break;
+        default:
+            break;
+    }
+}
+
+void RandomColumnGenerator::initialize_sampler() {
+    const auto& config = instance_.config();
+    if (config.values_count > 0) {
+        return;
+    }
+    // String lengths are shaped inside the corpus arena
+    if (config.type_tag == ColumnTypeTag::VARCHAR || config.type_tag == ColumnTypeTag::BINARY) {
+        return;
+    }
+    if (Sampler::create(config)) {
+        throw std::runtime_error("distribution is only supported for numeric columns");
+    }
+}
+
 ColumnType RandomColumnGenerator::generate() const {
+    if (typed_) {
+        return typed_->generate();
+    }
     return generator_();
 }
 
 ColumnTypeVector RandomColumnGenerator::generate(size_t count) const {
+    if (typed_) {
+        return typed_->generate(count);
+    }
+
     ColumnTypeVector values;
     values.reserve(count);
 
@@ -236,4 +195,22 @@ ColumnTypeVector RandomColumnGenerator::generate(size_t count) const {
     }
 
     return values;
-}
\ No newline at end of file
+}
+void RandomColumnGenerator::fill(void* dest, size_t count) const {
+    if (typed_) {
+        typed_->fill(dest, count);
+        return;
+    }
+    if (fixed_filler_) {
+        fixed_filler_(dest, count);
+        return;
+    }
+    ColumnGenerator::fill(dest, count);
+}
+
+size_t RandomColumnGenerator::fill(char* dest, int32_t* lengths, size_t max_length, size_t count) const {
+    if (var_filler_) {
+        return var_filler_(dest, lengths, max_length, count);
+    }
+    return ColumnGenerator::fill(dest, lengths, max_length, count);
+}
@@ -0,0 +1,334 @@
+#include "Samplers.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Word view of the RandomKernels stream; samplers consume a variable
+    // number of words per value
+    struct WordStream {
+        uint32_t next() {
+            return RandomKernels::next_u32();
+        }
+
+        // Uniform in (0, 1), safe for log()
+        double uniform() {
+            return (static_cast<double>(next()) + 0.5) * 0x1.0p-32;
+        }
+    };
+
+    thread_local WordStream words;
+
+    // Marsaglia-Tsang ziggurat tables: 128 layers for the normal tail,
+    // 256 layers for the exponential
+    struct ZigguratTables {
+        uint32_t kn[128];
+        double wn[128];
+        double fn[128];
+        uint32_t ke[256];
+        double we[256];
+        double fe[256];
+
+        ZigguratTables() {
+            const double m1 = 2147483648.0;
+            const double m2 = 4294967296.0;
+
+            double dn = 3.442619855899, tn = dn;
+            const double vn = 9.91256303526217e-3;
+            double q = vn / std::exp(-0.5 * dn * dn);
+            kn[0] = static_cast<uint32_t>((dn / q) * m1);
+            kn[1] = 0;
+            wn[0] = q / m1;
+            wn[127] = dn / m1;
+            fn[0] = 1.0;
+            fn[127] = std::exp(-0.5 * dn * dn);
+            for (int i = 126; i >= 1; --i) {
+                dn = std::sqrt(-2.0 * std::log(vn / dn + std::exp(-0.5 * dn * dn)));
+                kn[i + 1] = static_cast<uint32_t>((dn / tn) * m1);
+                tn = dn;
+                fn[i] = std::exp(-0.5 * dn * dn);
+                wn[i] = dn / m1;
+            }
+
+            double de = 7.697117470131487, te = de;
+            const double ve = 3.949659822581572e-3;
+            q = ve / std::exp(-de);
+            ke[0] = static_cast<uint32_t>((de / q) * m2);
+            ke[1] = 0;
+            we[0] = q / m2;
+            we[255] = de / m2;
+            fe[0] = 1.0;
+            fe[255] = std::exp(-de);
+            for (int i = 254; i >= 1; --i) {
+                de = -std::log(ve / de + std::exp(-de));
+                ke[i + 1] = static_cast<uint32_t>((de / te) * m2);
+                te = de;
+                fe[i] = std::exp(-de);
+                we[i] = de / m2;
+            }
+        }
+    };
+
+    const ZigguratTables& tables() {
+        static const ZigguratTables instance;
+        return instance;
+    }
+
+    // Standard normal
+    double next_normal(const ZigguratTables& t) {
+        constexpr double R = 3.442619855899;
+        for (;;) {
+            const int32_t hz = static_cast<int32_t>(words.next());
+            const uint32_t iz = words.next() & 127;
+            const double x = hz * t.wn[iz];
+
+            // Fast path: inside the layer rectangle
+            const uint32_t magnitude = hz < 0 ? 0u - static_cast<uint32_t>(hz) : static_cast<uint32_t>(hz);
+            if (magnitude < t.kn[iz]) {
+                return x;
+            }
+            if (iz == 0) {
+                double tx, ty;
+                do {
+                    tx = -std::log(words.uniform()) / R;
+                    ty = -std::log(words.uniform());
+                } while (ty + ty < tx * tx);
+                return hz > 0 ? R + tx : -R - tx;
+            }
+            if (t.fn[iz] + words.uniform() * (t.fn[iz - 1] - t.fn[iz]) < std::exp(-0.5 * x * x)) {
+                return x;
+            }
+        }
+    }
+
+    // Standard exponential
+    double next_exponential(const ZigguratTables& t) {
+        for (;;) {
+            const uint32_t jz = words.next();
+            const uint32_t iz = jz & 255;
+            if (jz < t.ke[iz]) {
+                return jz * t.we[iz];
+            }
+            if (iz == 0) {
+                return 7.697117470131487 - std::log(words.uniform());
+            }
+            const double x = jz * t.we[iz];
+            if (t.fe[iz] + words.uniform() * (t.fe[iz - 1] - t.fe[iz]) < std::exp(-x)) {
+                return x;
+            }
+        }
+    }
+
+    class NormalSampler : public Sampler {
+    public:
+        NormalSampler(double mean, double stddev, bool log_normal)
+            : mean_(mean), stddev_(stddev), log_normal_(log_normal) {}
+
+        void sample(double* out, size_t count) const override {
+            const auto& t = tables();
+            for (size_t i = 0; i < count; ++i) {
+                const double x = mean_ + stddev_ * next_normal(t);
+                out[i] = log_normal_ ? std::exp(x) : x;
+            }
+        }
+
+    private:
+        double mean_;
+        double stddev_;
+        bool log_normal_;
+    };
+
+    class ExponentialSampler : public Sampler {
+    public:
+        ExponentialSampler(double offset, double lambda) : offset_(offset), scale_(1.0 / lambda) {}
+
+        void sample(double* out, size_t count) const override {
+            const auto& t = tables();
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = offset_ + scale_ * next_exponential(t);
+            }
+        }
+
+    private:
+        double offset_;
+        double scale_;
+    };
+
+    // Rejection-inversion (Hormann & Derflinger) over ranks 1..n; rank 1 maps to offset
+    class ZipfSampler : public Sampler {
+    public:
+        ZipfSampler(double offset, double n, double exponent)
+            : offset_(offset), n_(n), exponent_(exponent) {
+            h_integral_x1_ = h_integral(1.5) - 1.0;
+            h_integral_n_ = h_integral(n_ + 0.5);
+            s_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+        }
+
+        void sample(double* out, size_t count) const override {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = offset_ + (next_rank() - 1.0);
+            }
+        }
+
+    private:
+        double next_rank() const {
+            for (;;) {
+                const double u = h_integral_n_ + words.uniform() * (h_integral_x1_ - h_integral_n_);
+                const double x = h_integral_inverse(u);
+                const double k = std::clamp(std::floor(x + 0.5), 1.0, n_);
+                if (k - x <= s_ || u >= h_integral(k + 0.5) - h(k)) {
+                    return k;
+                }
+            }
+        }
+
+        static double helper1(double x) {
+            return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+        }
+
+        static double helper2(double x) {
+            return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+        }
+
+        double h(double x) const {
+            return std::exp(-exponent_ * std::log(x));
+        }
+
+        double h_integral(double x) const {
+            const double log_x = std::log(x);
+            return helper2((1.0 - exponent_) * log_x) * log_x;
+        }
+
+        double h_integral_inverse(double x) const {
+            double t = x * (1.0 - exponent_);
+            if (t < -1.0) t = -1.0;
+            return std::exp(helper1(t) * x);
+        }
+
+        double offset_;
+        double n_;
+        double exponent_;
+        double h_integral_x1_;
+        double h_integral_n_;
+        double s_;
+    };
+}
+
+std::unique_ptr<Sampler> Sampler::create(const ColumnConfig& config) {
+    const std::string distribution = config.distribution.value_or("uniform");
+    if (distribution == "uniform") {
+        return nullptr;
+    }
+
+    const double min = config.min.value_or(config.get_min_value());
+    const double max = config.max.value_or(config.get_max_value());
+
+    if (distribution == "normal" || distribution == "lognormal") {
+        const bool log_normal = distribution == "lognormal";
+        const double mean = config.mean.value_or(log_normal ? 0.0 : (min + max) / 2);
+        const double stddev = config.stddev.value_or(log_normal ? 1.0 : (max - min) / 6);
+        if (!(stddev > 0)) {
+            throw std::runtime_error("stddev must be positive for column: " + config.name);
+        }
+        return std::make_unique<NormalSampler>(mean, stddev, log_normal);
+    }
+    if (distribution == "exponential") {
+        const double lambda = config.lambda.value_or(1.0);
+        if (!(lambda > 0)) {
+            throw std::runtime_error("lambda must be positive for column: " + config.name);
+        }
+        return std::make_unique<ExponentialSampler>(min, lambda);
+    }
+    if (distribution == "zipf") {
+        const double skew = config.skew.value_or(1.0);
+        if (!(skew > 0)) {
+            throw std::runtime_error("skew must be positive for column: " + config.name);
+        }
+        return std::make_unique<ZipfSampler>(min, std::max(1.0, std::floor(max - min)), skew);
+    }
+
+    throw std::runtime_error("Unsupported distribution '" + distribution + "' for column: " + config.name);
+}
+
+AliasTable::AliasTable(const std::vector<double>& weights) {
+    const size_t n = weights.size();
+    if (n == 0 || n > UINT32_MAX) {
+        throw std::runtime_error("AliasTable: invalid number of weights");
+    }
+
+    double sum = 0;
+    for (double w : weights) {
+        if (!(w >= 0) || !std::isfinite(w)) {
+            throw std::runtime_error("AliasTable: weights must be finite and non-negative");
+        }
+        sum += w;
+    }
+    if (!(sum > 0)) {
+        throw std::runtime_error("AliasTable: weights must not all be zero");
+    }
+
+    constexpr double SCALE = 4294967296.0;
+    std::vector<double> prob(n);
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < n; ++i) {
+        prob[i] = weights[i] * static_cast<double>(n) / sum;
+        (prob[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    threshold_.assign(n, static_cast<uint64_t>(SCALE));
+    alias_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        alias_[i] = static_cast<uint32_t>(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const uint32_t s = small.back();
+        small.pop_back();
+        const uint32_t l = large.back();
+        large.pop_back();
+
+        threshold_[s] = static_cast<uint64_t>(prob[s] * SCALE);
+        alias_[s] = l;
+        prob[l] = (prob[l] + prob[s]) - 1.0;
+        (prob[l] < 1.0 ? small : large).push_back(l);
+    }
+    // Leftovers (rounding) keep their own column with probability 1
+}
+
+uint32_t AliasTable::sample() const {
+    const uint64_t n = alias_.size();
+    const uint32_t column = static_cast<uint32_t>((static_cast<uint64_t>(words.next()) * n) >> 32);
+    return words.next() < threshold_[column] ? column : alias_[column];
+}
+
+void AliasTable::sample(uint32_t* out, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = sample();
+    }
+}
+
+std::unique_ptr<AliasTable> AliasTable::for_values(const ColumnConfig& config) {
+    if (!config.weights.empty()) {
+        if (config.weights.size() != static_cast<size_t>(config.values_count)) {
+            throw std::runtime_error("weights must match values in size for column: " + config.name);
+        }
+        return std::make_unique<AliasTable>(config.weights);
+    }
+
+    const std::string distribution = config.distribution.value_or("uniform");
+    if (distribution == "uniform") {
+        return nullptr;
+    }
+    if (distribution == "zipf") {
+        // The first value is the most frequent
+        const double skew = config.skew.value_or(1.0);
+        std::vector<double> weights(static_cast<size_t>(config.values_count));
+        for (size_t k = 0; k < weights.size(); ++k) {
+            weights[k] = std::pow(static_cast<double>(k + 1), -skew);
+        }
+        return std::make_unique<AliasTable>(weights);
+    }
+
+    throw std::runtime_error("Distribution '" + distribution + "' cannot be used with values for column: " + config.name);
+}
@@ -0,0 +1,242 @@
+#include "SignalColumnGenerator.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t CHUNK = 256;
+    constexpr double TWO_PI = 6.283185307179586;
+
+    // Gaussian sampler with the given moments, reusing the normal distribution
+    std::unique_ptr<Sampler> make_normal(const ColumnConfig& config, double mean, double stddev) {
+        ColumnConfig normal = config;
+        normal.distribution = "normal";
+        normal.mean = mean;
+        normal.stddev = stddev;
+        return Sampler::create(normal);
+    }
+}
+
+SignalModel::SignalModel(const ColumnConfig& config) {
+    const std::string& gen_type = config.gen_type.value_or("");
+    if (gen_type == "random_walk") kind_ = Kind::RANDOM_WALK;
+    else if (gen_type == "sine") kind_ = Kind::SINE;
+    else if (gen_type == "seasonal") kind_ = Kind::SEASONAL;
+    else if (gen_type == "sawtooth") kind_ = Kind::SAWTOOTH;
+    else if (gen_type == "step") kind_ = Kind::STEP;
+    else throw std::runtime_error("Unsupported signal gen_type '" + gen_type + "' for column: " + config.name);
+
+    if (!config.min || !config.max) {
+        throw std::runtime_error("min and max are required for gen_type " + gen_type + " in column: " + config.name);
+    }
+    min_ = *config.min;
+    max_ = *config.max;
+    if (!(min_ < max_)) {
+        throw std::runtime_error("min must be less than max for column: " + config.name);
+    }
+
+    mean_ = config.mean.value_or((min_ + max_) / 2);
+    amplitude_ = config.amplitude.value_or((max_ - min_) / 2);
+    period_ = config.period.value_or(100.0);
+    phase_ = config.phase.value_or(0.0);
+    if (!(period_ > 0)) {
+        throw std::runtime_error("period must be positive for column: " + config.name);
+    }
+
+    const std::string boundary = config.boundary.value_or("reflect");
+    if (boundary != "reflect" && boundary != "wrap") {
+        throw std::runtime_error("boundary must be reflect or wrap for column: " + config.name);
+    }
+    wrap_ = boundary == "wrap";
+
+    const double noise = config.noise.value_or(0.0);
+    if (noise < 0) {
+        throw std::runtime_error("noise must not be negative for column: " + config.name);
+    }
+    if (noise > 0 && kind_ != Kind::RANDOM_WALK) {
+        noise_ = make_normal(config, 0.0, noise);
+    }
+
+    level_ = std::clamp(mean_, min_, max_);
+    if (kind_ == Kind::RANDOM_WALK) {
+        steps_ = make_normal(config, config.drift.value_or(0.0), config.stddev.value_or((max_ - min_) / 100));
+    }
+}
+
+bool SignalModel::is_signal(const std::string& gen_type) {
+    return gen_type == "random_walk" || gen_type == "sine" || gen_type == "seasonal"
+        || gen_type == "sawtooth" || gen_type == "step";
+}
+
+void SignalModel::fill(double* out, size_t count) {
+    switch (kind_) {
+        case Kind::RANDOM_WALK: fill_random_walk(out, count); break;
+        case Kind::STEP:        fill_step(out, count); break;
+        default:                fill_periodic(out, count); break;
+    }
+
+    if (noise_) {
+        double buffer[CHUNK];
+        for (size_t done = 0; done < count; done += CHUNK) {
+            const size_t n = std::min(CHUNK, count - done);
+            noise_->sample(buffer, n);
+            for (size_t i = 0; i < n; ++i) {
+                out[done + i] += buffer[i];
+            }
+        }
+    }
+    row_ += count;
+}
+
+void SignalModel::save_state(int64_t* state) const {
+    state[0] = static_cast<int64_t>(row_);
+    std::memcpy(&state[1], &level_, sizeof(double));
+}
+
+void SignalModel::load_state(const int64_t* state) {
+    row_ = static_cast<uint64_t>(state[0]);
+    std::memcpy(&level_, &state[1], sizeof(double));
+}
+
+void SignalModel::fill_random_walk(double* out, size_t count) {
+    const double range = max_ - min_;
+    double level = level_;
+
+    for (size_t done = 0; done < count; done += CHUNK) {
+        const size_t n = std::min(CHUNK, count - done);
+        steps_->sample(out + done, n);
+
+        for (size_t i = done; i < done + n; ++i) {
+            level += out[i];
+            if (level < min_ || level > max_) {
+                if (wrap_) {
+                    level = min_ + (level - min_) - range * std::floor((level - min_) / range);
+                } else {
+                    // Reflect; steps longer than the range fold back and forth
+                    double x = std::fmod(level - min_, 2 * range);
+                    if (x < 0) x += 2 * range;
+                    level = min_ + (x <= range ? x : 2 * range - x);
+                }
+            }
+            out[i] = level;
+        }
+    }
+    level_ = level;
+}
+
+void SignalModel::fill_step(double* out, size_t count) {
+    // A new level starts with probability 1 / period on each row
+    const double p = std::min(1.0, 1.0 / period_);
+    double coins[CHUNK];
+    double levels[CHUNK];
+    double level = level_;
+
+    for (size_t done = 0; done < count; done += CHUNK) {
+        const size_t n = std::min(CHUNK, count - done);
+        RandomKernels::fill_uniform(coins, n, 0.0, 1.0);
+        RandomKernels::fill_uniform(levels, n, min_, max_);
+
+        for (size_t i = 0; i < n; ++i) {
+            if (coins[i] < p) {
+                level = levels[i];
+            }
+            out[done + i] = level;
+        }
+    }
+    level_ = level;
+}
+
+void SignalModel::fill_periodic(double* out, size_t count) {
+    // Position inside the period from the integer row, so long runs do not drift
+    const uint64_t period_rows = static_cast<uint64_t>(period_);
+    const double fractional = period_ - static_cast<double>(period_rows);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t t = row_ + i;
+        double cycle;
+        if (fractional == 0) {
+            cycle = static_cast<double>(t % period_rows) / period_;
+        } else {
+            cycle = std::fmod(static_cast<double>(t), period_) / period_;
+        }
+        cycle += phase_;
+        cycle -= std::floor(cycle);
+
+        switch (kind_) {
+            case Kind::SINE:
+                out[i] = mean_ + amplitude_ * std::sin(TWO_PI * cycle);
+                break;
+            case Kind::SEASONAL: {
+                // Normalized so the peak reaches mean + amplitude
+                const double theta = TWO_PI * cycle;
+                out[i] = mean_ + amplitude_ * (std::sin(theta) + 0.5 * std::sin(2 * theta)) / 1.299038105676658;
+                break;
+            }
+            default:
+                out[i] = min_ + (max_ - min_) * cycle;
+                break;
+        }
+    }
+}
+
+
+template<ColumnTypeTag Tag>
+SignalColumnGenerator<Tag>::SignalColumnGenerator(const ColumnConfigInstance& instance)
+    : TypedColumnGenerator<T>(instance), model_(instance.config()) {
+    if constexpr (std::is_integral_v<T>) {
+        lo_ = static_cast<T>(std::ceil(model_.min()));
+        hi_ = static_cast<T>(std::floor(model_.max()));
+    } else {
+        lo_ = static_cast<T>(model_.min());
+        hi_ = static_cast<T>(model_.max());
+    }
+}
+
+template<ColumnTypeTag Tag>
+ColumnType SignalColumnGenerator<Tag>::generate() const {
+    T value;
+    fill(&value, 1);
+    return value;
+}
+
+template<ColumnTypeTag Tag>
+void SignalColumnGenerator<Tag>::fill(T* out, size_t count) const {
+    double buffer[CHUNK];
+    for (size_t done = 0; done < count; done += CHUNK) {
+        const size_t n = std::min(CHUNK, count - done);
+        model_.fill(buffer, n);
+        store_clamped(buffer, out + done, n, lo_, hi_);
+    }
+}
+
+template class SignalColumnGenerator<ColumnTypeTag::TINYINT>;
+template class SignalColumnGenerator<ColumnTypeTag::TINYINT_UNSIGNED>;
+template class SignalColumnGenerator<ColumnTypeTag::SMALLINT>;
+template class SignalColumnGenerator<ColumnTypeTag::SMALLINT_UNSIGNED>;
+template class SignalColumnGenerator<ColumnTypeTag::INT>;
+template class SignalColumnGenerator<ColumnTypeTag::INT_UNSIGNED>;
+template class SignalColumnGenerator<ColumnTypeTag::BIGINT>;
+template class SignalColumnGenerator<ColumnTypeTag::BIGINT_UNSIGNED>;
+template class SignalColumnGenerator<ColumnTypeTag::FLOAT>;
+template class SignalColumnGenerator<ColumnTypeTag::DOUBLE>;
+
+
+std::unique_ptr<ColumnGenerator> create_signal_generator(const ColumnConfigInstance& instance) {
+    switch (instance.config().type_tag) {
+        case ColumnTypeTag::TINYINT:           return std::make_unique<SignalColumnGenerator<ColumnTypeTag::TINYINT>>(instance);
+        case ColumnTypeTag::TINYINT_UNSIGNED:  return std::make_unique<SignalColumnGenerator<ColumnTypeTag::TINYINT_UNSIGNED>>(instance);
+        case ColumnTypeTag::SMALLINT:          return std::make_unique<SignalColumnGenerator<ColumnTypeTag::SMALLINT>>(instance);
+        case ColumnTypeTag::SMALLINT_UNSIGNED: return std::make_unique<SignalColumnGenerator<ColumnTypeTag::SMALLINT_UNSIGNED>>(instance);
+        case ColumnTypeTag::INT:               return std::make_unique<SignalColumnGenerator<ColumnTypeTag::INT>>(instance);
+        case ColumnTypeTag::INT_UNSIGNED:      return std::make_unique<SignalColumnGenerator<ColumnTypeTag::INT_UNSIGNED>>(instance);
+        case ColumnTypeTag::BIGINT:            return std::make_unique<SignalColumnGenerator<ColumnTypeTag::BIGINT>>(instance);
+        case ColumnTypeTag::BIGINT_UNSIGNED:   return std::make_unique<SignalColumnGenerator<ColumnTypeTag::BIGINT_UNSIGNED>>(instance);
+        case ColumnTypeTag::FLOAT:             return std::make_unique<SignalColumnGenerator<ColumnTypeTag::FLOAT>>(instance);
+        case ColumnTypeTag::DOUBLE:            return std::make_unique<SignalColumnGenerator<ColumnTypeTag::DOUBLE>>(instance);
+        default:
+            throw std::runtime_error("gen_type " + instance.config().gen_type.value_or("") +
+                                     " requires a numeric column: " + instance.name());
+    }
+}
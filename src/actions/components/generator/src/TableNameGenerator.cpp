@@ -1,16 +1,21 @@
 #include "TableNameGenerator.hpp"
-#include <sstream>
 
 
 std::vector<std::string> TableNameGenerator::generate() const {
+    const TableNameList list = names();
+
     std::vector<std::string> names;
-    names.reserve(config_.count);
-    
-    for (int i = config_.from; i < config_.from + config_.count; ++i) {
-        std::ostringstream oss;
-        oss << config_.prefix << i;
-        names.push_back(oss.str());
+    names.reserve(list.size());
+
+    std::string buffer;
+    for (size_t i = 0; i < list.size(); ++i) {
+        names.emplace_back(list.at(i, buffer));
     }
 
     return names;
-}
\ No newline at end of file
+}
+
+TableNameList TableNameGenerator::names() const {
+    return TableNameList::sequence(config_.prefix, config_.from,
+                                   config_.count > 0 ? static_cast<size_t>(config_.count) : 0);
+}
@@ -0,0 +1,75 @@
+#include "TableNameList.hpp"
+#include <charconv>
+#include <stdexcept>
+
+
+TableNameList TableNameList::sequence(std::string prefix, int64_t from, size_t count) {
+    TableNameList list;
+    list.prefix_ = std::move(prefix);
+    list.from_ = from;
+    list.size_ = count;
+    return list;
+}
+
+TableNameList TableNameList::intern(const std::vector<std::string>& names) {
+    auto arena = std::make_shared<Arena>();
+
+    size_t total = 0;
+    for (const auto& name : names) {
+        total += name.size();
+    }
+    arena->chars.reserve(total + names.size());
+    arena->offsets.reserve(names.size() + 1);
+
+    arena->offsets.push_back(0);
+    for (const auto& name : names) {
+        arena->chars.insert(arena->chars.end(), name.begin(), name.end());
+        arena->chars.push_back('\0');
+        arena->offsets.push_back(arena->chars.size());
+    }
+
+    TableNameList list;
+    list.arena_ = std::move(arena);
+    list.size_ = names.size();
+    return list;
+}
+
+std::string_view TableNameList::at(size_t index, std::string& buffer) const {
+    if (index >= size_) {
+        throw std::out_of_range("Table name index " + std::to_string(index) + " out of range");
+    }
+
+    const size_t i = begin_ + index;
+    if (arena_) {
+        const uint64_t start = arena_->offsets[i];
+        return std::string_view(arena_->chars.data() + start, arena_->offsets[i + 1] - start - 1);
+    }
+
+    // Prefix, then the index in decimal
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), from_ + static_cast<int64_t>(i));
+    buffer.assign(prefix_);
+    buffer.append(digits, result.ptr);
+    return buffer;
+}
+
+const char* TableNameList::c_str(size_t index, std::string& buffer) const {
+    const std::string_view name = at(index, buffer);
+    return arena_ ? name.data() : buffer.c_str();
+}
+
+std::string TableNameList::operator[](size_t index) const {
+    std::string buffer;
+    return std::string(at(index, buffer));
+}
+
+TableNameList TableNameList::slice(size_t begin, size_t count) const {
+    if (begin > size_ || count > size_ - begin) {
+        throw std::out_of_range("Table name slice out of range");
+    }
+
+    TableNameList list(*this);
+    list.begin_ = begin_ + begin;
+    list.size_ = count;
+    return list;
+}
@@ -4,6 +4,8 @@
 #include <variant>
 #include <unordered_map>
 #include "TimestampUtils.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
 
 
 TimestampGenerator::TimestampGenerator(const TimestampGeneratorConfig& config)
@@ -23,23 +25,47 @@ void TimestampGenerator::reset() {
         config_.timestamp_step,
         config_.timestamp_precision
     );
+    timestamp_jitter_ = TimestampUtils::parse_step(
+        config_.timestamp_jitter,
+        config_.timestamp_precision
+    );
+    if (timestamp_jitter_ < 0) {
+        throw std::runtime_error("timestamp jitter must not be negative");
+    }
 }
 
 Timestamp TimestampGenerator::generate() const {
-    Timestamp ts{current_};
-    current_ += timestamp_step_;
+    Timestamp ts;
+    fill(&ts, 1);
     return ts;
 }
 
 std::vector<Timestamp> TimestampGenerator::generate(size_t count) const {
-    std::vector<Timestamp> timestamps;
-    timestamps.reserve(count);
+    std::vector<Timestamp> timestamps(count);
+    fill(timestamps.data(), count);
+    return timestamps;
+}
 
+void TimestampGenerator::fill(int64_t* out, size_t count) const {
+    const int64_t base = current_;
+    const int64_t step = timestamp_step_;
     for (size_t i = 0; i < count; ++i) {
-        timestamps.push_back(generate());
+        out[i] = base + static_cast<int64_t>(i) * step;
     }
+    current_ = base + static_cast<int64_t>(count) * step;
 
-    return timestamps;
+    if (timestamp_jitter_ > 1) {
+        constexpr size_t CHUNK = 256;
+        int64_t offsets[CHUNK];
+        for (size_t done = 0; done < count; ) {
+            const size_t n = std::min(CHUNK, count - done);
+            RandomKernels::fill_bounded(offsets, n, 0, timestamp_jitter_ - 1);
+            for (size_t i = 0; i < n; ++i) {
+                out[done + i] += offsets[i];
+            }
+            done += n;
+        }
+    }
 }
 
 const std::string& TimestampGenerator::timestamp_precision() const {
@@ -0,0 +1,93 @@
+#include "TypedColumnGenerator.hpp"
+#include "RandomKernels.hpp"
+#include <algorithm>
+
+
+template<ColumnTypeTag Tag>
+TypedRandomColumnGenerator<Tag>::TypedRandomColumnGenerator(const ColumnConfigInstance& instance)
+    : TypedColumnGenerator<T>(instance) {
+    const auto& config = instance.config();
+    const double min = config.min.value_or(config.get_min_value());
+    const double max = config.max.value_or(config.get_max_value());
+
+    // Integer ranges exclude max
+    if constexpr (std::is_same_v<T, bool>) {
+        dist_ = Distribution(0.5);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        lo_ = static_cast<T>(min);
+        hi_ = static_cast<T>(max);
+        dist_ = Distribution(lo_, hi_);
+    } else {
+        lo_ = static_cast<T>(min);
+        hi_ = static_cast<T>(max - 1);
+        dist_ = Distribution(lo_, hi_);
+    }
+
+    if constexpr (!std::is_same_v<T, bool>) {
+        sampler_ = Sampler::create(config);
+    }
+}
+
+template<ColumnTypeTag Tag>
+ColumnType TypedRandomColumnGenerator<Tag>::generate() const {
+    if (sampler_) {
+        double sample;
+        T value;
+        sampler_->sample(&sample, 1);
+        store_clamped(&sample, &value, 1, lo_, hi_);
+        return value;
+    }
+    return static_cast<T>(dist_(RandomKernels::word_engine));
+}
+
+template<ColumnTypeTag Tag>
+void TypedRandomColumnGenerator<Tag>::fill(T* out, size_t count) const {
+    if (sampler_) {
+        constexpr size_t CHUNK = 256;
+        double buffer[CHUNK];
+        for (size_t done = 0; done < count; ) {
+            const size_t n = std::min(CHUNK, count - done);
+            sampler_->sample(buffer, n);
+            store_clamped(buffer, out + done, n, lo_, hi_);
+            done += n;
+        }
+        return;
+    }
+
+    if constexpr (std::is_same_v<T, bool>) {
+        RandomKernels::fill_bool(out, count);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        RandomKernels::fill_uniform(out, count, lo_, hi_);
+    } else {
+        RandomKernels::fill_bounded(out, count, lo_, hi_);
+    }
+}
+
+template class TypedRandomColumnGenerator<ColumnTypeTag::BOOL>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::TINYINT>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::TINYINT_UNSIGNED>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::SMALLINT>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::SMALLINT_UNSIGNED>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::INT>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::INT_UNSIGNED>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::BIGINT>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::BIGINT_UNSIGNED>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::FLOAT>;
+template class TypedRandomColumnGenerator<ColumnTypeTag::DOUBLE>;
+
+std::unique_ptr<ColumnGenerator> create_typed_random_generator(const ColumnConfigInstance& instance) {
+    switch (instance.config().type_tag) {
+        case ColumnTypeTag::BOOL:              return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::BOOL>>(instance);
+        case ColumnTypeTag::TINYINT:           return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::TINYINT>>(instance);
+        case ColumnTypeTag::TINYINT_UNSIGNED:  return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::TINYINT_UNSIGNED>>(instance);
+        case ColumnTypeTag::SMALLINT:          return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::SMALLINT>>(instance);
+        case ColumnTypeTag::SMALLINT_UNSIGNED: return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::SMALLINT_UNSIGNED>>(instance);
+        case ColumnTypeTag::INT:               return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::INT>>(instance);
+        case ColumnTypeTag::INT_UNSIGNED:      return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::INT_UNSIGNED>>(instance);
+        case ColumnTypeTag::BIGINT:            return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::BIGINT>>(instance);
+        case ColumnTypeTag::BIGINT_UNSIGNED:   return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::BIGINT_UNSIGNED>>(instance);
+        case ColumnTypeTag::FLOAT:             return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::FLOAT>>(instance);
+        case ColumnTypeTag::DOUBLE:            return std::make_unique<TypedRandomColumnGenerator<ColumnTypeTag::DOUBLE>>(instance);
+        default:                               return nullptr;
+    }
+}
@@ -0,0 +1,121 @@
+#include "ValueDictionary.hpp"
+#include "StringUtils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+
+ValueDictionary::ValueDictionary(const ColumnConfig& config)
+    : is_fixed_(!config.is_var_length()),
+      element_size_(is_fixed_ ? config.get_fixed_type_size() : 0) {
+    values_.reserve(config.values_count > 0 ? config.values_count : 0);
+
+    if (is_fixed_) {
+        for (const auto& dbl_value : config.dbl_values) {
+            switch (config.type_tag) {
+                case ColumnTypeTag::BOOL:
+                    values_.push_back(dbl_value != 0.0);
+                    break;
+                case ColumnTypeTag::TINYINT:
+                    values_.push_back(static_cast<int8_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::TINYINT_UNSIGNED:
+                    values_.push_back(static_cast<uint8_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::SMALLINT:
+                    values_.push_back(static_cast<int16_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::SMALLINT_UNSIGNED:
+                    values_.push_back(static_cast<uint16_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::INT:
+                    values_.push_back(static_cast<int32_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::INT_UNSIGNED:
+                    values_.push_back(static_cast<uint32_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::BIGINT:
+                    values_.push_back(static_cast<int64_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::BIGINT_UNSIGNED:
+                    values_.push_back(static_cast<uint64_t>(dbl_value));
+                    break;
+                case ColumnTypeTag::FLOAT:
+                    values_.push_back(static_cast<float>(dbl_value));
+                    break;
+                case ColumnTypeTag::DOUBLE:
+                    values_.push_back(dbl_value);
+                    break;
+                default:
+                    throw std::runtime_error("Values not supported for this type");
+            }
+        }
+
+        // Entries in storage layout, element_size apart
+        data_.resize(values_.size() * element_size_);
+        for (size_t i = 0; i < values_.size(); ++i) {
+            std::visit([this, i](const auto& v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_arithmetic_v<T>) {
+                    std::memcpy(data_.data() + i * element_size_, &v, sizeof(T));
+                }
+            }, values_[i]);
+        }
+    } else {
+        for (const auto& str_value : config.str_values) {
+            switch (config.type_tag) {
+                case ColumnTypeTag::NCHAR:
+                    values_.push_back(StringUtils::utf8_to_u16string(str_value));
+                    break;
+                case ColumnTypeTag::VARCHAR:
+                case ColumnTypeTag::BINARY:
+                    values_.push_back(str_value);
+                    break;
+                default:
+                    throw std::runtime_error("Values not supported for this type");
+            }
+
+            // NCHAR is stored as UTF-8, which is what the config string already is
+            offsets_.push_back(data_.size());
+            lengths_.push_back(str_value.size());
+            data_.insert(data_.end(), str_value.begin(), str_value.end());
+        }
+    }
+}
+
+std::string_view ValueDictionary::bytes(uint32_t index) const {
+    if (is_fixed_) {
+        return std::string_view(data_.data() + index * element_size_, element_size_);
+    }
+    return std::string_view(data_.data() + offsets_[index], lengths_[index]);
+}
+
+void ValueDictionary::fill(const uint32_t* indices, void* dest, size_t count) const {
+    if (!is_fixed_) {
+        throw std::runtime_error("ValueDictionary: fixed fill on a var-length column");
+    }
+
+    char* out = static_cast<char*>(dest);
+    const char* data = data_.data();
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(out + i * element_size_, data + indices[i] * element_size_, element_size_);
+    }
+}
+
+size_t ValueDictionary::fill(const uint32_t* indices, char* dest, int32_t* lengths, size_t max_length, size_t count) const {
+    if (is_fixed_) {
+        throw std::runtime_error("ValueDictionary: var fill on a fixed-length column");
+    }
+
+    size_t offset = 0;
+    const char* data = data_.data();
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = indices[i];
+        const size_t len = std::min(lengths_[index], max_length);
+        std::memcpy(dest + offset, data + offsets_[index], len);
+        lengths[i] = static_cast<int32_t>(len);
+        offset += len;
+    }
+    return offset;
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <cassert>
+#include <set>
+#include <string>
+#include <vector>
+#include "CorpusArena.hpp"
+
+
+void test_default_alphabet() {
+    ColumnConfig config("s", "varchar(16)");
+    CorpusArena arena(config);
+    assert(!arena.word_mode());
+
+    const size_t count = 300;
+    std::vector<char> buffer(count * 16);
+    std::vector<int32_t> lengths(count);
+    size_t bytes = arena.fill(buffer.data(), lengths.data(), 16, count);
+    (void)bytes;
+    assert(bytes == count * 16);
+
+    std::set<char> seen;
+    for (size_t i = 0; i < bytes; ++i) {
+        assert(buffer[i] >= 'a' && buffer[i] <= 'z');
+        seen.insert(buffer[i]);
+    }
+    assert(seen.size() == 26);
+
+    std::cout << "test_default_alphabet passed.\n";
+}
+
+void test_length_range() {
+    ColumnConfig config("s", "varchar(32)");
+    config.corpus = std::string("xyz");
+    config.min = 4;
+    config.max = 9;
+    CorpusArena arena(config);
+
+    const size_t count = 2000;
+    std::vector<char> buffer(count * 32);
+    std::vector<int32_t> lengths(count);
+    size_t bytes = arena.fill(buffer.data(), lengths.data(), 32, count);
+
+    size_t total = 0;
+    std::set<int32_t> seen;
+    for (auto len : lengths) {
+        assert(len >= 4 && len <= 8);
+        seen.insert(len);
+        total += len;
+    }
+    (void)bytes;
+    assert(total == bytes);
+    assert(seen.size() == 5);
+
+    // Column capacity wins over the configured range
+    size_t capped = arena.fill(buffer.data(), lengths.data(), 5, count);
+    (void)capped;
+    assert(capped <= count * 5);
+
+    std::cout << "test_length_range passed.\n";
+}
+
+void test_length_distribution() {
+    ColumnConfig config("s", "varchar(64)");
+    config.min = 0;
+    config.max = 61;
+    config.distribution = "normal";
+    config.mean = 30;
+    config.stddev = 3;
+    CorpusArena arena(config);
+
+    const size_t count = 5000;
+    std::vector<char> buffer(count * 64);
+    std::vector<int32_t> lengths(count);
+    arena.fill(buffer.data(), lengths.data(), 64, count);
+
+    double sum = 0;
+    for (auto len : lengths) sum += len;
+    double mean = sum / count;
+    (void)mean;
+    assert(mean > 29 && mean < 31);
+
+    std::cout << "test_length_distribution passed.\n";
+}
+
+void test_word_list() {
+    ColumnConfig config("s", "varchar(20)");
+    config.words = {"error", "warn", "info", "disk", "timeout"};
+    CorpusArena arena(config);
+    assert(arena.word_mode());
+    assert(arena.word_count() == 5);
+
+    const std::set<std::string> words(config.words.begin(), config.words.end());
+    for (int i = 0; i < 200; ++i) {
+        std::string value = arena.generate();
+        assert(!value.empty() && value.size() <= 20);
+
+        // Whole words separated by single spaces
+        size_t start = 0;
+        while (start <= value.size()) {
+            size_t end = value.find(' ', start);
+            if (end == std::string::npos) end = value.size();
+            assert(words.count(value.substr(start, end - start)) == 1);
+            start = end + 1;
+        }
+    }
+
+    std::cout << "test_word_list passed.\n";
+}
+
+void test_corpus_text_and_long_word() {
+    ColumnConfig config("s", "varchar(4)");
+    config.corpus = std::string("  sensor\toffline  ");
+    CorpusArena arena(config);
+    assert(arena.word_mode());
+    assert(arena.word_count() == 2);
+
+    // Words longer than the target are cut
+    for (int i = 0; i < 50; ++i) {
+        std::string value = arena.generate();
+        assert(value == "sens" || value == "offl");
+    }
+
+    std::cout << "test_corpus_text_and_long_word passed.\n";
+}
+
+void test_invalid_config() {
+    ColumnConfig config("s", "varchar(8)");
+    config.min = 6;
+    config.max = 3;
+    try {
+        CorpusArena arena(config);
+        assert(false && "Should throw when min >= max");
+    } catch (const std::runtime_error&) {}
+
+    ColumnConfig empty("s", "varchar(8)");
+    empty.corpus = std::string();
+    try {
+        CorpusArena arena(empty);
+        assert(false && "Should throw for an empty corpus");
+    } catch (const std::runtime_error&) {}
+
+    std::cout << "test_invalid_config passed.\n";
+}
+
+int main() {
+    test_default_alphabet();
+    test_length_range();
+    test_length_distribution();
+    test_word_list();
+    test_corpus_text_and_long_word();
+    test_invalid_config();
+
+    std::cout << "All CorpusArena tests passed.\n";
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <vector>
 #include "ExprColumnGenerator.hpp"
 
 void test_generate_expr_double_column() {
@@ -139,6 +140,64 @@ void test_generate_expr_unsupported_conversion() {
     }
 }
 
+void test_fill_expr_int_column() {
+    ColumnConfig config;
+    config.type = "smallint";
+    config.formula = std::string("_i * 3 % 10");
+    ColumnConfigInstance instance(config);
+
+    ExprColumnGenerator generator(instance);
+
+    std::vector<int16_t> buffer(300);
+    generator.fill(buffer.data(), buffer.size());
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        assert(buffer[i] == static_cast<int16_t>((i * 3) % 10));
+    }
+
+    std::cout << "test_fill_expr_int_column passed.\n";
+}
+
+void test_per_table_expr_column() {
+    ColumnConfig config;
+    config.type = "varchar(16)";
+    config.formula = std::string("({\"BYD\", \"NIO\", \"XPeng\"})[tonumber(string.match(_table, \"%d+\"))]");
+    ColumnConfigInstance instance(config);
+
+    ExprColumnGenerator generator("d3", instance);
+    assert(generator.is_per_table());
+    assert(std::get<std::string>(generator.generate()) == "XPeng");
+
+    std::vector<char> data(64);
+    std::vector<int32_t> lengths(4);
+    size_t total = generator.fill(data.data(), lengths.data(), 16, lengths.size());
+    assert(total == 20);
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        assert(lengths[i] == 5);
+        assert(std::string(data.data() + i * 5, 5) == "XPeng");
+    }
+
+    // Declared per_table: false keeps evaluating every row
+    config.per_table = false;
+    ColumnConfigInstance row_instance(config);
+    ExprColumnGenerator row_generator("d1", row_instance);
+    assert(!row_generator.is_per_table());
+    assert(std::get<std::string>(row_generator.generate()) == "BYD");
+
+    // Names outside the allow-list are per row unless declared per_table: true
+    ColumnConfig math_config;
+    math_config.type = "double";
+    math_config.formula = std::string("math.floor(string.len(_table) * 1.5)");
+    ColumnConfigInstance math_instance(math_config);
+    assert(!ExprColumnGenerator("d10", math_instance).is_per_table());
+    math_config.per_table = true;
+    ColumnConfigInstance declared_instance(math_config);
+    ExprColumnGenerator declared("d10", declared_instance);
+    assert(declared.is_per_table());
+    assert(std::get<double>(declared.generate()) == 4.0);
+
+    std::cout << "test_per_table_expr_column passed.\n";
+}
+
 int main() {
     test_generate_expr_double_column();
     test_generate_expr_string_column();
@@ -147,6 +206,8 @@ int main() {
     test_generate_expr_nchar_column();
     test_generate_expr_multiple_values();
     test_generate_expr_unsupported_conversion();
+    test_fill_expr_int_column();
+    test_per_table_expr_column();
 
     std::cout << "All ExprColumnGenerator tests passed.\n";
     return 0;
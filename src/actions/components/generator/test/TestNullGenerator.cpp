@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include "NullGenerator.hpp"
+
+
+void test_disabled_generator() {
+    ColumnConfig config("v", "int");
+    NullGenerator generator(config);
+    assert(!generator.enabled());
+
+    std::vector<char> flags(100, 7);
+    assert(generator.fill(flags.data(), flags.size()) == 100);
+    for (char f : flags) {
+        (void)f;
+        assert(f == CELL_VALUE);
+    }
+    assert(generator.next() == CELL_VALUE);
+
+    std::cout << "test_disabled_generator passed.\n";
+}
+
+void test_null_and_none_ratios() {
+    NullGenerator generator(0.1, 0.3);
+    assert(generator.enabled());
+
+    std::vector<char> flags(100000);
+    size_t values = generator.fill(flags.data(), flags.size());
+
+    size_t nulls = 0, nones = 0, counted_values = 0;
+    for (char f : flags) {
+        if (f == CELL_NULL) nulls++;
+        else if (f == CELL_NONE) nones++;
+        else counted_values++;
+    }
+    (void)values;
+    assert(values == counted_values);
+    assert(nulls > 9000 && nulls < 11000);
+    assert(nones > 28500 && nones < 31500);
+
+    std::cout << "test_null_and_none_ratios passed.\n";
+}
+
+void test_all_null_and_per_row() {
+    NullGenerator generator(1.0, 0.0);
+    for (int i = 0; i < 200; ++i) {
+        assert(generator.next() == CELL_NULL);
+    }
+
+    std::vector<char> flags(130);
+    assert(generator.fill(flags.data(), flags.size()) == 0);
+
+    std::cout << "test_all_null_and_per_row passed.\n";
+}
+
+void test_invalid_ratios() {
+    try {
+        NullGenerator generator(0.7, 0.5);
+        assert(false && "Should throw when ratios sum above 1");
+    } catch (const std::runtime_error&) {}
+
+    try {
+        NullGenerator generator(-0.1, 0.0);
+        assert(false && "Should throw for negative ratio");
+    } catch (const std::runtime_error&) {}
+
+    std::cout << "test_invalid_ratios passed.\n";
+}
+
+int main() {
+    test_disabled_generator();
+    test_null_and_none_ratios();
+    test_all_null_and_per_row();
+    test_invalid_ratios();
+
+    std::cout << "All NullGenerator tests passed.\n";
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "OrderColumnGenerator.hpp"
 #include <iostream>
 #include <cassert>
+#include <vector>
 
 void test_generate_bool_order_column() {
     ColumnConfig config;
@@ -237,6 +238,29 @@ void test_unsupported_type_tag_exception() {
     std::cout << "test_unsupported_type_tag_exception passed." << std::endl;
 }
 
+void test_fill_order_column() {
+    ColumnConfig config;
+    config.type = "smallint";
+    config.order_min = 5;
+    config.order_max = 8;
+    config.parse_type();
+    ColumnConfigInstance instance(config);
+
+    OrderColumnGenerator generator(instance);
+
+    std::vector<int16_t> buffer(7);
+    generator.fill(buffer.data(), buffer.size());
+    const int16_t expected[] = {5, 6, 7, 5, 6, 7, 5};
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        assert(buffer[i] == expected[i]);
+    }
+
+    // The sequence continues across fill and generate calls
+    ColumnType next = generator.generate();
+    assert(std::get<int16_t>(next) == 6);
+    std::cout << "test_fill_order_column passed." << std::endl;
+}
+
 int main() {
     test_generate_bool_order_column();
     test_generate_tinyint_order_column();
@@ -250,6 +274,7 @@ int main() {
     test_generate_multiple_values();
     test_invalid_order_range_exception();
     test_unsupported_type_tag_exception();
+    test_fill_order_column();
 
     std::cout << "All OrderColumnGenerator tests passed." << std::endl;
     return 0;
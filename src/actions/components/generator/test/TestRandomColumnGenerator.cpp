@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cassert>
 #include "RandomColumnGenerator.hpp"
+#include <vector>
+#include <string>
 
 void test_generate_int_column() {
     ColumnConfig config;
@@ -69,8 +71,11 @@ void test_generate_string_column_with_corpus() {
         ColumnType value = generator.generate();
         assert(std::holds_alternative<std::string>(value));
         std::string str_value = std::get<std::string>(value);
-        assert(str_value.size() == 1);
-        assert(config.corpus->find(str_value[0]) != std::string::npos);
+        assert(str_value.size() == 10);
+        for (char c : str_value) {
+            (void)c;
+            assert(config.corpus->find(c) != std::string::npos);
+        }
     }
 
     std::cout << "test_generate_string_column passed.\n";
@@ -156,6 +161,189 @@ void test_generate_string_column_with_values() {
     std::cout << "test_generate_string_column_with_values passed.\n";
 }
 
+void test_fill_int_column() {
+    ColumnConfig config;
+    config.type = "int";
+    config.min = 10;
+    config.max = 20;
+    ColumnConfigInstance instance(config);
+
+    RandomColumnGenerator generator(instance);
+
+    std::vector<int32_t> buffer(1000);
+    generator.fill(buffer.data(), buffer.size());
+    for (auto v : buffer) {
+        (void)v;
+        assert(v >= 10 && v < 20);
+    }
+
+    std::cout << "test_fill_int_column passed.\n";
+}
+
+void test_fill_float_column() {
+    ColumnConfig config;
+    config.type = "float";
+    config.min = -1.0;
+    config.max = 1.0;
+    ColumnConfigInstance instance(config);
+
+    RandomColumnGenerator generator(instance);
+
+    std::vector<float> buffer(1000);
+    generator.fill(buffer.data(), buffer.size());
+    for (auto v : buffer) {
+        (void)v;
+        assert(v >= -1.0f && v < 1.0f);
+    }
+
+    std::cout << "test_fill_float_column passed.\n";
+}
+
+void test_fill_varchar_column() {
+    ColumnConfig config;
+    config.type = "varchar(8)";
+    ColumnConfigInstance instance(config);
+
+    RandomColumnGenerator generator(instance);
+
+    const size_t count = 100;
+    std::vector<char> buffer(count * 8);
+    std::vector<int32_t> lengths(count);
+    size_t bytes = generator.fill(buffer.data(), lengths.data(), 8, count);
+
+    assert(bytes == count * 8);
+    for (size_t i = 0; i < count; ++i) {
+        assert(lengths[i] == 8);
+    }
+    for (size_t i = 0; i < bytes; ++i) {
+        assert(buffer[i] >= 'a' && buffer[i] <= 'z');
+    }
+
+    std::cout << "test_fill_varchar_column passed.\n";
+}
+
+void test_fill_nchar_column() {
+    ColumnConfig config;
+    config.type = "nchar(4)";
+    ColumnConfigInstance instance(config);
+
+    RandomColumnGenerator generator(instance);
+
+    const size_t count = 50;
+    const size_t max_length = static_cast<size_t>(*instance.config().cap);
+    std::vector<char> buffer(count * max_length);
+    std::vector<int32_t> lengths(count);
+    size_t bytes = generator.fill(buffer.data(), lengths.data(), max_length, count);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::u16string value = StringUtils::utf8_to_u16string(std::string(buffer.data() + offset, lengths[i]));
+        assert(value.size() == 4);
+        for (auto ch : value) {
+            (void)ch;
+            assert(ch >= 0x4E00 && ch <= 0x9FA5);
+        }
+        offset += lengths[i];
+    }
+    assert(offset == bytes);
+
+    std::cout << "test_fill_nchar_column passed.\n";
+}
+
+void test_fill_string_column_with_values() {
+    ColumnConfig config;
+    config.type = "varchar(10)";
+    config.parse_type();
+    config.set_values_from_strings(std::vector<std::string>{"foo", "barbaz"});
+
+    ColumnConfigInstance instance(config);
+    RandomColumnGenerator generator(instance);
+
+    const size_t count = 100;
+    std::vector<char> buffer(count * 10);
+    std::vector<int32_t> lengths(count);
+    size_t bytes = generator.fill(buffer.data(), lengths.data(), 10, count);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::string value(buffer.data() + offset, lengths[i]);
+        assert(value == "foo" || value == "barbaz");
+        offset += lengths[i];
+    }
+    assert(offset == bytes);
+
+    std::cout << "test_fill_string_column_with_values passed.\n";
+}
+
+void test_fill_int_column_with_values() {
+    ColumnConfig config;
+    config.type = "smallint";
+    config.parse_type();
+    config.set_values_from_doubles(std::vector<double>{-7, 300});
+    config.weights = {1.0, 3.0};
+
+    ColumnConfigInstance instance(config);
+    RandomColumnGenerator generator(instance);
+
+    // More than one index chunk
+    std::vector<int16_t> values(1000);
+    generator.fill(values.data(), values.size());
+
+    size_t high = 0;
+    for (auto v : values) {
+        assert(v == -7 || v == 300);
+        if (v == 300) high++;
+    }
+    (void)high;
+    assert(high > 650 && high < 850);
+
+    std::cout << "test_fill_int_column_with_values passed.\n";
+}
+
+void test_generate_weighted_values() {
+    ColumnConfig config;
+    config.type = "varchar(10)";
+    config.parse_type();
+    config.set_values_from_strings(std::vector<std::string>{"never", "rare", "common"});
+    config.weights = {0.0, 1.0, 9.0};
+
+    ColumnConfigInstance instance(config);
+    RandomColumnGenerator generator(instance);
+
+    size_t common = 0;
+    for (int i = 0; i < 10000; ++i) {
+        std::string value = std::get<std::string>(generator.generate());
+        assert(value != "never");
+        if (value == "common") common++;
+    }
+    (void)common;
+    assert(common > 8500 && common < 9500);
+
+    std::cout << "test_generate_weighted_values passed.\n";
+}
+
+void test_fill_normal_int_column() {
+    ColumnConfig config("v", "int", std::optional<std::string>("random"), 0, 100);
+    config.distribution = "normal";
+    config.mean = 50.0;
+    config.stddev = 5.0;
+
+    ColumnConfigInstance instance(config);
+    RandomColumnGenerator generator(instance);
+
+    std::vector<int32_t> values(10000);
+    generator.fill(values.data(), values.size());
+    size_t near_mean = 0;
+    for (auto v : values) {
+        assert(v >= 0 && v < 100);
+        if (v >= 40 && v <= 60) near_mean++;
+    }
+    (void)near_mean;
+    assert(near_mean > 9000);   // ~95% within two stddev
+
+    std::cout << "test_fill_normal_int_column passed.\n";
+}
+
 int main() {
     test_generate_int_column();
     test_generate_double_column();
@@ -165,6 +353,14 @@ int main() {
     test_generate_int_column_with_values();
     test_generate_bool_column_with_values();
     test_generate_string_column_with_values();
+    test_fill_int_column();
+    test_fill_float_column();
+    test_fill_varchar_column();
+    test_fill_nchar_column();
+    test_fill_string_column_with_values();
+    test_fill_int_column_with_values();
+    test_generate_weighted_values();
+    test_fill_normal_int_column();
 
     std::cout << "All tests passed.\n";
     return 0;
@@ -0,0 +1,165 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "Samplers.hpp"
+#include "TypedColumnGenerator.hpp"
+
+
+static void mean_and_stddev(const std::vector<double>& values, double& mean, double& stddev) {
+    double sum = 0, sum_sq = 0;
+    for (double v : values) {
+        sum += v;
+        sum_sq += v * v;
+    }
+    mean = sum / values.size();
+    stddev = std::sqrt(sum_sq / values.size() - mean * mean);
+}
+
+void test_normal_sampler() {
+    ColumnConfig config("v", "double", std::optional<std::string>("random"), -1000, 1000);
+    config.distribution = "normal";
+    config.mean = 10.0;
+    config.stddev = 2.0;
+
+    auto sampler = Sampler::create(config);
+    assert(sampler != nullptr);
+
+    std::vector<double> values(200000);
+    sampler->sample(values.data(), values.size());
+
+    double mean, stddev;
+    mean_and_stddev(values, mean, stddev);
+    (void)mean;
+    (void)stddev;
+    assert(std::abs(mean - 10.0) < 0.05);
+    assert(std::abs(stddev - 2.0) < 0.05);
+
+    std::cout << "test_normal_sampler passed.\n";
+}
+
+void test_exponential_sampler() {
+    ColumnConfig config("v", "double", std::optional<std::string>("random"), 5, 1000);
+    config.distribution = "exponential";
+    config.lambda = 0.5;
+
+    auto sampler = Sampler::create(config);
+    std::vector<double> values(200000);
+    sampler->sample(values.data(), values.size());
+
+    double mean, stddev;
+    mean_and_stddev(values, mean, stddev);
+    for (double v : values) {
+        (void)v;
+        assert(v >= 5.0);
+    }
+    (void)mean;
+    assert(std::abs(mean - 7.0) < 0.05);   // min + 1/lambda
+
+    std::cout << "test_exponential_sampler passed.\n";
+}
+
+void test_zipf_sampler() {
+    ColumnConfig config("v", "int", std::optional<std::string>("random"), 1, 101);
+    config.distribution = "zipf";
+    config.skew = 1.2;
+
+    auto sampler = Sampler::create(config);
+    std::vector<double> values(100000);
+    sampler->sample(values.data(), values.size());
+
+    std::vector<size_t> counts(101, 0);
+    for (double v : values) {
+        assert(v >= 1.0 && v <= 100.0 && v == std::floor(v));
+        counts[static_cast<size_t>(v)]++;
+    }
+
+    // P(1) = 1 / H(100, 1.2) ~= 0.2398
+    double harmonic = 0;
+    for (int k = 1; k <= 100; ++k) harmonic += std::pow(k, -1.2);
+    double expected = values.size() / harmonic;
+    (void)expected;
+    assert(std::abs(counts[1] - expected) < expected * 0.05);
+    assert(counts[1] > counts[2] && counts[2] > counts[10]);
+
+    std::cout << "test_zipf_sampler passed.\n";
+}
+
+void test_alias_table() {
+    AliasTable table({1.0, 0.0, 3.0, 6.0});
+    assert(table.size() == 4);
+
+    std::vector<uint32_t> picks(100000);
+    table.sample(picks.data(), picks.size());
+
+    size_t counts[4] = {0, 0, 0, 0};
+    for (auto p : picks) {
+        assert(p < 4);
+        counts[p]++;
+    }
+    assert(counts[1] == 0);
+    assert(std::abs(static_cast<double>(counts[0]) / picks.size() - 0.1) < 0.01);
+    assert(std::abs(static_cast<double>(counts[2]) / picks.size() - 0.3) < 0.01);
+    assert(std::abs(static_cast<double>(counts[3]) / picks.size() - 0.6) < 0.01);
+
+    std::cout << "test_alias_table passed.\n";
+}
+
+void test_typed_generator_clamps_samples() {
+    ColumnConfig config("v", "tinyint", std::optional<std::string>("random"), 0, 10);
+    config.distribution = "normal";
+    config.mean = 5.0;
+    config.stddev = 50.0;
+
+    ColumnConfigInstance instance(config);
+    TypedRandomColumnGenerator<ColumnTypeTag::TINYINT> generator(instance);
+
+    std::vector<int8_t> values(10000);
+    generator.fill(values.data(), values.size());
+    bool saw_min = false, saw_max = false;
+    for (auto v : values) {
+        assert(v >= 0 && v <= 9);
+        saw_min |= v == 0;
+        saw_max |= v == 9;
+    }
+    (void)saw_min;
+    (void)saw_max;
+    assert(saw_min && saw_max);
+
+    std::cout << "test_typed_generator_clamps_samples passed.\n";
+}
+
+void test_uniform_and_invalid() {
+    ColumnConfig config("v", "int", std::optional<std::string>("random"), 0, 10);
+    assert(Sampler::create(config) == nullptr);
+
+    config.distribution = "uniform";
+    assert(Sampler::create(config) == nullptr);
+
+    config.distribution = "normal";
+    config.stddev = 0.0;
+    try {
+        Sampler::create(config);
+        assert(false && "Should throw for non-positive stddev");
+    } catch (const std::runtime_error&) {}
+
+    config.distribution = "poisson";
+    try {
+        Sampler::create(config);
+        assert(false && "Should throw for unknown distribution");
+    } catch (const std::runtime_error&) {}
+
+    std::cout << "test_uniform_and_invalid passed.\n";
+}
+
+int main() {
+    test_normal_sampler();
+    test_exponential_sampler();
+    test_zipf_sampler();
+    test_alias_table();
+    test_typed_generator_clamps_samples();
+    test_uniform_and_invalid();
+
+    std::cout << "All Samplers tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "SignalColumnGenerator.hpp"
+#include "ColumnGeneratorFactory.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+ColumnConfig make_config(const std::string& type, const std::string& gen_type, double min, double max) {
+    ColumnConfig config("signal", type, gen_type, min, max);
+    return config;
+}
+
+void test_sine() {
+    ColumnConfig config = make_config("double", "sine", -1, 1);
+    config.period = 8;
+    ColumnConfigInstance instance(config);
+    SignalColumnGenerator<ColumnTypeTag::DOUBLE> generator(instance);
+
+    std::vector<double> values(20);
+    generator.fill(values.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        (void)i;
+        assert(std::abs(values[i] - std::sin(6.283185307179586 * static_cast<double>(i % 8) / 8)) < 1e-12);
+    }
+
+    // generate() continues where fill() stopped
+    assert(std::abs(std::get<double>(generator.generate()) - std::sin(6.283185307179586 * 4 / 8)) < 1e-12);
+
+    std::cout << "test_sine passed.\n";
+}
+
+void test_sine_noise_is_clamped() {
+    ColumnConfig config = make_config("float", "sine", 10, 20);
+    config.period = 50;
+    config.noise = 3;
+    ColumnConfigInstance instance(config);
+    SignalColumnGenerator<ColumnTypeTag::FLOAT> generator(instance);
+
+    std::vector<float> values(1000);
+    generator.fill(values.data(), values.size());
+    bool noisy = false;
+    for (size_t i = 0; i < values.size(); ++i) {
+        assert(values[i] >= 10 && values[i] <= 20);
+        const double clean = 15 + 5 * std::sin(6.283185307179586 * static_cast<double>(i % 50) / 50);
+        noisy |= std::abs(values[i] - clean) > 1e-3;
+    }
+    assert(noisy);
+    (void)noisy;
+
+    std::cout << "test_sine_noise_is_clamped passed.\n";
+}
+
+void test_seasonal_peak() {
+    ColumnConfig config = make_config("double", "seasonal", 0, 100);
+    config.period = 1440;
+    ColumnConfigInstance instance(config);
+    SignalColumnGenerator<ColumnTypeTag::DOUBLE> generator(instance);
+
+    std::vector<double> values(1440 * 2);
+    generator.fill(values.data(), values.size());
+    double lo = 100, hi = 0;
+    for (size_t i = 0; i < 1440; ++i) {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+        assert(values[i] == values[i + 1440]);
+    }
+    assert(hi > 99.9 && hi <= 100);
+    assert(lo >= 0 && lo < 50);
+
+    std::cout << "test_seasonal_peak passed.\n";
+}
+
+void test_sawtooth() {
+    ColumnConfig config = make_config("int", "sawtooth", 0, 10);
+    config.period = 5;
+    ColumnConfigInstance instance(config);
+    SignalColumnGenerator<ColumnTypeTag::INT> generator(instance);
+
+    std::vector<int32_t> values(10);
+    generator.fill(values.data(), values.size());
+    const std::vector<int32_t> expected = {0, 2, 4, 6, 8, 0, 2, 4, 6, 8};
+    assert(values == expected);
+
+    std::cout << "test_sawtooth passed.\n";
+}
+
+void test_random_walk_bounds() {
+    for (const char* boundary : {"reflect", "wrap"}) {
+        ColumnConfig config = make_config("double", "random_walk", 410, 430);
+        config.mean = 430;
+        config.drift = -0.5;
+        config.stddev = 0.3;
+        config.boundary = boundary;
+        ColumnConfigInstance instance(config);
+        SignalColumnGenerator<ColumnTypeTag::DOUBLE> generator(instance);
+
+        std::vector<double> values(5000);
+        generator.fill(values.data(), values.size());
+
+        size_t jumps = 0;
+        for (size_t i = 0; i < values.size(); ++i) {
+            assert(values[i] >= 410 && values[i] <= 430);
+            if (i > 0 && std::abs(values[i] - values[i - 1]) > 5) ++jumps;
+        }
+        // Wrapping re-enters at the top, reflecting never jumps
+        assert(std::string(boundary) == "wrap" ? jumps > 0 : jumps == 0);
+        (void)jumps;
+    }
+
+    std::cout << "test_random_walk_bounds passed.\n";
+}
+
+void test_step() {
+    ColumnConfig config = make_config("double", "step", 0, 1);
+    config.period = 50;
+    ColumnConfigInstance instance(config);
+    SignalColumnGenerator<ColumnTypeTag::DOUBLE> generator(instance);
+
+    std::vector<double> values(10000);
+    generator.fill(values.data(), values.size());
+    size_t changes = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        assert(values[i] >= 0 && values[i] <= 1);
+        changes += values[i] != values[i - 1];
+    }
+    // About one change every 50 rows
+    assert(changes > 120 && changes < 290);
+    (void)changes;
+
+    std::cout << "test_step passed.\n";
+}
+
+void test_factory_and_errors() {
+    ColumnConfig config = make_config("smallint", "random_walk", 0, 100);
+    ColumnConfigInstance instance(config);
+    auto generator = ColumnGeneratorFactory::create("d0", instance);
+    assert(generator);
+    assert(std::holds_alternative<int16_t>(generator->generate()));
+
+    ColumnConfig text = make_config("varchar(10)", "sine", 0, 1);
+    ColumnConfigInstance text_instance(text);
+    bool thrown = false;
+    try {
+        ColumnGeneratorFactory::create("d0", text_instance);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    ColumnConfig bad_period = make_config("double", "sine", 0, 1);
+    bad_period.period = 0;
+    ColumnConfigInstance bad_instance(bad_period);
+    thrown = false;
+    try {
+        SignalColumnGenerator<ColumnTypeTag::DOUBLE> bad(bad_instance);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    (void)thrown;
+
+    std::cout << "test_factory_and_errors passed.\n";
+}
+
+int main() {
+    test_sine();
+    test_sine_noise_is_clamped();
+    test_seasonal_peak();
+    test_sawtooth();
+    test_random_walk_bounds();
+    test_step();
+    test_factory_and_errors();
+
+    std::cout << "All tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cassert>
+#include "TableNameList.hpp"
+
+void test_sequence_names() {
+    auto list = TableNameList::sequence("d", 0, 1000);
+    assert(list.size() == 1000);
+
+    std::string buffer;
+    assert(list.at(0, buffer) == "d0");
+    assert(list.at(999, buffer) == "d999");
+    assert(list[42] == "d42");
+
+    // Negative and large starting indexes
+    auto negative = TableNameList::sequence("t_", -2, 3);
+    assert(negative[0] == "t_-2");
+    assert(negative[2] == "t_0");
+    auto large = TableNameList::sequence("x", 9000000000LL, 1);
+    assert(large[0] == "x9000000000");
+
+    std::cout << "test_sequence_names passed.\n";
+}
+
+void test_interned_names() {
+    auto list = TableNameList::intern({"alpha", "", "gamma"});
+    assert(list.size() == 3);
+
+    std::string buffer;
+    assert(list.at(0, buffer) == "alpha");
+    assert(list.at(1, buffer).empty());
+    assert(list.at(2, buffer) == "gamma");
+    assert(buffer.empty());     // Arena views never touch the buffer
+
+    // NUL-terminated in place, or formatted into the buffer
+    assert(std::string(list.c_str(2, buffer)) == "gamma" && buffer.empty());
+    assert(std::string(list.c_str(1, buffer)).empty());
+    auto sequence = TableNameList::sequence("d", 0, 20);
+    assert(std::string(sequence.c_str(17, buffer)) == "d17" && buffer == "d17");
+
+    std::cout << "test_interned_names passed.\n";
+}
+
+void test_slices() {
+    auto sequence = TableNameList::sequence("d", 1, 10).slice(4, 3);
+    assert(sequence.size() == 3);
+    assert(sequence[0] == "d5");
+    assert(sequence[2] == "d7");
+
+    auto interned = TableNameList::intern({"a", "b", "c", "d"}).slice(1, 3).slice(1, 2);
+    assert(interned.size() == 2);
+    assert(interned[0] == "c");
+    assert(interned[1] == "d");
+
+    assert(TableNameList::sequence("d", 0, 5).slice(5, 0).empty());
+
+    try {
+        (void)TableNameList::sequence("d", 0, 5).slice(3, 3);
+        assert(false && "Should throw for a slice past the end");
+    } catch (const std::out_of_range&) {
+    }
+
+    try {
+        (void)sequence[3];
+        assert(false && "Should throw for an index past the end");
+    } catch (const std::out_of_range&) {
+    }
+
+    std::cout << "test_slices passed.\n";
+}
+
+int main() {
+    test_sequence_names();
+    test_interned_names();
+    test_slices();
+
+    std::cout << "All tests passed.\n";
+    return 0;
+}
@@ -40,6 +40,53 @@ void test_generate_multiple_timestamps() {
     std::cout << "test_generate_multiple_timestamps passed.\n";
 }
 
+void test_fill_timestamps() {
+    TimestampGeneratorConfig config;
+    config.start_timestamp = Timestamp{1000};
+    config.timestamp_step = 3;
+    config.timestamp_precision = "us";
+
+    TimestampGenerator generator(config);
+
+    std::vector<int64_t> timestamps(600);
+    generator.fill(timestamps.data(), timestamps.size());
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        assert(timestamps[i] == 1000 + static_cast<int64_t>(i) * 3);
+    }
+
+    // fill and generate continue the same sequence
+    assert(generator.generate() == 1000 + 600 * 3);
+
+    generator.reset();
+    assert(generator.generate() == 1000);
+
+    std::cout << "test_fill_timestamps passed.\n";
+}
+
+void test_fill_timestamps_with_jitter() {
+    TimestampGeneratorConfig config;
+    config.start_timestamp = Timestamp{0};
+    config.timestamp_step = 100;
+    config.timestamp_jitter = std::string("10");
+    config.timestamp_precision = "ms";
+
+    TimestampGenerator generator(config);
+
+    std::vector<int64_t> timestamps(1000);
+    generator.fill(timestamps.data(), timestamps.size());
+
+    bool moved = false;
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        const int64_t offset = timestamps[i] - static_cast<int64_t>(i) * 100;
+        assert(offset >= 0 && offset < 10);
+        if (offset != 0) moved = true;
+    }
+    (void)moved;
+    assert(moved);
+
+    std::cout << "test_fill_timestamps_with_jitter passed.\n";
+}
+
 void test_invalid_start_timestamp() {
     try {
         TimestampGeneratorConfig config;
@@ -116,6 +163,8 @@ void test_start_timestamp_now() {
 int main() {
     test_generate_single_timestamp();
     test_generate_multiple_timestamps();
+    test_fill_timestamps();
+    test_fill_timestamps_with_jitter();
     test_invalid_start_timestamp();
     test_start_timestamp_now();
 
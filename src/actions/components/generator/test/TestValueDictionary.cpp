@@ -0,0 +1,87 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ValueDictionary.hpp"
+
+
+void test_fixed_dictionary() {
+    ColumnConfig config("v", "bigint");
+    config.set_values_from_doubles(std::vector<double>{1, -2, 3000000000});
+
+    ValueDictionary dictionary(config);
+    assert(dictionary.is_fixed());
+    assert(dictionary.size() == 3);
+    assert(std::get<int64_t>(dictionary.value(1)) == -2);
+    assert(dictionary.bytes(2).size() == sizeof(int64_t));
+
+    const uint32_t indices[] = {2, 0, 1, 1};
+    int64_t out[4];
+    dictionary.fill(indices, out, 4);
+    assert(out[0] == 3000000000LL);
+    assert(out[1] == 1);
+    assert(out[2] == -2 && out[3] == -2);
+
+    std::cout << "test_fixed_dictionary passed.\n";
+}
+
+void test_var_dictionary() {
+    ColumnConfig config("v", "varchar(4)");
+    config.set_values_from_strings(std::vector<std::string>{"ab", "", "longer"});
+
+    ValueDictionary dictionary(config);
+    assert(!dictionary.is_fixed());
+    assert(dictionary.bytes(0) == "ab");
+    assert(dictionary.bytes(1).empty());
+    assert(std::get<std::string>(dictionary.value(2)) == "longer");
+
+    // Entries are packed back to back and cut at max_length
+    const uint32_t indices[] = {0, 2, 1, 0};
+    char buffer[16];
+    int32_t lengths[4];
+    size_t bytes = dictionary.fill(indices, buffer, lengths, 4, 4);
+    (void)bytes;
+    assert(bytes == 8);
+    assert(lengths[0] == 2 && lengths[1] == 4 && lengths[2] == 0 && lengths[3] == 2);
+    assert(std::string(buffer, bytes) == "ablongab");
+
+    std::cout << "test_var_dictionary passed.\n";
+}
+
+void test_nchar_dictionary() {
+    ColumnConfig config("v", "nchar(8)");
+    config.set_values_from_strings(std::vector<std::string>{"北京", "sh"});
+
+    ValueDictionary dictionary(config);
+    assert(std::holds_alternative<std::u16string>(dictionary.value(0)));
+    assert(dictionary.bytes(0) == "北京");
+
+    std::cout << "test_nchar_dictionary passed.\n";
+}
+
+void test_wrong_fill_kind() {
+    ColumnConfig config("v", "int");
+    config.set_values_from_doubles(std::vector<double>{1});
+    ValueDictionary dictionary(config);
+
+    const uint32_t index = 0;
+    char buffer[8];
+    int32_t length;
+    try {
+        dictionary.fill(&index, buffer, &length, 8, 1);
+        assert(false && "Should throw for var fill on a fixed column");
+    } catch (const std::runtime_error&) {}
+
+    std::cout << "test_wrong_fill_kind passed.\n";
+}
+
+int main() {
+    test_fixed_dictionary();
+    test_var_dictionary();
+    test_nchar_dictionary();
+    test_wrong_fill_kind();
+
+    std::cout << "All ValueDictionary tests passed.\n";
+    return 0;
+}
@@ -6,8 +6,15 @@
 #include "ColumnConverter.hpp"
 #include "CheckpointData.hpp"
 #include "TableData.hpp"
+#include "PageAllocator.hpp"
 #include "taos.h"
 #include <vector>
+#include <array>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <atomic>
 #include <memory>
 #include <cstdlib>
@@ -15,8 +22,19 @@
 #include <limits>
 #include <stdexcept>
 
+// Placement and backing of the pool's memory
+struct MemoryPoolOptions {
+    size_t partitions = 1;                  // Free lists, one per NUMA node
+    std::string huge_pages = "off";         // off, transparent, 2mb or 1gb
+    bool prefault = false;                  // Map every chunk page at startup, in parallel
+    size_t memory_limit = 0;                // Byte budget for blocks; 0 keeps the block count fixed
+    size_t producers = 0;                   // Block caches to hand out; 0 for one per initial block
+};
+
 class MemoryPool {
 public:
+    struct VarArena;
+
     struct TableBase {
         struct Column {
             bool is_fixed;
@@ -31,9 +49,23 @@ public:
             int32_t* lengths = nullptr;    // Length per row
             size_t* var_offsets = nullptr; // Offset per row in variable data area
             size_t current_offset = 0;     // Current write offset
+            size_t var_capacity = 0;       // Bytes available at var_data
+            VarArena* var_arena = nullptr; // Arena var_data lives in; nullptr for a fixed region
 
-            // NULL marker
+            // Per-row CELL_VALUE / CELL_NULL / CELL_NONE
             char* is_nulls = nullptr;
+
+            // Room for bytes more at current_offset. var_data moves when the
+            // segment has to grow; offsets stay relative to it
+            char* reserve_var(size_t bytes) {
+                if (current_offset + bytes > var_capacity) {
+                    grow_var(current_offset + bytes);
+                }
+                return var_data + current_offset;
+            }
+            // Bytes reserve_var() can hand out without moving var_data
+            size_t var_room() const;
+            void grow_var(size_t required);
         };
 
         size_t max_rows = 0;
@@ -53,15 +85,17 @@ public:
     };
 
     struct TableBlock : public TableBase {
+        // Tag values of one or more tables; identical tuples share one Tags.
+        // The data chunk lives in the TagsManager arena
         struct Tags {
-            std::string table_name;
+            std::string table_name;                 // First table registered with these values
             std::vector<TableBase::Column> columns;
             void* data_chunk = nullptr;
             size_t data_chunk_size = 0;
             std::vector<TAOS_STMT2_BIND> bind_tags;
 
             Tags() = default;
-            ~Tags();
+            ~Tags() = default;
 
             Tags(const Tags&) = delete;
             Tags& operator=(const Tags&) = delete;
@@ -71,6 +105,7 @@ public:
         };
 
         const char* table_name;
+        std::string name_buffer;            // Backs table_name when it is formatted on demand
         int64_t* timestamps = nullptr;
         const CachedTableBlock* cached_table_block = nullptr;
         const Tags* tags_ptr = nullptr;
@@ -86,12 +121,48 @@ public:
                                  const char* context,
                                  const Cols& cols,
                                  const Handlers& handlers) const;
+        // CELL_* flag of a data cell; get_column_cell() only accepts CELL_VALUE cells
+        char get_column_flag(size_t row_index, size_t col_index) const;
         ColumnType get_column_cell(size_t row_index, size_t col_index) const;
         ColumnType get_tag_cell(size_t row_index, size_t col_index) const;
         std::string get_column_cell_as_string(size_t row_index, size_t col_index) const;
         std::string get_tag_cell_as_string(size_t row_index, size_t col_index) const;
     };
 
+    // Block cache id of callers without a cache of their own
+    static constexpr size_t NO_BLOCK_CACHE = static_cast<size_t>(-1);
+
+    // Bump allocator for the variable-length column data of one block: a
+    // region of the block's chunk, then overflow chunks from the pool. Each
+    // column owns one segment and moves to a larger one when it outgrows it;
+    // reset() keeps a single overflow chunk sized to what the block spilled,
+    // while the pool is within its memory limit
+    struct VarArena {
+        struct Chunk {
+            char* data = nullptr;
+            size_t size = 0;
+            size_t used = 0;
+            PageBacking backing = PageBacking::HEAP;
+        };
+
+        MemoryPool* pool = nullptr;                         // Allocates and accounts for overflow
+        std::vector<Chunk> chunks;                          // chunks[0] lies in the block's chunk, the rest are overflow
+        size_t current = 0;
+        TableBase::Column* tail = nullptr;                  // Last segment of chunks[current]
+        size_t slack = 0;                                   // Largest single value
+
+        void init(MemoryPool* owner, char* data, size_t size, size_t max_value_size);
+        void reset();
+        size_t room(const TableBase::Column& col) const;
+        void grow(TableBase::Column& col, size_t required);
+        size_t capacity() const;
+        void release_overflow();
+
+    private:
+        void trim_tail();
+        void add_overflow(size_t size);
+    };
+
     struct MemoryBlock {
         std::vector<TableBlock> tables;
         int64_t start_time = std::numeric_limits<int64_t>::max();
@@ -101,11 +172,17 @@ public:
         size_t tag_count = 0;
         size_t col_count = 0;
         size_t cache_index = 0;
+        size_t partition = 0;                                   // Free list the block returns to
+        bool resident = false;                                  // Holds its data chunk; trimmed blocks don't
+        size_t owner_cache = NO_BLOCK_CACHE;                    // Producer cache the block returns to
+        MemoryBlock* next_returned = nullptr;                   // Link in that cache's returned stack
         bool in_use = false;
         MemoryPool* owning_pool = nullptr;
 
         void* data_chunk = nullptr;                             // Continuous memory block for all data
         size_t data_chunk_size = 0;                             // Memory block size
+        PageBacking data_backing = PageBacking::HEAP;
+        VarArena var_arena;                                     // Unused when columns have fixed regions
 
         TAOS_STMT2_BINDV bindv_{};
         std::vector<const char*> tbnames_;                      // Table name pointer array
@@ -126,6 +203,7 @@ public:
         std::vector<CachedTableBlock> tables;
         void* data_chunk = nullptr;
         size_t data_chunk_size = 0;
+        PageBacking data_backing = PageBacking::HEAP;
         std::atomic<size_t> prefilled_count{0};
 
         CacheUnit() = default;
@@ -138,24 +216,38 @@ public:
         CacheUnit& operator=(CacheUnit&& other) noexcept;
     };
 
+    // num_blocks is the initial block count. With a memory_limit the pool
+    // grows past it when acquire finds no free block, up to the budget, and
+    // trims those extra blocks again once most of the pool sits idle
     MemoryPool(size_t num_blocks,
                size_t max_tables_per_block,
                size_t max_rows_per_table,
                const ColumnConfigInstanceVector& col_instances,
                const ColumnConfigInstanceVector& tag_instances,
                bool tables_reuse_data = false,
-               size_t num_cached_blocks = 0
+               size_t num_cached_blocks = 0,
+               const MemoryPoolOptions& options = MemoryPoolOptions()
             );
 
 
     ~MemoryPool();
 
-    // Get a free memory block (thread-safe)
-    MemoryBlock* acquire_block(size_t sequence_num = 0);
+    // Get a free memory block (thread-safe). With a block cache, blocks the
+    // caller filled earlier are reused first; otherwise the block comes from
+    // the partition of the caller's NUMA node, another partition, or another
+    // producer's cache
+    MemoryBlock* acquire_block(size_t sequence_num = 0, size_t cache = NO_BLOCK_CACHE);
 
-    // Return a memory block (thread-safe)
+    // Return a memory block (thread-safe), to the cache of the producer that
+    // acquired it while that producer is attached
     void release_block(MemoryBlock* block);
 
+    // Per-producer block caches; a cache is used by one thread at a time.
+    // Returns NO_BLOCK_CACHE once every cache has been handed out
+    size_t attach_block_cache();
+    // Give the cache's blocks back to the shared free lists
+    void detach_block_cache(size_t cache);
+
     // Write MultiBatch data into MemoryBlock
     MemoryBlock* convert_to_memory_block(MultiBatch&& batch);
 
@@ -163,20 +255,56 @@ public:
     const std::vector<ColumnConverter::ColumnHandler>& tag_handlers() const;
 
     bool is_cache_mode() const;
+    size_t partition_count() const { return free_queues_.size(); }
+
+    // Bytes one block takes: its data chunk plus table and binding metadata
+    size_t block_footprint() const { return block_footprint_; }
+    // Blocks created so far, and the most the memory limit allows
+    size_t block_count() const { return block_count_.load(std::memory_order_relaxed); }
+    size_t max_block_count() const { return max_blocks_; }
+    // Blocks currently holding their data chunk
+    size_t resident_block_count() const { return resident_blocks_.load(std::memory_order_relaxed); }
+    // Var arena overflow held by blocks, charged against the memory limit
+    size_t var_overflow_bytes() const { return var_overflow_bytes_.load(std::memory_order_relaxed); }
+
+    // Backings the pool's chunks ended up on
+    std::string page_backing() const { return page_allocator_.describe(); }
     CacheUnit* get_cache_unit(size_t index);
     size_t get_cache_units_count() const;
     bool fill_cache_unit_data(size_t cache_index, size_t table_index, const std::vector<RowData>& data_rows);
     bool is_cache_unit_prefilled(size_t cache_index) const;
 
     MemoryPool::TableBlock::Tags* register_table_tags(const std::string& table_name, const std::vector<ColumnType>& tag_values);
+
+    // Shared Tags for a tuple of tag values without a by-name entry; callers
+    // index the result by their own table id. Thread-safe, sharded by value
+    const TableBlock::Tags* intern_table_tags(const std::vector<ColumnType>& tag_values, const std::string& table_name = "");
     const TableBlock::Tags* get_table_tags(const std::string& table_name) const;
     bool has_table_tags(const std::string& table_name) const;
 
 private:
     struct TagsManager {
+        static constexpr size_t SHARD_COUNT = 64;
+
+        // Append-only: Tags and their data chunks never move once created
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<std::string_view, TableBlock::Tags*> by_value;  // Keyed by chunk bytes
+            std::deque<TableBlock::Tags> tags;
+            struct Slab {
+                void* data;
+                size_t size;
+                PageBacking backing;
+            };
+            std::vector<Slab> slabs;
+            char* slab_cursor = nullptr;
+            size_t slab_left = 0;
+        };
+
         const ColumnConfigInstanceVector& tag_instances_;
         std::vector<ColumnConverter::ColumnHandler> tag_handlers_;
-        std::unordered_map<std::string, std::unique_ptr<TableBlock::Tags>> tags_map_;
+        std::array<Shard, SHARD_COUNT> shards_;
+        std::unordered_map<std::string, TableBlock::Tags*> tags_map_;
         mutable std::mutex tags_map_mutex_;
 
         size_t fixed_data_size_ = 0;
@@ -185,23 +313,60 @@ private:
         size_t common_meta_size_ = 0;
         size_t total_size_ = 0;
 
-        TagsManager(const ColumnConfigInstanceVector& tag_instances);
+        PageAllocator& allocator_;
+
+        TagsManager(const ColumnConfigInstanceVector& tag_instances, PageAllocator& allocator);
+        ~TagsManager();
+
+        TagsManager(const TagsManager&) = delete;
+        TagsManager& operator=(const TagsManager&) = delete;
 
         void calculate_memory_size();
-        void init_table_tags(TableBlock::Tags& tags, const std::vector<ColumnType>& tag_values);
+        // Point the columns and bindings of tags at a chunk of total_size_ bytes
+        void layout_table_tags(TableBlock::Tags& tags, char* chunk) const;
+        void write_tag_values(TableBlock::Tags& tags, const std::vector<ColumnType>& tag_values) const;
+        char* allocate_chunk(Shard& shard) const;
+        TableBlock::Tags* intern_tags(const std::vector<ColumnType>& tag_values, const std::string& table_name);
         MemoryPool::TableBlock::Tags* register_tags(const std::string& table_name, const std::vector<ColumnType>& tag_values);
         const TableBlock::Tags* get_tags(const std::string& table_name) const;
         bool has_tags(const std::string& table_name) const;
     };
 
+    PageAllocator page_allocator_;              // Outlives tags_manager_, which allocates from it
+    bool prefault_ = false;
     size_t max_tables_per_block_;
     size_t max_rows_per_table_;
     const ColumnConfigInstanceVector& col_instances_;
     const ColumnConfigInstanceVector& tag_instances_;
     std::vector<ColumnConverter::ColumnHandler> col_handlers_;
     std::vector<ColumnConverter::ColumnHandler> tag_handlers_;
-    std::vector<MemoryBlock> blocks_;
-    moodycamel::BlockingConcurrentQueue<MemoryBlock*> free_queue_;
+    std::deque<MemoryBlock> blocks_;            // Grows in place; blocks never move
+
+    // Elastic sizing
+    size_t block_footprint_ = 0;
+    size_t base_blocks_ = 0;                    // Created up front and never trimmed
+    size_t max_blocks_ = 0;
+    std::atomic<size_t> block_count_{0};
+    std::atomic<size_t> resident_blocks_{0};
+    std::atomic<size_t> var_overflow_bytes_{0};
+    size_t memory_budget_ = 0;                  // memory_limit less cache units; 0 for no limit
+    std::mutex grow_mutex_;
+
+    // One free list per NUMA node; block i belongs to partition i % count and
+    // its chunk is first touched by a thread on that node
+    std::vector<std::unique_ptr<moodycamel::BlockingConcurrentQueue<MemoryBlock*>>> free_queues_;
+
+    struct alignas(64) BlockCache {
+        std::vector<MemoryBlock*> local;                // Owner thread only
+        std::atomic<MemoryBlock*> returned{nullptr};    // Pushed by consumers, taken whole
+        std::atomic<bool> attached{false};
+    };
+
+    // One cache per producer, at most one per initial block
+    std::unique_ptr<BlockCache[]> block_caches_;
+    size_t block_cache_slots_ = 0;
+    std::atomic<size_t> block_caches_used_{0};
+    std::atomic<size_t> attached_caches_{0};
 
     // Cache related members
     bool tables_reuse_data_ = false;
@@ -213,12 +378,29 @@ private:
     size_t common_meta_size_ = 0;
     size_t fixed_data_size_ = 0;
     size_t var_meta_size_ = 0;
-    size_t var_data_size_ = 0;
+    size_t var_data_size_ = 0;                  // Worst case: cap bytes per value
+    size_t var_arena_size_ = 0;                 // Block arena; 0 when blocks use fixed regions
     size_t total_cache_size_ = 0;
+    size_t block_data_size_ = 0;                // Column section of a normal block's chunk
 
     std::unique_ptr<TagsManager> tags_manager_;
 
     void init_cache_units();
-    void init_normal_blocks();
-    void init_cached_blocks();
+    void init_normal_block(MemoryBlock& block);
+    void init_cached_block(MemoryBlock& block, size_t block_idx);
+    void init_block(MemoryBlock& block, size_t block_idx);
+
+    // Run init on every block, from a thread bound to the block's node
+    void init_blocks(const std::function<void(MemoryBlock&, size_t)>& init);
+
+    MemoryBlock* take_free_block(size_t cache);
+    MemoryBlock* poll_free_block(size_t home, size_t cache);
+    MemoryBlock* grow_block(size_t partition);
+    bool trim_block(MemoryBlock* block);
+    bool within_memory_budget(size_t extra) const;
+    char* allocate_overflow(size_t size, PageBacking& backing);
+    void free_overflow(char* data, size_t size, PageBacking backing);
+    MemoryBlock* take_cached_block(size_t cache);
+    MemoryBlock* steal_returned_block(size_t cache);
+    void enqueue_free(MemoryBlock* block);
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+
+// Memory behind a pool chunk
+enum class PageBacking {
+    HEAP,               // aligned_alloc
+    TRANSPARENT,        // anonymous mapping with madvise(MADV_HUGEPAGE)
+    HUGE_2MB,           // hugetlbfs 2 MB pages (MAP_HUGETLB)
+    HUGE_1GB,           // hugetlbfs 1 GB pages (MAP_HUGETLB)
+};
+
+
+// Allocates zeroed pool chunks on the requested page size. hugetlbfs pages are
+// only used when rounding the chunk up to whole pages wastes at most an eighth
+// of the mapping, and THP only for chunks of at least 1 MB. When a backing does
+// not fit or is unavailable (no reserved hugetlbfs pages, no THP) the chunk
+// steps down to the next smaller backing, ending at the heap. Thread-safe.
+class PageAllocator {
+public:
+    // huge_pages: "off", "transparent", "2mb" or "1gb"
+    explicit PageAllocator(const std::string& huge_pages = "off");
+
+    PageAllocator(const PageAllocator&) = delete;
+    PageAllocator& operator=(const PageAllocator&) = delete;
+
+    // size bytes, 64-byte aligned, zero filled; throws std::bad_alloc
+    void* allocate(size_t size, PageBacking& backing);
+    static void deallocate(void* ptr, size_t size, PageBacking backing);
+
+    // Map every page of a chunk now rather than on first write
+    static void prefault(void* ptr, size_t size, PageBacking backing);
+
+    // Largest page size a chunk may get, for sizing chunks
+    size_t page_size() const;
+
+    // Whether a chunk of size bytes may be mapped on hugetlbfs pages of page
+    // bytes, given the rounding waste
+    static bool fits_huge_pages(size_t size, size_t page);
+
+    bool huge_pages_requested() const { return requested_ != PageBacking::HEAP; }
+
+    // Backings used so far with their chunk counts and hugetlbfs rounding, e.g.
+    // "2MB huge pages (12 chunks, 3.00 MB rounding), heap (3 chunks)"
+    std::string describe() const;
+
+    static const char* backing_name(PageBacking backing);
+
+private:
+    PageBacking requested_ = PageBacking::HEAP;
+    std::atomic<bool> huge_1gb_failed_{false};
+    std::atomic<bool> huge_2mb_failed_{false};
+    std::atomic<bool> transparent_failed_{false};
+    std::array<std::atomic<size_t>, 4> chunk_counts_{};
+    std::array<std::atomic<size_t>, 4> rounding_bytes_{};     // Mapped beyond the chunks
+};
@@ -12,11 +12,8 @@ namespace ColumnConverter {
     }
 
     size_t u16string_type_handler(const ColumnType& value, char* dest, size_t max_len) {
-        const auto& str = std::get<std::u16string>(value);
-        std::string utf8 = StringUtils::u16string_to_utf8(str);
-        size_t len = std::min(utf8.size(), max_len);
-        memcpy(dest, utf8.data(), len);
-        return len;
+        // Encoded in place, no intermediate UTF-8 string
+        return StringUtils::u16string_to_utf8(std::get<std::u16string>(value), dest, max_len);
     }
 
     size_t json_type_handler(const ColumnType& value, char* dest, size_t max_len) {
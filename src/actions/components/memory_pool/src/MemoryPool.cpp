@@ -1,16 +1,171 @@
 #include "MemoryPool.hpp"
+#include "CpuTopology.hpp"
+#include "LogUtils.hpp"
 #include <iostream>
 #include <cstring>
 #include <new>
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <exception>
+#include <thread>
 
 constexpr size_t MEMORY_POOL_ALIGNMENT = 64;
 
+// Initial guess of a variable-length value's size; blocks that need more
+// spill once and keep an overflow chunk for it
+constexpr size_t VAR_VALUE_ESTIMATE = 32;
+constexpr size_t VAR_OVERFLOW_MIN_SIZE = 64 * 1024;
+
 inline size_t align_up(size_t x, size_t align) {
     return ((x + align - 1) / align) * align;
 }
 
+// TableBase::Column
+size_t MemoryPool::TableBase::Column::var_room() const {
+    return var_arena ? var_arena->room(*this) : var_capacity - current_offset;
+}
+
+void MemoryPool::TableBase::Column::grow_var(size_t required) {
+    if (!var_arena) {
+        throw std::out_of_range("Variable-length data exceeds its column region");
+    }
+    var_arena->grow(*this, required);
+}
+
+// Convert a value to the end of a column's var data without advancing it.
+// When the worst case does not fit in place, the value goes through scratch
+// space so only its real length is reserved
+static size_t write_var_value(MemoryPool::TableBase::Column& col,
+                              const ColumnConverter::ColumnHandler& handler,
+                              const ColumnType& value) {
+    if (col.var_room() >= col.max_length) {
+        return handler.to_var(value, col.reserve_var(col.max_length), col.max_length);
+    }
+
+    thread_local std::vector<char> scratch;
+    scratch.resize(col.max_length);
+    const size_t data_len = handler.to_var(value, scratch.data(), col.max_length);
+    std::memcpy(col.reserve_var(data_len), scratch.data(), data_len);
+    return data_len;
+}
+
+// VarArena
+void MemoryPool::VarArena::init(MemoryPool* owner, char* data, size_t size, size_t max_value_size) {
+    pool = owner;
+    chunks.assign(1, Chunk{data, size, 0, PageBacking::HEAP});
+    current = 0;
+    tail = nullptr;
+    slack = max_value_size;
+}
+
+void MemoryPool::VarArena::reset() {
+    if (chunks.empty()) {
+        return;
+    }
+
+    // Spilled past the retained overflow chunk: replace the overflow chunks
+    // with one that holds all of it, plus room for the largest value. Over
+    // the memory limit the block keeps none
+    const bool spilled_over = current > 1 || (current == 1 && chunks.size() > 2);
+    if (spilled_over || (chunks.size() > 1 && !pool->within_memory_budget(0))) {
+        size_t spilled = 0;
+        for (size_t i = 1; i <= current; ++i) {
+            spilled += chunks[i].used;
+        }
+        release_overflow();
+        if (spilled_over && pool->within_memory_budget(spilled + slack)) {
+            add_overflow(spilled + slack);
+        }
+    }
+
+    for (auto& chunk : chunks) {
+        chunk.used = 0;
+    }
+    current = 0;
+    tail = nullptr;
+}
+
+size_t MemoryPool::VarArena::room(const TableBase::Column& col) const {
+    size_t room = col.var_capacity - col.current_offset;
+    if (tail == &col) {
+        room += chunks[current].size - chunks[current].used;
+    }
+    return room;
+}
+
+size_t MemoryPool::VarArena::capacity() const {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+void MemoryPool::VarArena::release_overflow() {
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        pool->free_overflow(chunks[i].data, chunks[i].size, chunks[i].backing);
+    }
+    if (!chunks.empty()) {
+        chunks.resize(1);
+    }
+}
+
+void MemoryPool::VarArena::add_overflow(size_t size) {
+    Chunk chunk{nullptr, size, 0, PageBacking::HEAP};
+    chunk.data = pool->allocate_overflow(size, chunk.backing);
+    chunks.push_back(chunk);
+}
+
+void MemoryPool::VarArena::trim_tail() {
+    if (!tail) {
+        return;
+    }
+
+    // Leave the last segment some headroom so row-by-row writers do not
+    // move it on every value
+    const size_t keep = std::min(tail->var_capacity, tail->current_offset + tail->current_offset / 2);
+    auto& chunk = chunks[current];
+    chunk.used = static_cast<size_t>(tail->var_data - chunk.data) + keep;
+    tail->var_capacity = keep;
+    tail = nullptr;
+}
+
+void MemoryPool::VarArena::grow(TableBase::Column& col, size_t required) {
+    const size_t target = std::max(required, col.var_capacity + col.var_capacity / 2);
+
+    // The last segment of the chunk extends in place
+    if (tail == &col) {
+        auto& chunk = chunks[current];
+        const size_t start = static_cast<size_t>(col.var_data - chunk.data);
+        if (start + required <= chunk.size) {
+            col.var_capacity = std::min(target, chunk.size - start);
+            chunk.used = start + col.var_capacity;
+            return;
+        }
+    }
+    trim_tail();
+
+    // A new segment in the current chunk, the next one large enough, or a
+    // fresh overflow chunk
+    while (chunks[current].used + required > chunks[current].size) {
+        if (++current == chunks.size()) {
+            add_overflow(std::max(target, VAR_OVERFLOW_MIN_SIZE));
+        }
+    }
+
+    auto& chunk = chunks[current];
+    const size_t capacity = std::min(target, chunk.size - chunk.used);
+    char* segment = chunk.data + chunk.used;
+    if (col.current_offset > 0) {
+        std::memcpy(segment, col.var_data, col.current_offset);
+    }
+    chunk.used += capacity;
+    col.var_data = segment;
+    col.var_capacity = capacity;
+    tail = &col;
+}
+
 // TableBase
 void MemoryPool::TableBase::fill_row(size_t row_index, const RowData& row) {
     if (row_index >= max_rows) {
@@ -22,13 +177,16 @@ void MemoryPool::TableBase::fill_row(size_t row_index, const RowData& row) {
         const auto& col_value = row.columns[col_idx];
         const auto& handler = (*col_handlers_ptr)[col_idx];
 
-        // Handle NULL value
-        // if (std::holds_alternative<std::monostate>(col_value)) {
-        //     col_block.is_nulls[used_rows] = 1;
-        //     continue;
-        // }
-
-        col.is_nulls[row_index] = 0;
+        // Handle NULL / NONE cells
+        const char flag = row.nulls.empty() ? CELL_VALUE : row.nulls[col_idx];
+        col.is_nulls[row_index] = flag;
+        if (flag != CELL_VALUE) {
+            if (!col.is_fixed) {
+                col.lengths[row_index] = 0;
+                col.var_offsets[row_index] = col.current_offset;
+            }
+            continue;
+        }
 
         if (col.is_fixed) {
             // Fixed-length column
@@ -36,8 +194,7 @@ void MemoryPool::TableBase::fill_row(size_t row_index, const RowData& row) {
             handler.to_fixed(col_value, dest, col.element_size);
         } else {
             // Variable-length column
-            char* dest = col.var_data + col.current_offset;
-            size_t data_len = handler.to_var(col_value, dest, col.max_length);
+            size_t data_len = write_var_value(col, handler, col_value);
 
             // Update metadata
             col.lengths[row_index] = static_cast<int32_t>(data_len);
@@ -65,14 +222,6 @@ void MemoryPool::CachedTableBlock::fill_cached_data_batch(const std::vector<RowD
 }
 
 // TableBlock::Tags
-MemoryPool::TableBlock::Tags::~Tags() {
-    if (data_chunk) {
-        std::free(data_chunk);
-        data_chunk = nullptr;
-        data_chunk_size = 0;
-    }
-}
-
 MemoryPool::TableBlock::Tags::Tags(Tags&& other) noexcept
     : table_name(std::move(other.table_name)),
       columns(std::move(other.columns)),
@@ -86,10 +235,6 @@ MemoryPool::TableBlock::Tags::Tags(Tags&& other) noexcept
 
 MemoryPool::TableBlock::Tags& MemoryPool::TableBlock::Tags::operator=(Tags&& other) noexcept {
     if (this != &other) {
-        if (data_chunk) {
-            std::free(data_chunk);
-        }
-
         table_name = std::move(other.table_name);
         columns = std::move(other.columns);
         data_chunk = other.data_chunk;
@@ -169,13 +314,10 @@ void MemoryPool::TableBlock::add_rows(const std::vector<RowData>& rows) {
             for (size_t i = 0; i < rows.size(); ++i) {
                 const auto& col_value = rows[i].columns[col_idx];
 
-                // Handle NULL value
-                // if (std::holds_alternative<std::monostate>(col_value)) {
-                //     col_block.is_nulls[start_index + i] = 1;
-                //     continue;
-                // }
-
-                col_block.is_nulls[start_index + i] = 0;
+                // Handle NULL / NONE cells
+                const char flag = rows[i].nulls.empty() ? CELL_VALUE : rows[i].nulls[col_idx];
+                col_block.is_nulls[start_index + i] = flag;
+                if (flag != CELL_VALUE) continue;
 
                 void* dest = static_cast<char*>(col_block.fixed_data)
                         + (start_index + i) * col_block.element_size;
@@ -185,22 +327,18 @@ void MemoryPool::TableBlock::add_rows(const std::vector<RowData>& rows) {
         } else {
             // Batch copy data
             for (size_t i = 0; i < rows.size(); ++i) {
-                if (col_block.is_nulls[start_index + i]) continue;
-
                 const auto& col_value = rows[i].columns[col_idx];
 
-                // if (std::holds_alternative<std::monostate>(col_value)) {
-                //     col_block.is_nulls[start_index + i] = 1;
-                //     continue;
-                // }
-
-                col_block.is_nulls[start_index + i] = 0;
-
-                char* dest = col_block.var_data + col_block.current_offset;
+                // Handle NULL / NONE cells
+                const char flag = rows[i].nulls.empty() ? CELL_VALUE : rows[i].nulls[col_idx];
+                col_block.is_nulls[start_index + i] = flag;
+                if (flag != CELL_VALUE) {
+                    col_block.lengths[start_index + i] = 0;
+                    col_block.var_offsets[start_index + i] = col_block.current_offset;
+                    continue;
+                }
 
-                size_t data_len = handler.to_var(
-                    col_value, dest, col_block.max_length
-                );
+                size_t data_len = write_var_value(col_block, handler, col_value);
 
                 // Update metadata
                 col_block.lengths[start_index + i] = static_cast<int32_t>(data_len);
@@ -231,7 +369,7 @@ ColumnType MemoryPool::TableBlock::get_cell_impl(size_t row_index, size_t col_in
     const auto& handler = handlers[col_index];
 
     if (col.is_nulls[row_index]) {
-        throw std::runtime_error("NULL value not supported");
+        throw std::runtime_error(std::string(context) + ": cell is NULL or NONE, check get_column_flag() first");
     }
 
     if (col.is_fixed) {
@@ -245,6 +383,13 @@ ColumnType MemoryPool::TableBlock::get_cell_impl(size_t row_index, size_t col_in
     }
 }
 
+char MemoryPool::TableBlock::get_column_flag(size_t row_index, size_t col_index) const {
+    if (row_index >= used_rows || col_index >= columns.size()) {
+        throw std::out_of_range("get_column_flag: index out of range");
+    }
+    return columns[col_index].is_nulls[row_index];
+}
+
 ColumnType MemoryPool::TableBlock::get_column_cell(size_t row_index, size_t col_index) const {
     return get_cell_impl(row_index, col_index, "get_column_cell", columns, *col_handlers_ptr);
 }
@@ -279,10 +424,13 @@ void MemoryPool::MemoryBlock::release() {
 
 void MemoryPool::MemoryBlock::free_data_chunk() {
     if (data_chunk) {
-        std::free(data_chunk);
+        PageAllocator::deallocate(data_chunk, data_chunk_size, data_backing);
         data_chunk = nullptr;
         data_chunk_size = 0;
     }
+    var_arena.release_overflow();
+    var_arena.chunks.clear();
+    var_arena.tail = nullptr;
 }
 
 void MemoryPool::MemoryBlock::init_bindv() {
@@ -357,9 +505,13 @@ void MemoryPool::MemoryBlock::build_bindv(bool is_checkpoint_recover) {
         // Update timestamp row count
         bind_lists_[i][0].num = table.used_rows;
 
-        // Update data column row count
+        // Update data column row count; var data may have moved while filling
         for (size_t col_idx = 0; col_idx < col_count; ++col_idx) {
-            bind_lists_[i][1 + col_idx].num = table.used_rows;
+            auto& bind = bind_lists_[i][1 + col_idx];
+            bind.num = table.used_rows;
+            if (!table.columns[col_idx].is_fixed) {
+                bind.buffer = table.columns[col_idx].var_data;
+            }
         }
 
         // Update tag column pointers
@@ -379,10 +531,15 @@ void MemoryPool::MemoryBlock::reset() {
     end_time = std::numeric_limits<int64_t>::min();
     used_tables = 0;
 
+    var_arena.reset();
     for (auto& table : tables) {
         table.used_rows = 0;
         for (auto& col : table.columns) {
             col.current_offset = 0;
+            if (col.var_arena) {
+                col.var_data = var_arena.chunks[0].data;
+                col.var_capacity = 0;
+            }
         }
     }
     bindv_.count = 0;
@@ -391,7 +548,7 @@ void MemoryPool::MemoryBlock::reset() {
 // CacheUnit
 MemoryPool::CacheUnit::~CacheUnit() {
     if (data_chunk) {
-        std::free(data_chunk);
+        PageAllocator::deallocate(data_chunk, data_chunk_size, data_backing);
         data_chunk = nullptr;
         data_chunk_size = 0;
     }
@@ -401,6 +558,7 @@ MemoryPool::CacheUnit::CacheUnit(CacheUnit&& other) noexcept
     : tables(std::move(other.tables)),
     data_chunk(other.data_chunk),
     data_chunk_size(other.data_chunk_size),
+    data_backing(other.data_backing),
     prefilled_count(other.prefilled_count.load())
 {
     other.data_chunk = nullptr;
@@ -411,12 +569,13 @@ MemoryPool::CacheUnit::CacheUnit(CacheUnit&& other) noexcept
 MemoryPool::CacheUnit& MemoryPool::CacheUnit::operator=(CacheUnit&& other) noexcept {
     if (this != &other) {
         if (data_chunk) {
-            std::free(data_chunk);
+            PageAllocator::deallocate(data_chunk, data_chunk_size, data_backing);
         }
 
         tables = std::move(other.tables);
         data_chunk = other.data_chunk;
         data_chunk_size = other.data_chunk_size;
+        data_backing = other.data_backing;
         prefilled_count = other.prefilled_count.load();
 
         other.data_chunk = nullptr;
@@ -427,9 +586,10 @@ MemoryPool::CacheUnit& MemoryPool::CacheUnit::operator=(CacheUnit&& other) noexc
 }
 
 // TagsManager
-MemoryPool::TagsManager::TagsManager(const ColumnConfigInstanceVector& tag_instances)
+MemoryPool::TagsManager::TagsManager(const ColumnConfigInstanceVector& tag_instances, PageAllocator& allocator)
     : tag_instances_(tag_instances),
-      tag_handlers_(ColumnConverter::create_handlers_for_columns(tag_instances))
+      tag_handlers_(ColumnConverter::create_handlers_for_columns(tag_instances)),
+      allocator_(allocator)
 {
     calculate_memory_size();
 }
@@ -457,52 +617,36 @@ void MemoryPool::TagsManager::calculate_memory_size() {
     total_size_ = align_up(total_size_, MEMORY_POOL_ALIGNMENT);
 }
 
-void MemoryPool::TagsManager::init_table_tags(TableBlock::Tags& tags,
-                                               const std::vector<ColumnType>& tag_values) {
-    // 分配内存块
-    tags.data_chunk = std::aligned_alloc(MEMORY_POOL_ALIGNMENT, total_size_);
-    tags.data_chunk_size = total_size_;
-
-    if (!tags.data_chunk) {
-        throw std::bad_alloc();
+MemoryPool::TagsManager::~TagsManager() {
+    for (auto& shard : shards_) {
+        for (const auto& slab : shard.slabs) {
+            PageAllocator::deallocate(slab.data, slab.size, slab.backing);
+        }
     }
+}
 
-    std::memset(tags.data_chunk, 0, tags.data_chunk_size);
-    char* current_ptr = static_cast<char*>(tags.data_chunk);
+void MemoryPool::TagsManager::layout_table_tags(TableBlock::Tags& tags, char* chunk) const {
+    tags.data_chunk = chunk;
+    tags.data_chunk_size = total_size_;
 
     // 分配各区域内存
-    void* fixed_data_base = current_ptr;
-    current_ptr += fixed_data_size_;
-
-    void* var_meta_base = current_ptr;
-    current_ptr += var_meta_size_;
-
-    char* var_data_base = current_ptr;
-    current_ptr += var_data_size_;
-
-    char* common_meta_base = current_ptr;
-    current_ptr += common_meta_size_;
+    char* fixed_ptr = chunk;
+    char* var_meta_ptr = fixed_ptr + fixed_data_size_;
+    char* var_data_ptr = var_meta_ptr + var_meta_size_;
+    char* common_meta_ptr = var_data_ptr + var_data_size_;
 
     // 初始化 tags 列
     tags.columns.resize(tag_instances_.size());
     tags.bind_tags.resize(tag_instances_.size());
 
-    char* fixed_ptr = static_cast<char*>(fixed_data_base);
-    char* var_meta_ptr = static_cast<char*>(var_meta_base);
-    char* var_data_ptr = var_data_base;
-    char* common_meta_ptr = common_meta_base;
-
     for (size_t tag_idx = 0; tag_idx < tag_instances_.size(); ++tag_idx) {
         auto& tag = tags.columns[tag_idx];
         auto& bind = tags.bind_tags[tag_idx];
         const auto& config = tag_instances_[tag_idx].config();
-        const auto& handler = tag_handlers_[tag_idx];
-        const auto& tag_value = tag_values[tag_idx];
 
         // 设置 is_nulls
         tag.is_nulls = common_meta_ptr;
         common_meta_ptr += sizeof(char);
-        tag.is_nulls[0] = 0;
 
         // 初始化 binding
         bind.buffer_type = config.get_taos_type();
@@ -521,13 +665,9 @@ void MemoryPool::TagsManager::init_table_tags(TableBlock::Tags& tags,
             var_meta_ptr += sizeof(size_t);
 
             tag.var_data = var_data_ptr;
+            tag.var_capacity = config.cap.value();
             var_data_ptr += config.cap.value();
 
-            // 写入数据
-            size_t data_len = handler.to_var(tag_value, tag.var_data, tag.max_length);
-            tag.lengths[0] = static_cast<int32_t>(data_len);
-            tag.var_offsets[0] = 0;
-
             // 设置 binding
             bind.buffer = tag.var_data;
             bind.length = tag.lengths;
@@ -538,45 +678,113 @@ void MemoryPool::TagsManager::init_table_tags(TableBlock::Tags& tags,
             tag.max_length = tag.element_size;
 
             tag.fixed_data = fixed_ptr;
-
-            // 写入数据
-            handler.to_fixed(tag_value, tag.fixed_data, tag.element_size);
+            fixed_ptr += tag.element_size;
 
             // 设置 binding
             bind.buffer = tag.fixed_data;
             bind.length = nullptr;
+        }
+    }
+}
 
-            fixed_ptr += tag.element_size;
+void MemoryPool::TagsManager::write_tag_values(TableBlock::Tags& tags,
+                                               const std::vector<ColumnType>& tag_values) const {
+    // Zeroed first so equal tuples give equal chunk bytes
+    std::memset(tags.data_chunk, 0, tags.data_chunk_size);
+
+    for (size_t tag_idx = 0; tag_idx < tag_instances_.size(); ++tag_idx) {
+        auto& tag = tags.columns[tag_idx];
+        const auto& handler = tag_handlers_[tag_idx];
+
+        tag.is_nulls[0] = 0;
+        if (tag.is_fixed) {
+            handler.to_fixed(tag_values[tag_idx], tag.fixed_data, tag.element_size);
+        } else {
+            size_t data_len = handler.to_var(tag_values[tag_idx], tag.var_data, tag.max_length);
+            tag.lengths[0] = static_cast<int32_t>(data_len);
+            tag.var_offsets[0] = 0;
         }
     }
 }
 
-MemoryPool::TableBlock::Tags* MemoryPool::TagsManager::register_tags(const std::string& table_name,
-                                             const std::vector<ColumnType>& tag_values) {
+char* MemoryPool::TagsManager::allocate_chunk(Shard& shard) const {
+    if (shard.slab_left < total_size_) {
+        // Slabs hold many chunks, so distinct tuples cost no allocation each;
+        // with huge pages a slab fills at least one 2 MB page
+        size_t slab_size = std::max<size_t>(total_size_ * 256, 64 * 1024);
+        if (allocator_.huge_pages_requested()) {
+            slab_size = std::max<size_t>(slab_size, 2 << 20);
+        }
+        PageBacking backing;
+        void* slab = allocator_.allocate(slab_size, backing);
+        shard.slabs.push_back({slab, slab_size, backing});
+        shard.slab_cursor = static_cast<char*>(slab);
+        shard.slab_left = slab_size;
+    }
+
+    char* chunk = shard.slab_cursor;
+    shard.slab_cursor += total_size_;
+    shard.slab_left -= total_size_;
+    return chunk;
+}
+
+MemoryPool::TableBlock::Tags* MemoryPool::TagsManager::intern_tags(const std::vector<ColumnType>& tag_values,
+                                                                   const std::string& table_name) {
     if (tag_values.size() != tag_instances_.size()) {
         return nullptr;
     }
 
-    std::lock_guard<std::mutex> lock(tags_map_mutex_);
+    // Encode into a per-thread scratch chunk; its bytes are the dedup key
+    thread_local std::vector<uint64_t> scratch;
+    thread_local TableBlock::Tags probe;
+    scratch.resize(total_size_ / sizeof(uint64_t) + 1);
+    layout_table_tags(probe, reinterpret_cast<char*>(scratch.data()));
+    write_tag_values(probe, tag_values);
 
-    if (tags_map_.find(table_name) != tags_map_.end()) {
-        return nullptr;
+    const std::string_view key(reinterpret_cast<const char*>(scratch.data()), total_size_);
+    Shard& shard = shards_[std::hash<std::string_view>{}(key) % SHARD_COUNT];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.by_value.find(key);
+    if (it != shard.by_value.end()) {
+        return it->second;
     }
 
-    auto tags = std::make_unique<TableBlock::Tags>();
-    auto ptr = tags.get();
-    tags->table_name = table_name;
+    char* chunk = allocate_chunk(shard);
+    std::memcpy(chunk, scratch.data(), total_size_);
 
-    init_table_tags(*tags, tag_values);
-    tags_map_[table_name] = std::move(tags);
+    auto& tags = shard.tags.emplace_back();
+    tags.table_name = table_name;
+    layout_table_tags(tags, chunk);
+    shard.by_value.emplace(std::string_view(chunk, total_size_), &tags);
+    return &tags;
+}
 
-    return ptr;
+MemoryPool::TableBlock::Tags* MemoryPool::TagsManager::register_tags(const std::string& table_name,
+                                             const std::vector<ColumnType>& tag_values) {
+    {
+        std::lock_guard<std::mutex> lock(tags_map_mutex_);
+        if (tags_map_.find(table_name) != tags_map_.end()) {
+            return nullptr;
+        }
+    }
+
+    auto* tags = intern_tags(tag_values, table_name);
+    if (!tags) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(tags_map_mutex_);
+    if (!tags_map_.emplace(table_name, tags).second) {
+        return nullptr;
+    }
+    return tags;
 }
 
 const MemoryPool::TableBlock::Tags* MemoryPool::TagsManager::get_tags(const std::string& table_name) const {
     std::lock_guard<std::mutex> lock(tags_map_mutex_);
     auto it = tags_map_.find(table_name);
-    return (it != tags_map_.end()) ? it->second.get() : nullptr;
+    return (it != tags_map_.end()) ? it->second : nullptr;
 }
 
 bool MemoryPool::TagsManager::has_tags(const std::string& table_name) const {
@@ -591,21 +799,22 @@ MemoryPool::MemoryPool(size_t num_blocks,
                        const ColumnConfigInstanceVector& col_instances,
                        const ColumnConfigInstanceVector& tag_instances,
                        bool tables_reuse_data,
-                       size_t num_cached_blocks
+                       size_t num_cached_blocks,
+                       const MemoryPoolOptions& options
                     )
-    : max_tables_per_block_(max_tables_per_block),
+    : page_allocator_(options.huge_pages),
+      prefault_(options.prefault),
+      max_tables_per_block_(max_tables_per_block),
       max_rows_per_table_(max_rows_per_table),
       col_instances_(col_instances),
       tag_instances_(tag_instances),
       col_handlers_(ColumnConverter::create_handlers_for_columns(col_instances)),
       tag_handlers_(ColumnConverter::create_handlers_for_columns(tag_instances)),
-      blocks_(num_blocks),
-      free_queue_(num_blocks),
       tables_reuse_data_(tables_reuse_data),
       num_cached_blocks_(num_cached_blocks)
 {
     if (!tag_instances_.empty()) {
-        tags_manager_ = std::make_unique<TagsManager>(tag_instances_);
+        tags_manager_ = std::make_unique<TagsManager>(tag_instances_, page_allocator_);
     }
 
     size_t max_rows_per_block = max_tables_per_block * max_rows_per_table;
@@ -622,6 +831,11 @@ MemoryPool::MemoryPool(size_t num_blocks,
     fixed_data_size_ = 0;
     var_meta_size_ = 0;
     var_data_size_ = 0;
+    var_arena_size_ = 0;
+
+    // Blocks with their own column data share one arena for variable-length
+    // values; cache units and reused tables keep cap bytes per value
+    const bool var_arena = !tables_reuse_data && num_cached_blocks == 0;
 
     for (const auto& col_instance : col_instances) {
         // is_nulls
@@ -629,8 +843,12 @@ MemoryPool::MemoryPool(size_t num_blocks,
 
         if (col_instance.config().is_var_length()) {
             // lengths + offsets
+            const size_t cap = col_instance.config().cap.value();
             var_meta_size_ += max_rows_per_block * (sizeof(int32_t) + sizeof(size_t));
-            var_data_size_ += max_rows_per_block * col_instance.config().cap.value();
+            var_data_size_ += max_rows_per_block * cap;
+            if (var_arena) {
+                var_arena_size_ += max_rows_per_block * std::min(cap, VAR_VALUE_ESTIMATE);
+            }
         } else {
             fixed_data_size_ += max_rows_per_block * col_instance.config().get_fixed_type_size();
         }
@@ -640,15 +858,60 @@ MemoryPool::MemoryPool(size_t num_blocks,
     total_cache_size_ = common_meta_size_ + fixed_data_size_ + var_meta_size_ + var_data_size_;
     total_cache_size_ = align_up(total_cache_size_, MEMORY_POOL_ALIGNMENT);
 
+    block_data_size_ = common_meta_size_ + fixed_data_size_ + var_meta_size_ + (var_arena ? var_arena_size_ : var_data_size_);
+    block_data_size_ = align_up(block_data_size_, MEMORY_POOL_ALIGNMENT);
+
+    // Per block: the data chunk (timestamps only when the data sits in cache
+    // units) plus table, column and binding metadata. Var arena overflow is
+    // allocated on demand and charged against the limit as it is held
+    const size_t chunk_size = num_cached_blocks_ > 0
+        ? timestamps_size_
+        : align_up(timestamps_size_ + block_data_size_, MEMORY_POOL_ALIGNMENT);
+    const size_t table_meta_size = sizeof(TableBlock) + sizeof(CheckpointData)
+        + col_instances.size() * sizeof(TableBase::Column)
+        + (1 + col_instances.size()) * sizeof(TAOS_STMT2_BIND)
+        + sizeof(std::vector<TAOS_STMT2_BIND>) + 3 * sizeof(void*);
+    block_footprint_ = sizeof(MemoryBlock) + chunk_size + max_tables_per_block * table_meta_size;
+
+    base_blocks_ = max_blocks_ = num_blocks;
+    if (options.memory_limit > 0) {
+        // Cache units are shared by all blocks and come off the top
+        const size_t shared_size = num_cached_blocks_ * total_cache_size_;
+        if (options.memory_limit < shared_size + block_footprint_) {
+            throw std::runtime_error(
+                "memory_limit of " + std::to_string(options.memory_limit) +
+                " bytes cannot hold one memory pool block of " + std::to_string(block_footprint_) +
+                " bytes" + (shared_size ? " plus " + std::to_string(shared_size) + " bytes of cache units" : "")
+            );
+        }
+        memory_budget_ = options.memory_limit - shared_size;
+        max_blocks_ = memory_budget_ / block_footprint_;
+        base_blocks_ = std::min(num_blocks, max_blocks_);
+    }
+    blocks_.resize(base_blocks_);
+    block_count_.store(base_blocks_, std::memory_order_relaxed);
+
+    // Every partition needs at least one block. Queues start sized for the
+    // initial blocks and allocate more as the pool grows
+    const size_t partitions = std::max<size_t>(1, std::min(options.partitions, base_blocks_));
+    for (size_t i = 0; i < partitions; ++i) {
+        free_queues_.push_back(std::make_unique<moodycamel::BlockingConcurrentQueue<MemoryBlock*>>(base_blocks_));
+    }
+
     if (num_cached_blocks_ > 0) {
         init_cache_units();
-        init_cached_blocks();
-    } else {
-        init_normal_blocks();
     }
+    init_blocks([this](MemoryBlock& block, size_t block_idx) { init_block(block, block_idx); });
 
     for (auto& block : blocks_) {
-        free_queue_.enqueue(&block);
+        free_queues_[block.partition]->enqueue(&block);
+    }
+
+    block_cache_slots_ = options.producers > 0 ? std::min(options.producers, base_blocks_) : base_blocks_;
+    block_caches_.reset(new BlockCache[block_cache_slots_]);
+
+    if (page_allocator_.huge_pages_requested() || prefault_) {
+        LogUtils::info("Memory pool chunks backed by {}{}", page_allocator_.describe(), prefault_ ? ", prefaulted" : "");
     }
 }
 
@@ -665,15 +928,12 @@ void MemoryPool::init_cache_units() {
     for (size_t cache_idx = 0; cache_idx < num_cached_blocks_; ++cache_idx) {
         auto& cache_unit = cache_units_[cache_idx];
 
-        cache_unit.data_chunk = std::aligned_alloc(MEMORY_POOL_ALIGNMENT, total_cache_size_);
+        // Zero filled by the allocator
+        cache_unit.data_chunk = page_allocator_.allocate(total_cache_size_, cache_unit.data_backing);
         cache_unit.data_chunk_size = total_cache_size_;
-
-        if (!cache_unit.data_chunk) {
-            throw std::bad_alloc();
+        if (prefault_) {
+            PageAllocator::prefault(cache_unit.data_chunk, cache_unit.data_chunk_size, cache_unit.data_backing);
         }
-
-        // Initialize memory to zero
-        std::memset(cache_unit.data_chunk, 0, cache_unit.data_chunk_size);
         char* current_ptr = static_cast<char*>(cache_unit.data_chunk);
 
         // Allocate memory for fixed-length column data
@@ -736,6 +996,7 @@ void MemoryPool::init_cache_units() {
                     // var_data data area
                     const size_t col_data_size = max_rows_per_table_ * config.cap.value();
                     col.var_data = var_data_ptr;
+                    col.var_capacity = col_data_size;
                     var_data_ptr += col_data_size;
                 } else {
                     col.is_fixed = true;
@@ -759,163 +1020,441 @@ void MemoryPool::init_cache_units() {
     }
 }
 
-void MemoryPool::init_normal_blocks() {
-    size_t total_block_size = timestamps_size_ + total_cache_size_;
-    total_block_size = align_up(total_block_size, MEMORY_POOL_ALIGNMENT);
-
-    for (auto& block : blocks_) {
-        block.owning_pool = this;
+void MemoryPool::init_blocks(const std::function<void(MemoryBlock&, size_t)>& init) {
+    const size_t partitions = free_queues_.size();
+    for (size_t block_idx = 0; block_idx < blocks_.size(); ++block_idx) {
+        blocks_[block_idx].partition = block_idx % partitions;
+    }
 
-        // Allocate a single large memory block
-        block.data_chunk = std::aligned_alloc(MEMORY_POOL_ALIGNMENT, total_block_size);
-        block.data_chunk_size = total_block_size;
+    // Prefaulting spreads the blocks of each partition over several threads
+    size_t workers_per_partition = 1;
+    if (prefault_) {
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        workers_per_partition = std::max<size_t>(1, cores / partitions);
+    }
+    const size_t workers = std::min(partitions * workers_per_partition, blocks_.size());
 
-        if (!block.data_chunk) {
-            throw std::bad_alloc();
+    if (workers <= 1) {
+        for (size_t block_idx = 0; block_idx < blocks_.size(); ++block_idx) {
+            init(blocks_[block_idx], block_idx);
         }
+        return;
+    }
 
-        // Initialize memory to zero
-        std::memset(block.data_chunk, 0, total_block_size);
-        char* current_ptr = static_cast<char*>(block.data_chunk);
+    // First touch places each chunk on the node of the thread writing it.
+    // Worker w serves partition w % partitions and every workers-th block
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(workers);
+    for (size_t worker = 0; worker < workers; ++worker) {
+        threads.emplace_back([this, &init, &errors, worker, workers, partitions] {
+            try {
+                if (partitions > 1) {
+                    CpuTopology::instance().bind_to_node(worker % partitions);
+                }
+                for (size_t block_idx = worker; block_idx < blocks_.size(); block_idx += workers) {
+                    init(blocks_[block_idx], block_idx);
+                }
+            } catch (...) {
+                errors[worker] = std::current_exception();
+            }
+        });
+    }
 
-        // Allocate memory for timestamps
-        int64_t* timestamps_base = reinterpret_cast<int64_t*>(current_ptr);
-        current_ptr += timestamps_size_;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
 
-        // Allocate memory for fixed-length column data
-        void* fixed_data_base = current_ptr;
-        current_ptr += fixed_data_size_;
+void MemoryPool::init_block(MemoryBlock& block, size_t block_idx) {
+    if (num_cached_blocks_ > 0) {
+        init_cached_block(block, block_idx);
+    } else {
+        init_normal_block(block);
+    }
+    block.resident = true;
+    resident_blocks_.fetch_add(1, std::memory_order_relaxed);
+}
 
-        // Allocate memory for variable-length column metadata
-        void* var_meta_base = current_ptr;
-        current_ptr += var_meta_size_;
+void MemoryPool::init_normal_block(MemoryBlock& block) {
+    size_t total_block_size = timestamps_size_ + block_data_size_;
+    total_block_size = align_up(total_block_size, MEMORY_POOL_ALIGNMENT);
 
-        // Allocate memory for variable-length column data
-        char* var_data_base = current_ptr;
-        current_ptr += var_data_size_;
+    block.owning_pool = this;
 
-        // Allocate memory for common metadata
-        char* common_meta_base = current_ptr;
-        current_ptr += common_meta_size_;
+    // Allocate a single large memory block, zero filled by the allocator
+    block.data_chunk = page_allocator_.allocate(total_block_size, block.data_backing);
+    block.data_chunk_size = total_block_size;
+    if (prefault_) {
+        PageAllocator::prefault(block.data_chunk, block.data_chunk_size, block.data_backing);
+    }
+    char* current_ptr = static_cast<char*>(block.data_chunk);
 
-        // Initialize table structure
-        block.tables.resize(max_tables_per_block_);
-
-        // Initialize table metadata
-        for (size_t i = 0; i < max_tables_per_block_; ++i) {
-            auto& table = block.tables[i];
-            table.max_rows = max_rows_per_table_;
-            table.col_handlers_ptr = &col_handlers_;
-            table.tag_handlers_ptr = &tag_handlers_;
-            table.columns.resize(col_instances_.size());
-
-            // Set timestamp pointer
-            table.timestamps = timestamps_base + i * max_rows_per_table_;
+    // Allocate memory for timestamps
+    int64_t* timestamps_base = reinterpret_cast<int64_t*>(current_ptr);
+    current_ptr += timestamps_size_;
+
+    // Allocate memory for fixed-length column data
+    void* fixed_data_base = current_ptr;
+    current_ptr += fixed_data_size_;
+
+    // Allocate memory for variable-length column metadata
+    void* var_meta_base = current_ptr;
+    current_ptr += var_meta_size_;
+
+    // Allocate memory for variable-length column data
+    char* var_data_base = current_ptr;
+    current_ptr += var_arena_size_ > 0 ? var_arena_size_ : var_data_size_;
+
+    // Allocate memory for common metadata
+    char* common_meta_base = current_ptr;
+    current_ptr += common_meta_size_;
+
+    if (var_arena_size_ > 0) {
+        size_t max_value_size = 0;
+        for (const auto& col_instance : col_instances_) {
+            if (col_instance.config().is_var_length()) {
+                max_value_size = std::max(max_value_size, static_cast<size_t>(col_instance.config().cap.value()));
+            }
         }
+        block.var_arena.init(this, var_data_base, var_arena_size_, max_value_size);
+    }
 
-        // Set column pointers
-        char* fixed_col_ptr = static_cast<char*>(fixed_data_base);
-        char* var_meta_ptr = static_cast<char*>(var_meta_base);
-        char* var_data_ptr = var_data_base;
-        char* common_meta_ptr = common_meta_base;
+    // Initialize table structure
+    block.tables.resize(max_tables_per_block_);
 
-        const size_t is_nulls_size = max_rows_per_table_ * sizeof(char);
-        const size_t lengths_size = max_rows_per_table_ * sizeof(int32_t);
-        const size_t offsets_size = max_rows_per_table_ * sizeof(size_t);
+    // Initialize table metadata
+    for (size_t i = 0; i < max_tables_per_block_; ++i) {
+        auto& table = block.tables[i];
+        table.max_rows = max_rows_per_table_;
+        table.col_handlers_ptr = &col_handlers_;
+        table.tag_handlers_ptr = &tag_handlers_;
+        table.columns.resize(col_instances_.size());
 
-        for (size_t table_idx = 0; table_idx < max_tables_per_block_; ++table_idx) {
-            for (size_t col_idx = 0; col_idx < col_instances_.size(); ++col_idx) {
-                auto& col = block.tables[table_idx].columns[col_idx];
-                const auto& config = col_instances_[col_idx].config();
+        // Set timestamp pointer
+        table.timestamps = timestamps_base + i * max_rows_per_table_;
+    }
 
-                col.is_nulls = common_meta_ptr;
-                common_meta_ptr += is_nulls_size;
+    // Set column pointers
+    char* fixed_col_ptr = static_cast<char*>(fixed_data_base);
+    char* var_meta_ptr = static_cast<char*>(var_meta_base);
+    char* var_data_ptr = var_data_base;
+    char* common_meta_ptr = common_meta_base;
 
-                if (config.is_var_length()) {
-                    col.is_fixed = false;
-                    col.max_length = config.cap.value();
-                    col.element_size = 0;
+    const size_t is_nulls_size = max_rows_per_table_ * sizeof(char);
+    const size_t lengths_size = max_rows_per_table_ * sizeof(int32_t);
+    const size_t offsets_size = max_rows_per_table_ * sizeof(size_t);
 
-                    // lengths array
-                    col.lengths = reinterpret_cast<int32_t*>(var_meta_ptr);
-                    var_meta_ptr += lengths_size;
+    for (size_t table_idx = 0; table_idx < max_tables_per_block_; ++table_idx) {
+        for (size_t col_idx = 0; col_idx < col_instances_.size(); ++col_idx) {
+            auto& col = block.tables[table_idx].columns[col_idx];
+            const auto& config = col_instances_[col_idx].config();
 
-                    // offsets array
-                    col.var_offsets = reinterpret_cast<size_t*>(var_meta_ptr);
-                    var_meta_ptr += offsets_size;
+            col.is_nulls = common_meta_ptr;
+            common_meta_ptr += is_nulls_size;
 
-                    // var_data data area
+            if (config.is_var_length()) {
+                col.is_fixed = false;
+                col.max_length = config.cap.value();
+                col.element_size = 0;
+
+                // lengths array
+                col.lengths = reinterpret_cast<int32_t*>(var_meta_ptr);
+                var_meta_ptr += lengths_size;
+
+                // offsets array
+                col.var_offsets = reinterpret_cast<size_t*>(var_meta_ptr);
+                var_meta_ptr += offsets_size;
+
+                // var_data data area: a segment of the block arena, taken on
+                // first write, or a fixed region of cap bytes per row
+                if (var_arena_size_ > 0) {
+                    col.var_arena = &block.var_arena;
+                    col.var_data = var_data_base;
+                    col.var_capacity = 0;
+                } else {
                     const size_t col_data_size = max_rows_per_table_ * config.cap.value();
                     col.var_data = var_data_ptr;
+                    col.var_capacity = col_data_size;
                     var_data_ptr += col_data_size;
-                } else {
-                    col.is_fixed = true;
-                    col.element_size = config.get_fixed_type_size();
-                    col.max_length = col.element_size;
-
-                    // fixed_data data area
-                    const size_t col_data_size = max_rows_per_table_ * col.element_size;
-                    col.fixed_data = fixed_col_ptr;
-                    fixed_col_ptr += col_data_size;
                 }
+            } else {
+                col.is_fixed = true;
+                col.element_size = config.get_fixed_type_size();
+                col.max_length = col.element_size;
+
+                // fixed_data data area
+                const size_t col_data_size = max_rows_per_table_ * col.element_size;
+                col.fixed_data = fixed_col_ptr;
+                fixed_col_ptr += col_data_size;
             }
+        }
 
-            if (tables_reuse_data_) {
-                fixed_col_ptr = static_cast<char*>(fixed_data_base);
-                var_meta_ptr = static_cast<char*>(var_meta_base);
-                var_data_ptr = var_data_base;
-                common_meta_ptr = common_meta_base;
+        if (tables_reuse_data_) {
+            fixed_col_ptr = static_cast<char*>(fixed_data_base);
+            var_meta_ptr = static_cast<char*>(var_meta_base);
+            var_data_ptr = var_data_base;
+            common_meta_ptr = common_meta_base;
+        }
+    }
+
+    // Initialize bindv structure
+    block.init_bindv();
+
+    // reset block state
+    block.reset();
+}
+
+void MemoryPool::init_cached_block(MemoryBlock& block, size_t block_idx) {
+    block.owning_pool = this;
+
+    // Zero filled by the allocator
+    block.data_chunk = page_allocator_.allocate(timestamps_size_, block.data_backing);
+    block.data_chunk_size = timestamps_size_;
+    if (prefault_) {
+        PageAllocator::prefault(block.data_chunk, block.data_chunk_size, block.data_backing);
+    }
+
+    block.cache_index = block_idx % num_cached_blocks_;
+
+    // Initialize table structure
+    block.tables.resize(max_tables_per_block_);
+
+    // Initialize table metadata
+    int64_t* timestamps_base = reinterpret_cast<int64_t*>(block.data_chunk);
+    for (size_t i = 0; i < max_tables_per_block_; ++i) {
+        auto& table = block.tables[i];
+        table.max_rows = max_rows_per_table_;
+        table.col_handlers_ptr = &col_handlers_;
+        table.tag_handlers_ptr = &tag_handlers_;
+
+        // Set timestamp pointer
+        table.timestamps = timestamps_base + i * max_rows_per_table_;
+    }
+
+    // reset block state
+    block.reset();
+}
+
+size_t MemoryPool::attach_block_cache() {
+    const size_t cache = block_caches_used_.fetch_add(1, std::memory_order_relaxed);
+    if (cache >= block_cache_slots_) {
+        return NO_BLOCK_CACHE;
+    }
+    block_caches_[cache].attached.store(true, std::memory_order_release);
+    attached_caches_.fetch_add(1, std::memory_order_relaxed);
+    return cache;
+}
+
+void MemoryPool::detach_block_cache(size_t cache) {
+    if (cache >= block_cache_slots_) {
+        return;
+    }
+
+    // Later releases go to the shared free lists, then flush what was cached
+    auto& entry = block_caches_[cache];
+    if (!entry.attached.exchange(false, std::memory_order_seq_cst)) {
+        return;
+    }
+    attached_caches_.fetch_sub(1, std::memory_order_relaxed);
+
+    for (auto* block : entry.local) {
+        enqueue_free(block);
+    }
+    entry.local.clear();
+
+    // Pairs with the re-check in release_block: a push this exchange misses
+    // sees attached == false and drains itself
+    MemoryBlock* head = entry.returned.exchange(nullptr, std::memory_order_seq_cst);
+    while (head) {
+        MemoryBlock* next = head->next_returned;
+        enqueue_free(head);
+        head = next;
+    }
+}
+
+void MemoryPool::enqueue_free(MemoryBlock* block) {
+    block->owner_cache = NO_BLOCK_CACHE;
+    block->next_returned = nullptr;
+    free_queues_[block->partition]->enqueue(block);
+}
+
+MemoryPool::MemoryBlock* MemoryPool::take_cached_block(size_t cache) {
+    auto& entry = block_caches_[cache];
+
+    // Move the blocks consumers returned into the local cache; keep only a
+    // fair share so the other producers are not starved
+    if (entry.local.empty()) {
+        const size_t attached = std::max<size_t>(1, attached_caches_.load(std::memory_order_relaxed));
+        const size_t capacity = std::max<size_t>(1, block_count() / (2 * attached));
+
+        MemoryBlock* head = entry.returned.exchange(nullptr, std::memory_order_acquire);
+        while (head) {
+            MemoryBlock* next = head->next_returned;
+            if (entry.local.size() < capacity) {
+                entry.local.push_back(head);
+            } else {
+                enqueue_free(head);
             }
+            head = next;
         }
+    }
+
+    if (entry.local.empty()) {
+        return nullptr;
+    }
+    MemoryBlock* block = entry.local.back();
+    entry.local.pop_back();
+    return block;
+}
+
+MemoryPool::MemoryBlock* MemoryPool::steal_returned_block(size_t cache) {
+    const size_t used = std::min(block_caches_used_.load(std::memory_order_relaxed), block_cache_slots_);
+    for (size_t i = 0; i < used; ++i) {
+        if (i == cache) continue;
 
-        // Initialize bindv structure
-        block.init_bindv();
+        // Take the whole stack, keep one block and share the rest
+        MemoryBlock* head = block_caches_[i].returned.exchange(nullptr, std::memory_order_acquire);
+        if (!head) continue;
 
-        // reset block state
-        block.reset();
+        MemoryBlock* next = head->next_returned;
+        while (next) {
+            MemoryBlock* after = next->next_returned;
+            enqueue_free(next);
+            next = after;
+        }
+        return head;
     }
+    return nullptr;
 }
 
-void MemoryPool::init_cached_blocks() {
-    for (size_t block_idx = 0; block_idx < blocks_.size(); ++block_idx) {
-        auto& block = blocks_[block_idx];
-        block.owning_pool = this;
+MemoryPool::MemoryBlock* MemoryPool::poll_free_block(size_t home, size_t cache) {
+    MemoryBlock* block = nullptr;
+
+    // Consumers may have returned the caller's blocks since it last looked
+    if (cache != NO_BLOCK_CACHE && (block = take_cached_block(cache))) {
+        return block;
+    }
+
+    const size_t partitions = free_queues_.size();
+    for (size_t i = 0; i < partitions; ++i) {
+        if (free_queues_[(home + i) % partitions]->try_dequeue(block)) {
+            return block;
+        }
+    }
+    if (block_caches_used_.load(std::memory_order_relaxed) > 0) {
+        return steal_returned_block(cache);
+    }
+    return nullptr;
+}
 
-        block.data_chunk = std::aligned_alloc(MEMORY_POOL_ALIGNMENT, timestamps_size_);
-        block.data_chunk_size = timestamps_size_;
+MemoryPool::MemoryBlock* MemoryPool::grow_block(size_t partition) {
+    std::lock_guard<std::mutex> lock(grow_mutex_);
+    const size_t block_idx = block_count_.load(std::memory_order_relaxed);
+    if (block_idx >= max_blocks_ || !within_memory_budget(block_footprint_)) {
+        return nullptr;
+    }
+
+    // Initialized by the thread about to fill it, so first touch is local
+    auto& block = blocks_.emplace_back();
+    block.partition = partition;
+    init_block(block, block_idx);
+    block_count_.store(block_idx + 1, std::memory_order_relaxed);
+    return &block;
+}
 
-        if (!block.data_chunk) {
-            throw std::bad_alloc();
+bool MemoryPool::trim_block(MemoryBlock* block) {
+    // Only blocks grown past the initial count are trimmed, and only while at
+    // least half of the resident blocks sit in the free lists or var overflow
+    // has pushed the pool past its memory limit
+    size_t resident = resident_blocks_.load(std::memory_order_relaxed);
+    while (resident > base_blocks_) {
+        size_t idle = 0;
+        for (const auto& queue : free_queues_) {
+            idle += queue->size_approx();
+        }
+        if (idle * 2 < resident && within_memory_budget(0)) {
+            return false;
+        }
+        if (resident_blocks_.compare_exchange_weak(resident, resident - 1, std::memory_order_relaxed)) {
+            block->free_data_chunk();
+            block->resident = false;
+            return true;
         }
+    }
+    return false;
+}
 
-        // Initialize memory to zero
-        std::memset(block.data_chunk, 0, block.data_chunk_size);
+bool MemoryPool::within_memory_budget(size_t extra) const {
+    if (memory_budget_ == 0) {
+        return true;
+    }
+    const size_t used = resident_blocks_.load(std::memory_order_relaxed) * block_footprint_
+        + var_overflow_bytes_.load(std::memory_order_relaxed);
+    return used + extra <= memory_budget_;
+}
 
-        block.cache_index = block_idx % num_cached_blocks_;
+char* MemoryPool::allocate_overflow(size_t size, PageBacking& backing) {
+    char* data = static_cast<char*>(page_allocator_.allocate(size, backing));
+    if (prefault_) {
+        PageAllocator::prefault(data, size, backing);
+    }
+    var_overflow_bytes_.fetch_add(size, std::memory_order_relaxed);
+    return data;
+}
 
-        // Initialize table structure
-        block.tables.resize(max_tables_per_block_);
-
-        // Initialize table metadata
-        int64_t* timestamps_base = reinterpret_cast<int64_t*>(block.data_chunk);
-        for (size_t i = 0; i < max_tables_per_block_; ++i) {
-            auto& table = block.tables[i];
-            table.max_rows = max_rows_per_table_;
-            table.col_handlers_ptr = &col_handlers_;
-            table.tag_handlers_ptr = &tag_handlers_;
-
-            // Set timestamp pointer
-            table.timestamps = timestamps_base + i * max_rows_per_table_;
+void MemoryPool::free_overflow(char* data, size_t size, PageBacking backing) {
+    PageAllocator::deallocate(data, size, backing);
+    var_overflow_bytes_.fetch_sub(size, std::memory_order_relaxed);
+}
+
+MemoryPool::MemoryBlock* MemoryPool::take_free_block(size_t cache) {
+    MemoryBlock* block = nullptr;
+    const size_t partitions = free_queues_.size();
+    const size_t home = partitions > 1 ? CpuTopology::instance().current_node() % partitions : 0;
+
+    // Below the memory limit the pool grows instead of waiting
+    if (block_count() < max_blocks_) {
+        if ((block = poll_free_block(home, cache)) || (block = grow_block(home))) {
+            return block;
         }
+    }
 
-        // reset block state
-        block.reset();
+    const bool stealing = block_caches_used_.load(std::memory_order_relaxed) > 0;
+    if (partitions == 1 && !stealing) {
+        free_queues_[0]->wait_dequeue(block);
+        return block;
+    }
+
+    // Wait briefly for a local block, then borrow one from another node or
+    // from another producer's cache; it still returns to its own partition
+    while (true) {
+        if (free_queues_[home]->wait_dequeue_timed(block, 200)) {
+            return block;
+        }
+        if ((block = poll_free_block(home, cache))) {
+            return block;
+        }
     }
 }
 
-MemoryPool::MemoryBlock* MemoryPool::acquire_block(size_t sequence_num) {
+MemoryPool::MemoryBlock* MemoryPool::acquire_block(size_t sequence_num, size_t cache) {
+    if (cache >= block_cache_slots_) {
+        cache = NO_BLOCK_CACHE;
+    }
+
     MemoryBlock* block = nullptr;
-    free_queue_.wait_dequeue(block);
+    if (cache != NO_BLOCK_CACHE) {
+        block = take_cached_block(cache);
+    }
+    if (!block) {
+        block = take_free_block(cache);
+    }
+    if (block && !block->resident) {
+        init_block(*block, block->cache_index);
+    }
 
     if (block) {
         if (is_cache_mode()) {
@@ -934,6 +1473,8 @@ MemoryPool::MemoryBlock* MemoryPool::acquire_block(size_t sequence_num) {
         }
 
         block->in_use = true;
+        block->owner_cache = cache;
+        block->next_returned = nullptr;
         block->reset();
     }
 
@@ -943,7 +1484,35 @@ MemoryPool::MemoryBlock* MemoryPool::acquire_block(size_t sequence_num) {
 void MemoryPool::release_block(MemoryBlock* block) {
     if (block) {
         block->in_use = false;
-        free_queue_.enqueue(block);
+
+        // Back onto the owning producer's stack; only pushes happen here and
+        // the owner takes the whole stack at once, so there is no ABA
+        if (trim_block(block)) {
+            enqueue_free(block);
+            return;
+        }
+
+        const size_t owner = block->owner_cache;
+        if (owner != NO_BLOCK_CACHE && block_caches_[owner].attached.load(std::memory_order_acquire)) {
+            auto& entry = block_caches_[owner];
+            block->next_returned = entry.returned.load(std::memory_order_relaxed);
+            while (!entry.returned.compare_exchange_weak(block->next_returned, block,
+                                                         std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            }
+
+            // The owner may have detached and drained between the check and
+            // the push; then nobody takes this stack, so drain it here
+            if (!entry.attached.load(std::memory_order_seq_cst)) {
+                MemoryBlock* head = entry.returned.exchange(nullptr, std::memory_order_seq_cst);
+                while (head) {
+                    MemoryBlock* next = head->next_returned;
+                    enqueue_free(head);
+                    head = next;
+                }
+            }
+            return;
+        }
+        enqueue_free(block);
     }
 }
 
@@ -1048,6 +1617,14 @@ MemoryPool::TableBlock::Tags* MemoryPool::register_table_tags(const std::string&
     return tags_manager_->register_tags(table_name, tag_values);
 }
 
+const MemoryPool::TableBlock::Tags* MemoryPool::intern_table_tags(const std::vector<ColumnType>& tag_values,
+                                                                  const std::string& table_name) {
+    if (!tags_manager_) {
+        return nullptr;
+    }
+    return tags_manager_->intern_tags(tag_values, table_name);
+}
+
 const MemoryPool::TableBlock::Tags* MemoryPool::get_table_tags(const std::string& table_name) const {
     if (!tags_manager_) {
         return nullptr;
@@ -0,0 +1,182 @@
+#include "PageAllocator.hpp"
+#include "StringUtils.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#endif
+
+
+static constexpr size_t HEAP_ALIGNMENT = 64;
+static constexpr size_t SIZE_2MB = size_t(2) << 20;
+static constexpr size_t SIZE_1GB = size_t(1) << 30;
+
+// hugetlbfs mappings may waste at most 1/MAX_ROUNDING_SHARE of their size
+static constexpr size_t MAX_ROUNDING_SHARE = 8;
+
+static size_t round_up(size_t size, size_t unit) {
+    return (size + unit - 1) / unit * unit;
+}
+
+static size_t backing_page_size(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::HUGE_1GB: return SIZE_1GB;
+        case PageBacking::HUGE_2MB: return SIZE_2MB;
+#if defined(__linux__)
+        case PageBacking::TRANSPARENT: return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        default: return HEAP_ALIGNMENT;
+    }
+}
+
+#if defined(__linux__)
+static void* map_anonymous(size_t size, int flags) {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+#endif
+
+PageAllocator::PageAllocator(const std::string& huge_pages) {
+    if (huge_pages == "off") {
+        requested_ = PageBacking::HEAP;
+    } else if (huge_pages == "transparent") {
+        requested_ = PageBacking::TRANSPARENT;
+    } else if (huge_pages == "2mb") {
+        requested_ = PageBacking::HUGE_2MB;
+    } else if (huge_pages == "1gb") {
+        requested_ = PageBacking::HUGE_1GB;
+    } else {
+        throw std::invalid_argument("Invalid huge_pages value: " + huge_pages + " (expected off, transparent, 2mb or 1gb)");
+    }
+}
+
+void* PageAllocator::allocate(size_t size, PageBacking& backing) {
+    void* ptr = nullptr;
+
+#if defined(__linux__)
+    if (requested_ == PageBacking::HUGE_1GB && fits_huge_pages(size, SIZE_1GB) && !huge_1gb_failed_.load(std::memory_order_relaxed)) {
+        ptr = map_anonymous(round_up(size, SIZE_1GB), MAP_HUGETLB | (30 << MAP_HUGE_SHIFT));
+        if (ptr) {
+            backing = PageBacking::HUGE_1GB;
+            rounding_bytes_[static_cast<size_t>(backing)].fetch_add(round_up(size, SIZE_1GB) - size, std::memory_order_relaxed);
+        } else {
+            huge_1gb_failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    if (!ptr && requested_ >= PageBacking::HUGE_2MB && fits_huge_pages(size, SIZE_2MB) && !huge_2mb_failed_.load(std::memory_order_relaxed)) {
+        ptr = map_anonymous(round_up(size, SIZE_2MB), MAP_HUGETLB | (21 << MAP_HUGE_SHIFT));
+        if (ptr) {
+            backing = PageBacking::HUGE_2MB;
+            rounding_bytes_[static_cast<size_t>(backing)].fetch_add(round_up(size, SIZE_2MB) - size, std::memory_order_relaxed);
+        } else {
+            huge_2mb_failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // THP keeps the tail of a chunk on small pages instead of rounding it up
+    if (!ptr && requested_ >= PageBacking::TRANSPARENT && size >= SIZE_2MB / 2 && !transparent_failed_.load(std::memory_order_relaxed)) {
+        const size_t mapped = round_up(size, backing_page_size(PageBacking::TRANSPARENT));
+        ptr = map_anonymous(mapped, 0);
+        if (ptr && madvise(ptr, mapped, MADV_HUGEPAGE) == 0) {
+            backing = PageBacking::TRANSPARENT;
+        } else {
+            if (ptr) munmap(ptr, mapped);
+            ptr = nullptr;
+            transparent_failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    // Mappings come zeroed; heap memory is cleared here
+    if (!ptr) {
+        ptr = std::aligned_alloc(HEAP_ALIGNMENT, round_up(size, HEAP_ALIGNMENT));
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        std::memset(ptr, 0, size);
+        backing = PageBacking::HEAP;
+    }
+
+    chunk_counts_[static_cast<size_t>(backing)].fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+}
+
+void PageAllocator::deallocate(void* ptr, size_t size, PageBacking backing) {
+    if (!ptr) {
+        return;
+    }
+
+#if defined(__linux__)
+    if (backing != PageBacking::HEAP) {
+        munmap(ptr, round_up(size, backing_page_size(backing)));
+        return;
+    }
+#else
+    (void)size;
+#endif
+    std::free(ptr);
+}
+
+void PageAllocator::prefault(void* ptr, size_t size, PageBacking backing) {
+    // Heap chunks were cleared when allocated, which mapped them already
+    if (!ptr || backing == PageBacking::HEAP) {
+        return;
+    }
+
+    const size_t stride = backing_page_size(backing);
+    volatile char* bytes = static_cast<char*>(ptr);
+    for (size_t offset = 0; offset < size; offset += stride) {
+        bytes[offset] = 0;
+    }
+}
+
+size_t PageAllocator::page_size() const {
+    switch (requested_) {
+        case PageBacking::HUGE_1GB: return SIZE_1GB;
+        case PageBacking::HUGE_2MB:
+        case PageBacking::TRANSPARENT: return SIZE_2MB;
+        default: return HEAP_ALIGNMENT;
+    }
+}
+
+bool PageAllocator::fits_huge_pages(size_t size, size_t page) {
+    if (size == 0) {
+        return false;
+    }
+    const size_t mapped = round_up(size, page);
+    return (mapped - size) * MAX_ROUNDING_SHARE <= mapped;
+}
+
+std::string PageAllocator::describe() const {
+    std::string result;
+    for (PageBacking backing : {PageBacking::HUGE_1GB, PageBacking::HUGE_2MB, PageBacking::TRANSPARENT, PageBacking::HEAP}) {
+        const size_t count = chunk_counts_[static_cast<size_t>(backing)].load(std::memory_order_relaxed);
+        if (count == 0) continue;
+
+        if (!result.empty()) result += ", ";
+        result += std::string(backing_name(backing)) + " (" + std::to_string(count) + (count == 1 ? " chunk" : " chunks");
+        const size_t rounding = rounding_bytes_[static_cast<size_t>(backing)].load(std::memory_order_relaxed);
+        if (rounding > 0) {
+            result += ", " + StringUtils::format_byte_size(rounding) + " rounding";
+        }
+        result += ")";
+    }
+    return result.empty() ? "no chunks" : result;
+}
+
+const char* PageAllocator::backing_name(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::HUGE_1GB: return "1GB huge pages";
+        case PageBacking::HUGE_2MB: return "2MB huge pages";
+        case PageBacking::TRANSPARENT: return "transparent huge pages";
+        default: return "heap";
+    }
+}
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <thread>
+#include <chrono>
 
 void test_memory_pool_basic() {
     ColumnConfigInstanceVector col_instances;
@@ -196,7 +198,52 @@ void test_memory_pool_get_cell_out_of_range() {
 }
 
 void test_memory_pool_get_cell_null() {
-    std::cout << "test_memory_pool_get_cell_null skipped (not implemented)." << std::endl;
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "INT"});
+    col_instances.emplace_back(ColumnConfig{"col2", "VARCHAR(8)"});
+    MemoryPool pool(1, 1, 3, col_instances, tag_instances);
+
+    auto* block = pool.acquire_block();
+    auto& table = block->tables[0];
+
+    RowData row;
+    row.timestamp = 1;
+    row.columns = {int32_t(1), std::string("a")};
+    table.add_row(row);
+
+    row.timestamp = 2;
+    row.nulls = {CELL_NULL, CELL_NONE};
+    table.add_row(row);
+
+    row.timestamp = 3;
+    row.columns = {int32_t(3), std::string("ccc")};
+    row.nulls = {CELL_VALUE, CELL_VALUE};
+    table.add_row(row);
+
+    assert(table.get_column_flag(0, 0) == CELL_VALUE);
+    assert(table.get_column_flag(1, 0) == CELL_NULL);
+    assert(table.get_column_flag(1, 1) == CELL_NONE);
+    assert(table.get_column_flag(2, 1) == CELL_VALUE);
+
+    // Var data stays contiguous around the empty cell
+    const auto& col2 = table.columns[1];
+    assert(col2.lengths[1] == 0);
+    assert(col2.var_offsets[1] == col2.var_offsets[2]);
+    assert(std::get<std::string>(table.get_column_cell(2, 1)) == "ccc");
+    assert(std::get<int32_t>(table.get_column_cell(2, 0)) == 3);
+
+    bool caught = false;
+    try {
+        table.get_column_flag(3, 0);
+    } catch (const std::out_of_range&) {
+        caught = true;
+    }
+    (void)caught;
+    assert(caught);
+
+    pool.release_block(block);
+    std::cout << "test_memory_pool_get_cell_null passed." << std::endl;
 }
 
 void test_memory_pool_tables_reuse_data() {
@@ -673,6 +720,407 @@ void test_memory_pool_bind_verification() {
     std::cout << "test_memory_pool_bind_verification passed." << std::endl;
 }
 
+void test_memory_pool_tags_dedup() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "INT"});
+    tag_instances.emplace_back(ColumnConfig{"groupid", "INT"});
+    tag_instances.emplace_back(ColumnConfig{"location", "VARCHAR(24)"});
+
+    MemoryPool pool(1, 1, 1, col_instances, tag_instances);
+
+    // Identical tuples share one Tags, by name or not
+    std::vector<ColumnType> beijing = {int32_t(1), std::string("Beijing")};
+    std::vector<ColumnType> shanghai = {int32_t(1), std::string("Shanghai")};
+    auto* d0 = pool.register_table_tags("d0", beijing);
+    auto* d1 = pool.register_table_tags("d1", beijing);
+    auto* d2 = pool.register_table_tags("d2", shanghai);
+    assert(d0 != nullptr && d0 == d1);
+    assert(d2 != nullptr && d2 != d0);
+    assert(pool.get_table_tags("d1") == d0);
+    assert(pool.intern_table_tags(beijing) == d0);
+    assert(pool.intern_table_tags(shanghai) == d2);
+    assert(d0->table_name == "d0");
+
+    // Parallel registration from several producers lands on the same entries
+    constexpr size_t THREADS = 4;
+    constexpr size_t TABLES = 1000;
+    std::vector<std::vector<const MemoryPool::TableBlock::Tags*>> results(THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < TABLES; ++i) {
+                std::vector<ColumnType> values = {int32_t(i % 10), std::string("loc") + std::to_string(i % 7)};
+                results[t].push_back(pool.intern_table_tags(values));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < TABLES; ++i) {
+        assert(results[0][i] != nullptr);
+        for (size_t t = 1; t < THREADS; ++t) {
+            assert(results[t][i] == results[0][i]);
+        }
+        assert(results[0][i] == results[0][i % 70]);
+    }
+    assert(results[0][0] != results[0][1]);
+
+    // Values survive sharing
+    auto* block = pool.acquire_block();
+    RowData row;
+    row.timestamp = 12345;
+    row.columns = {int32_t(1)};
+    block->tables[0].table_name = "d13";
+    block->tables[0].tags_ptr = results[0][13];
+    block->tables[0].add_row(row);
+    assert(std::get<int32_t>(block->tables[0].get_tag_cell(0, 0)) == 3);
+    assert(std::get<std::string>(block->tables[0].get_tag_cell(0, 1)) == "loc6");
+    pool.release_block(block);
+
+    (void)d0;
+    (void)d1;
+    (void)d2;
+
+    std::cout << "test_memory_pool_tags_dedup passed." << std::endl;
+}
+
+void test_memory_pool_partitions() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "INT"});
+
+    MemoryPoolOptions options;
+    options.partitions = 2;
+    MemoryPool pool(6, 2, 4, col_instances, tag_instances, false, 0, options);
+    assert(pool.partition_count() == 2);
+
+    // Every block is handed out once, whichever partition is local
+    std::vector<MemoryPool::MemoryBlock*> blocks;
+    size_t per_partition[2] = {0, 0};
+    for (size_t i = 0; i < 6; ++i) {
+        auto* block = pool.acquire_block();
+        assert(block != nullptr);
+        assert(block->partition < 2);
+        assert(block->tables.size() == 2);
+        per_partition[block->partition]++;
+        blocks.push_back(block);
+    }
+    assert(per_partition[0] == 3 && per_partition[1] == 3);
+
+    // Blocks go back to their own partition and stay usable
+    for (auto* block : blocks) {
+        pool.release_block(block);
+    }
+    auto* block = pool.acquire_block();
+    RowData row;
+    row.timestamp = 1;
+    row.columns = {int32_t(7)};
+    block->tables[0].add_row(row);
+    assert(std::get<int32_t>(block->tables[0].get_column_cell(0, 0)) == 7);
+    pool.release_block(block);
+
+    // More partitions than blocks are clamped
+    options.partitions = 4;
+    MemoryPool small(1, 1, 1, col_instances, tag_instances, false, 0, options);
+    assert(small.partition_count() == 1);
+
+    std::cout << "test_memory_pool_partitions passed." << std::endl;
+}
+
+void test_memory_pool_block_caches() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "INT"});
+
+    MemoryPool pool(4, 1, 4, col_instances, tag_instances);
+    size_t first = pool.attach_block_cache();
+    size_t second = pool.attach_block_cache();
+    assert(first != MemoryPool::NO_BLOCK_CACHE && second != MemoryPool::NO_BLOCK_CACHE);
+    assert(first != second);
+
+    // A released block comes back to the producer that acquired it
+    auto* own = pool.acquire_block(0, first);
+    assert(own->owner_cache == first);
+    pool.release_block(own);
+    assert(pool.acquire_block(0, first) == own);
+
+    // Once the shared lists are empty, other producers steal returned blocks
+    std::vector<MemoryPool::MemoryBlock*> taken;
+    for (size_t i = 0; i < 3; ++i) {
+        taken.push_back(pool.acquire_block(0, second));
+    }
+    pool.release_block(own);
+    auto* stolen = pool.acquire_block(0, second);
+    assert(stolen == own);
+    assert(stolen->owner_cache == second);
+    taken.push_back(stolen);
+
+    // Detached caches give everything back to the shared lists
+    for (auto* block : taken) {
+        pool.release_block(block);
+    }
+    pool.detach_block_cache(first);
+    pool.detach_block_cache(second);
+    taken.clear();
+    for (size_t i = 0; i < 4; ++i) {
+        taken.push_back(pool.acquire_block());
+    }
+    for (auto* block : taken) {
+        assert(block->owner_cache == MemoryPool::NO_BLOCK_CACHE);
+        pool.release_block(block);
+    }
+
+    // No more caches than blocks
+    MemoryPool small(2, 1, 1, col_instances, tag_instances);
+    assert(small.attach_block_cache() != MemoryPool::NO_BLOCK_CACHE);
+    assert(small.attach_block_cache() != MemoryPool::NO_BLOCK_CACHE);
+    assert(small.attach_block_cache() == MemoryPool::NO_BLOCK_CACHE);
+
+    // Or than producers, when the count is given
+    MemoryPoolOptions options;
+    options.producers = 2;
+    MemoryPool sized(8, 1, 1, col_instances, tag_instances, false, 0, options);
+    assert(sized.attach_block_cache() != MemoryPool::NO_BLOCK_CACHE);
+    assert(sized.attach_block_cache() != MemoryPool::NO_BLOCK_CACHE);
+    assert(sized.attach_block_cache() == MemoryPool::NO_BLOCK_CACHE);
+
+    // A lone producer waiting on a drained pool gets its own blocks back
+    MemoryPool single(2, 1, 4, col_instances, tag_instances);
+    size_t only = single.attach_block_cache();
+    auto* held_a = single.acquire_block(0, only);
+    auto* held_b = single.acquire_block(0, only);
+    std::thread releaser([&single, held_a, held_b]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        single.release_block(held_a);
+        single.release_block(held_b);
+    });
+    auto* again = single.acquire_block(0, only);
+    assert(again == held_a || again == held_b);
+    releaser.join();
+    single.release_block(again);
+    single.detach_block_cache(only);
+
+    // Producers holding two blocks each on a pool of five keep making
+    // progress; consumers release from other threads
+    MemoryPool shared(5, 1, 4, col_instances, tag_instances);
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < 4; ++t) {
+        producers.emplace_back([&shared]() {
+            size_t cache = shared.attach_block_cache();
+            for (size_t i = 0; i < 2000; ++i) {
+                auto* a = shared.acquire_block(i, cache);
+                auto* b = shared.acquire_block(i, cache);
+                assert(a != b && a->in_use && b->in_use);
+                std::thread consumer([&shared, a]() { shared.release_block(a); });
+                shared.release_block(b);
+                consumer.join();
+            }
+            shared.detach_block_cache(cache);
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    // No block is lost in a cache
+    taken.clear();
+    for (size_t i = 0; i < 5; ++i) {
+        taken.push_back(shared.acquire_block());
+    }
+    for (auto* block : taken) {
+        shared.release_block(block);
+    }
+
+    std::cout << "test_memory_pool_block_caches passed." << std::endl;
+}
+
+void test_memory_pool_memory_limit() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "INT"});
+    col_instances.emplace_back(ColumnConfig{"col2", "VARCHAR(16)"});
+
+    MemoryPool fixed(3, 2, 4, col_instances, tag_instances);
+    const size_t footprint = fixed.block_footprint();
+    assert(footprint > 2 * 4 * (sizeof(int64_t) + sizeof(int32_t) + 16));
+    assert(fixed.block_count() == 3 && fixed.max_block_count() == 3);
+
+    // Starts at the requested count and grows up to the budget
+    MemoryPoolOptions options;
+    options.memory_limit = footprint * 4 + footprint / 2;
+    MemoryPool pool(2, 2, 4, col_instances, tag_instances, false, 0, options);
+    assert(pool.block_footprint() == footprint);
+    assert(pool.block_count() == 2 && pool.max_block_count() == 4);
+
+    std::vector<MemoryPool::MemoryBlock*> blocks;
+    for (size_t i = 0; i < 4; ++i) {
+        blocks.push_back(pool.acquire_block());
+    }
+    assert(pool.block_count() == 4 && pool.resident_block_count() == 4);
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = i + 1; j < 4; ++j) {
+            assert(blocks[i] != blocks[j]);
+        }
+    }
+
+    // Grown blocks give their chunks back once the pool is idle
+    for (auto* block : blocks) {
+        pool.release_block(block);
+    }
+    assert(pool.resident_block_count() == 2);
+
+    // and are backed again when needed
+    blocks.clear();
+    for (size_t i = 0; i < 4; ++i) {
+        blocks.push_back(pool.acquire_block());
+    }
+    assert(pool.block_count() == 4 && pool.resident_block_count() == 4);
+    RowData row;
+    row.timestamp = 5;
+    row.columns = {int32_t(9), std::string("elastic")};
+    for (auto* block : blocks) {
+        block->tables[1].add_row(row);
+        assert(std::get<int32_t>(block->tables[1].get_column_cell(0, 0)) == 9);
+        assert(block->tables[1].get_column_cell_as_string(0, 1) == "elastic");
+        pool.release_block(block);
+    }
+
+    // The budget caps the initial count too
+    options.memory_limit = footprint * 3;
+    MemoryPool capped(10, 2, 4, col_instances, tag_instances, false, 0, options);
+    assert(capped.block_count() == 3 && capped.max_block_count() == 3);
+
+    bool caught = false;
+    options.memory_limit = footprint - 1;
+    try {
+        MemoryPool tiny(1, 2, 4, col_instances, tag_instances, false, 0, options);
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    (void)caught;
+
+    std::cout << "test_memory_pool_memory_limit passed." << std::endl;
+}
+
+void test_memory_pool_var_arena() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "INT"});
+    col_instances.emplace_back(ColumnConfig{"col2", "VARCHAR(1024)"});
+    col_instances.emplace_back(ColumnConfig{"col3", "VARCHAR(64)"});
+
+    // Var data is sized by an estimate, not cap bytes per row
+    MemoryPool pool(1, 4, 100, col_instances, tag_instances);
+    assert(pool.block_footprint() < 4 * 100 * 1024 / 4);
+
+    auto fill = [](MemoryPool::MemoryBlock* block, size_t length) {
+        for (size_t t = 0; t < 4; ++t) {
+            auto& table = block->tables[t];
+            for (size_t r = 0; r < 100; ++r) {
+                RowData row;
+                row.timestamp = static_cast<int64_t>(r);
+                row.columns = {int32_t(r), std::string(length, char('a' + (t + r) % 26)), std::string("t") + std::to_string(t)};
+                table.add_row(row);
+            }
+            block->used_tables++;
+        }
+    };
+    auto check = [](MemoryPool::MemoryBlock* block, size_t length) {
+        for (size_t t = 0; t < 4; ++t) {
+            const auto& table = block->tables[t];
+            for (size_t r = 0; r < 100; ++r) {
+                assert(std::get<int32_t>(table.get_column_cell(r, 0)) == int32_t(r));
+                assert(table.get_column_cell_as_string(r, 1) == std::string(length, char('a' + (t + r) % 26)));
+                assert(table.get_column_cell_as_string(r, 2) == std::string("t") + std::to_string(t));
+            }
+        }
+    };
+
+    // Short values fit the block's own arena
+    auto* block = pool.acquire_block();
+    const size_t initial = block->var_arena.capacity();
+    fill(block, 20);
+    check(block, 20);
+    assert(block->var_arena.chunks.size() == 1);
+
+    // The binding follows var data that moved while filling
+    block->build_bindv();
+    assert(block->bind_lists_[0][2].buffer == block->tables[0].columns[1].var_data);
+    pool.release_block(block);
+
+    // Long values spill to overflow chunks
+    block = pool.acquire_block();
+    fill(block, 1000);
+    check(block, 1000);
+    assert(block->var_arena.current > 0);
+    pool.release_block(block);
+
+    // The block keeps one overflow chunk big enough for that next time
+    block = pool.acquire_block();
+    assert(block->var_arena.chunks.size() == 2);
+    assert(block->var_arena.capacity() > initial + 4 * 100 * 1000);
+    fill(block, 1000);
+    check(block, 1000);
+    assert(block->var_arena.current <= 1 && block->var_arena.chunks.size() == 2);
+    assert(pool.var_overflow_bytes() == block->var_arena.capacity() - initial);
+    pool.release_block(block);
+
+    // Overflow counts against the memory limit; past it a block keeps none
+    MemoryPoolOptions options;
+    options.memory_limit = pool.block_footprint() * 2;
+    MemoryPool limited(1, 4, 100, col_instances, tag_instances, false, 0, options);
+    block = limited.acquire_block();
+    fill(block, 1000);
+    check(block, 1000);
+    assert(limited.var_overflow_bytes() > options.memory_limit);
+    limited.release_block(block);
+    block = limited.acquire_block();
+    assert(block->var_arena.chunks.size() == 1 && limited.var_overflow_bytes() == 0);
+    fill(block, 1000);
+    check(block, 1000);
+    limited.release_block(block);
+
+    // Reused tables keep a fixed region per column
+    MemoryPool reuse(1, 2, 10, col_instances, tag_instances, true);
+    block = reuse.acquire_block();
+    assert(block->tables[0].columns[1].var_arena == nullptr);
+    assert(block->tables[0].columns[1].var_capacity == 10 * 1024);
+    reuse.release_block(block);
+
+    std::cout << "test_memory_pool_var_arena passed." << std::endl;
+}
+
+void test_memory_pool_huge_pages_prefault() {
+    ColumnConfigInstanceVector col_instances;
+    ColumnConfigInstanceVector tag_instances;
+    col_instances.emplace_back(ColumnConfig{"col1", "BIGINT"});
+    col_instances.emplace_back(ColumnConfig{"col2", "VARCHAR(64)"});
+    tag_instances.emplace_back(ColumnConfig{"t1", "INT"});
+
+    // Falls back to whatever the machine offers; the pool works the same
+    MemoryPoolOptions options;
+    options.huge_pages = "2mb";
+    options.prefault = true;
+    MemoryPool pool(4, 8, 1024, col_instances, tag_instances, false, 0, options);
+    assert(!pool.page_backing().empty());
+
+    auto* block = pool.acquire_block();
+    auto& table = block->tables[0];
+    table.tags_ptr = pool.intern_table_tags({int32_t(3)});
+    RowData row;
+    row.timestamp = 42;
+    row.columns = {int64_t(9), std::string("abc")};
+    table.add_row(row);
+    assert(std::get<int64_t>(table.get_column_cell(0, 0)) == 9);
+    assert(table.get_column_cell_as_string(0, 1) == "abc");
+    assert(std::get<int32_t>(table.get_tag_cell(0, 0)) == 3);
+    pool.release_block(block);
+
+    std::cout << "test_memory_pool_huge_pages_prefault passed (" << pool.page_backing() << ")." << std::endl;
+}
+
 int main() {
     test_memory_pool_basic();
     test_memory_pool_multi_batch();
@@ -680,6 +1128,11 @@ int main() {
     test_memory_pool_get_cell_out_of_range();
     test_memory_pool_get_cell_null();
     test_memory_pool_tables_reuse_data();
+    test_memory_pool_partitions();
+    test_memory_pool_block_caches();
+    test_memory_pool_memory_limit();
+    test_memory_pool_var_arena();
+    test_memory_pool_huge_pages_prefault();
 
     test_memory_pool_cache_mode_basic();
     test_memory_pool_cache_mode_shared();
@@ -690,6 +1143,7 @@ int main() {
     test_memory_pool_tags_management();
     test_memory_pool_tags_edge_cases();
     test_memory_pool_bind_verification();
+    test_memory_pool_tags_dedup();
 
     std::cout << "All MemoryPool tests passed." << std::endl;
     return 0;
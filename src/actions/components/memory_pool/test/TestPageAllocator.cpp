@@ -0,0 +1,95 @@
+#include "PageAllocator.hpp"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+bool all_zero(const void* ptr, size_t size) {
+    const char* bytes = static_cast<const char*>(ptr);
+    for (size_t i = 0; i < size; ++i) {
+        if (bytes[i] != 0) return false;
+    }
+    return true;
+}
+
+void test_heap_backing() {
+    PageAllocator allocator("off");
+    assert(!allocator.huge_pages_requested());
+
+    PageBacking backing;
+    void* chunk = allocator.allocate(8 << 20, backing);
+    assert(backing == PageBacking::HEAP);
+    assert(reinterpret_cast<uintptr_t>(chunk) % 64 == 0);
+    assert(all_zero(chunk, 8 << 20));
+    PageAllocator::deallocate(chunk, 8 << 20, backing);
+
+    assert(allocator.describe() == "heap (1 chunk)");
+    std::cout << "test_heap_backing passed." << std::endl;
+}
+
+void test_huge_pages_fall_back() {
+    // Whatever the machine offers, every request gets usable zeroed memory
+    for (const char* mode : {"transparent", "2mb", "1gb"}) {
+        PageAllocator allocator(mode);
+        assert(allocator.huge_pages_requested());
+
+        const size_t size = (4 << 20) + 100;
+        PageBacking backing;
+        void* chunk = allocator.allocate(size, backing);
+        assert(chunk != nullptr);
+        assert(reinterpret_cast<uintptr_t>(chunk) % 64 == 0);
+        assert(all_zero(chunk, size));
+
+        PageAllocator::prefault(chunk, size, backing);
+        std::memset(chunk, 0x5a, size);
+        PageAllocator::deallocate(chunk, size, backing);
+
+        // Small chunks never take a huge page
+        void* small = allocator.allocate(4096, backing);
+        assert(backing == PageBacking::HEAP);
+        PageAllocator::deallocate(small, 4096, backing);
+
+        std::cout << mode << ": " << allocator.describe() << std::endl;
+    }
+    std::cout << "test_huge_pages_fall_back passed." << std::endl;
+}
+
+void test_huge_page_rounding_policy() {
+    const size_t mb = size_t(1) << 20;
+
+    // Whole pages, or an eighth of the mapping lost at most
+    assert(PageAllocator::fits_huge_pages(4 * mb, 2 * mb));
+    assert(PageAllocator::fits_huge_pages(15 * mb, 2 * mb));
+    assert(PageAllocator::fits_huge_pages(14 * mb + 1, 2 * mb));
+    assert(PageAllocator::fits_huge_pages(900 * mb, 1024 * mb));
+
+    // Rounded up by too much: these go to THP instead
+    assert(!PageAllocator::fits_huge_pages(mb, 2 * mb));
+    assert(!PageAllocator::fits_huge_pages(4 * mb + 100, 2 * mb));
+    assert(!PageAllocator::fits_huge_pages(600 * mb, 1024 * mb));
+    assert(!PageAllocator::fits_huge_pages(0, 2 * mb));
+
+    std::cout << "test_huge_page_rounding_policy passed." << std::endl;
+}
+
+void test_invalid_mode() {
+    bool thrown = false;
+    try {
+        PageAllocator allocator("4kb");
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::cout << "test_invalid_mode passed." << std::endl;
+}
+
+int main() {
+    test_heap_backing();
+    test_huge_pages_fall_back();
+    test_huge_page_rounding_policy();
+    test_invalid_mode();
+
+    std::cout << "All PageAllocator tests passed." << std::endl;
+    return 0;
+}
@@ -88,15 +88,12 @@ public:
     static std::vector<RowData> convert_table_data_to_row_data(const TableData& table_data,
                                                                const std::string& csv_precision,
                                                                const std::string& target_precision) {
+        const TimestampUtils::PrecisionConverter convert(csv_precision, target_precision);
         std::vector<RowData> rows;
         rows.reserve(table_data.rows.size());
         for (size_t i = 0; i < table_data.rows.size(); i++) {
             RowData row;
-            row.timestamp = TimestampUtils::convert_timestamp_precision(
-                table_data.timestamps[i],
-                csv_precision,
-                target_precision
-            );
+            row.timestamp = convert(table_data.timestamps[i]);
             row.columns = table_data.rows[i];
             rows.push_back(std::move(row));
         }
@@ -11,6 +11,11 @@
 
 struct ExpressionTag {};
 
+// Per-cell flags kept in is_nulls buffers; NONE means the column is not written
+constexpr char CELL_VALUE = 0;
+constexpr char CELL_NULL = 1;
+constexpr char CELL_NONE = 2;
+
 struct ColumnConfig {
     std::string name;
     std::string type;
@@ -28,24 +33,40 @@ struct ColumnConfig {
     std::optional<float> none_ratio;
 
     // Attributes for gen_type=random
-    std::optional<std::string> distribution;
+    std::optional<std::string> distribution;   // uniform, normal, lognormal, exponential, zipf
+    std::optional<double> mean;
+    std::optional<double> stddev;
+    std::optional<double> lambda;
+    std::optional<double> skew;
     std::optional<double> min;
     std::optional<double> max;
     std::optional<std::string> dec_min;
     std::optional<std::string> dec_max;
-    std::optional<std::string> corpus;
+    std::optional<std::string> corpus;         // Alphabet, or a text split into words
+    std::vector<std::string> words;            // Word list for string columns
     std::optional<bool> chinese;
 
     int values_count = -1;
     std::vector<double> dbl_values;
     std::vector<std::string> str_values;
+    std::vector<double> weights;
 
     // Attributes for gen_type=order
     std::optional<int64_t> order_min;
     std::optional<int64_t> order_max;
 
+    // Attributes for the signal gen_types (random_walk, sine, seasonal, sawtooth, step);
+    // they also use min, max, mean and stddev
+    std::optional<double> amplitude;
+    std::optional<double> period;       // Rows per cycle
+    std::optional<double> phase;        // Fraction of a cycle
+    std::optional<double> noise;        // Gaussian noise stddev
+    std::optional<double> drift;        // Mean random_walk step
+    std::optional<std::string> boundary;    // random_walk at the bounds: reflect, wrap
+
     // Attributes for gen_type=expression
     std::optional<std::string> formula;
+    std::optional<bool> per_table;      // Evaluate once per table; detected when unset
 
     TimestampStrategy ts;
 
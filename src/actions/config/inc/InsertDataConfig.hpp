@@ -28,6 +28,9 @@ struct InsertDataConfig {
     std::string thread_allocation = "index_range";
     bool thread_affinity = false;
     bool thread_realtime = false;
+    std::string huge_pages = "off";                 // Memory pool pages: off, transparent, 2mb or 1gb
+    bool prefault = false;                          // Map all memory pool pages at startup
+    size_t memory_limit = 0;                        // Memory pool byte budget; 0 sizes it by queue_capacity
 
     struct FailureHandling {
         size_t max_retries = 0;
@@ -6,6 +6,16 @@
 #include "FromCSVConfig.hpp"
 #include "ColumnsConfig.hpp"
 #include "TagsConfig.hpp"
+#include <memory>
+#include <mutex>
+
+class TableCatalog;
+
+// Child table names and tags of a job, built by the first step that needs them
+struct TableCatalogSlot {
+    std::mutex mutex;
+    std::shared_ptr<const TableCatalog> catalog;
+};
 
 struct SchemaConfig {
     bool enabled = false;
@@ -19,6 +29,9 @@ struct SchemaConfig {
     ColumnsConfig columns_cfg;
     TagsConfig tags_cfg;
 
+    // Shared by every copy of this schema, i.e. by the steps of a job
+    std::shared_ptr<TableCatalogSlot> catalog = std::make_shared<TableCatalogSlot>();
+
     void apply() {
         if (columns.empty() || columns[0].type_tag != ColumnTypeTag::BIGINT) {
             columns.insert(columns.begin(), ColumnConfig("ts", "TIMESTAMP"));
@@ -6,6 +6,7 @@
 struct RowData {
     int64_t timestamp;
     RowType columns;
+    std::vector<char> nulls{};  // Per-column CELL_* flags, empty when all cells have values
 };
 
 struct TableData {
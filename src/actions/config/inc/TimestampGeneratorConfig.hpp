@@ -7,4 +7,5 @@ struct TimestampGeneratorConfig {
     std::variant<Timestamp, std::string> start_timestamp = "now";
     std::string timestamp_precision = "ms";
     std::variant<Timestamp, std::string> timestamp_step = 1;
+    std::variant<Timestamp, std::string> timestamp_jitter = 0;   // Random offset in [0, jitter) per row
 };
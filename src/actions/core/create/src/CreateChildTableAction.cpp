@@ -1,10 +1,7 @@
 #include "CreateChildTableAction.hpp"
 #include "LogUtils.hpp"
 #include "FormatterRegistrar.hpp"
-#include "TableNameGenerator.hpp"
-#include "TableNameCSVReader.hpp"
-#include "RowGenerator.hpp"
-#include "TagsCSVReader.hpp"
+#include "TableCatalog.hpp"
 #include "ConnectorSource.hpp"
 #include <iostream>
 #include <thread>
@@ -14,55 +11,23 @@ void CreateChildTableAction::execute() {
     LogUtils::info("Creating child table: {}.{}", config_.tdengine.database, config_.schema.name);
 
     try {
-        // Generate table names
-        std::vector<std::string> table_names;
-        if (config_.schema.tbname.source_type == "generator") {
-            TableNameGenerator generator(config_.schema.tbname.generator);
-            table_names = generator.generate();
-            // for (const auto& name : table_names) {
-            //     LogUtils::info("Generated table name: " + name);
-            // }
-        } else if (config_.schema.tbname.source_type == "csv") {
-            TableNameCSVReader csv_reader(config_.schema.tbname.csv);
-            table_names = csv_reader.generate();
-            for (const auto& name : table_names) {
-                LogUtils::info("Read table name from CSV: {}", name);
-            }
-        } else {
-            throw std::runtime_error("Unsupported table name source type: " + config_.schema.tbname.source_type);
-        }
-
-        LogUtils::info("Total table names generated: {}", table_names.size());
-
-        // Generate tags
-        std::vector<RowType> tags;
-        if (config_.schema.tags_cfg.source_type == "generator") {
-            auto instances = ColumnConfigInstanceFactory::create(config_.schema.tags_cfg.get_schema());
-            RowGenerator row_generator(instances);
-            tags = row_generator.generate(table_names.size());
-            // for (const auto& tag : tags) {
-            //     LogUtils::info("Generated tag: " + tag);
-            // }
-        } else if (config_.schema.tags_cfg.source_type == "csv") {
-            auto instances = ColumnConfigInstanceFactory::create(config_.schema.tags_cfg.get_schema());
-            TagsCSVReader tags_csv(config_.schema.tags_cfg.csv, instances);
-            tags = tags_csv.generate();
-            if (global_.verbose) {
-                for (const auto& tag : tags) {
-                    LogUtils::info("Read tag from CSV: {}", fmt::streamed(tag));
+        // Names and tags come from the job's catalog, shared with the insert step
+        auto catalog = TableCatalog::shared(config_.schema);
+        const TableNameList& table_names = catalog->names();
+
+        if (global_.verbose) {
+            std::string buffer;
+            for (size_t i = 0; i < catalog->size(); ++i) {
+                if (catalog->has_tags()) {
+                    LogUtils::info("Table {} tags: {}", table_names.at(i, buffer), fmt::streamed(catalog->tags(i)));
+                } else {
+                    LogUtils::info("Table {}", table_names.at(i, buffer));
                 }
             }
-            if (tags.size() != table_names.size()) {
-                throw std::runtime_error(
-                    "Number of tags (" + std::to_string(tags.size()) +
-                    ") does not match number of table names (" + std::to_string(table_names.size()) + ")"
-                );
-            }
-        } else {
-            throw std::runtime_error("Unsupported tags source type: " + config_.schema.tags_cfg.source_type);
         }
 
-        LogUtils::info("Total tags generated: {}", tags.size());
+        LogUtils::info("Total table names generated: {}", table_names.size());
+        LogUtils::info("Total tags generated: {}", catalog->has_tags() ? catalog->size() : 0);
 
         // Split data into groups based on concurrency
         int concurrency = config_.batch.concurrency;
@@ -77,12 +42,11 @@ void CreateChildTableAction::execute() {
 
             if (start_idx >= total_tables) break;
 
-            // Extract the subset of table names and tags for this group
-            std::vector<std::string> group_table_names(table_names.begin() + start_idx, table_names.begin() + end_idx);
-            std::vector<RowType> group_tags(tags.begin() + start_idx, tags.begin() + end_idx);
+            // The group's slice of the catalog
+            TableNameList group_table_names = table_names.slice(start_idx, end_idx - start_idx);
 
             // Create threads for each group
-            threads.emplace_back([this, group_idx, group_table_names, group_tags, &conn_source]() {
+            threads.emplace_back([this, group_idx, group_table_names, catalog, &conn_source]() {
                 try {
                     // Create a local connector
                     auto local_connector = conn_source.get_connector();
@@ -97,8 +61,14 @@ void CreateChildTableAction::execute() {
                         int batch_start = batch_idx * batch_size;
                         int batch_end = std::min(batch_start + batch_size, static_cast<int>(group_table_names.size()));
 
-                        std::vector<std::string> batch_table_names(group_table_names.begin() + batch_start, group_table_names.begin() + batch_end);
-                        std::vector<RowType> batch_tags(group_tags.begin() + batch_start, group_tags.begin() + batch_end);
+                        std::vector<std::string> batch_table_names;
+                        std::vector<RowType> batch_tags;
+                        batch_table_names.reserve(batch_end - batch_start);
+                        batch_tags.reserve(batch_end - batch_start);
+                        for (int i = batch_start; i < batch_end; ++i) {
+                            batch_table_names.push_back(group_table_names[i]);
+                            batch_tags.push_back(catalog->has_tags() ? catalog->tags(group_table_names.offset() + i) : RowType{});
+                        }
 
                         // Format the batch data
                         FormatResult formatted_result = formatter->format(config_, batch_table_names, batch_tags);
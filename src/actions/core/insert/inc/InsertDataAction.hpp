@@ -34,7 +34,12 @@ private:
     std::atomic<bool> stop_execution_{false};
 
     void set_realtime_priority();
-    void set_thread_affinity(size_t thread_id, bool reverse = false, const std::string& purpose = "");
+    // Pin a thread to the rank-th CPU of a NUMA node (the last CPUs when reverse)
+    void set_thread_affinity(size_t thread_id, size_t node, size_t rank, bool reverse = false, const std::string& purpose = "");
+
+    // NUMA node of a producer or consumer thread. A producer shares the node of
+    // the consumer draining its queue, and so does the pool partition it fills
+    size_t affinity_node(size_t thread_id, bool consumer) const;
 
     ColumnConfigInstanceVector create_column_instances() const;
     ColumnConfigInstanceVector create_tag_instances() const;
@@ -42,7 +47,8 @@ private:
 
     void producer_thread_function(
         size_t producer_id,
-        const std::vector<std::string>& assigned_tables,
+        const TableNameList& assigned_tables,
+        std::shared_ptr<const TableCatalog> catalog,
         DataPipeline<FormatResult>& pipeline,
         std::shared_ptr<TableDataManager> data_manager,
         const ISinkPlugin* plugin);
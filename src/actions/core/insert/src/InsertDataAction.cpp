@@ -9,6 +9,8 @@
 #include "BaseSinkPlugin.hpp"
 #include "TimeRecorder.hpp"
 #include "ProcessUtils.hpp"
+#include "CpuTopology.hpp"
+#include "StringUtils.hpp"
 #include <sched.h>
 #include <cstring>
 #include <iostream>
@@ -33,16 +35,16 @@ void InsertDataAction::set_realtime_priority() {
 #endif
 }
 
-void InsertDataAction::set_thread_affinity(size_t thread_id, bool reverse, const std::string& purpose) {
-#if defined(__linux__)
-    // Get available CPU cores
-    unsigned int num_cores = std::thread::hardware_concurrency();
-    if (num_cores == 0) num_cores = 1;
+size_t InsertDataAction::affinity_node(size_t thread_id, bool consumer) const {
+    const size_t nodes = CpuTopology::instance().node_count();
+    const size_t consumer_id = consumer ? thread_id : thread_id % std::max<size_t>(1, config_.insert_threads);
+    return consumer_id % nodes;
+}
 
-    // Calculate core ID, supporting forward or reverse binding
-    size_t core_id = reverse
-        ? (num_cores - 1 - (thread_id % num_cores))
-        : (thread_id % num_cores);
+void InsertDataAction::set_thread_affinity(size_t thread_id, size_t node, size_t rank, bool reverse, const std::string& purpose) {
+#if defined(__linux__)
+    // Topology-driven core: the rank-th CPU of the node, counted from either end
+    const size_t core_id = static_cast<size_t>(CpuTopology::instance().cpu_for(node, rank, reverse));
 
     // Set affinity
     cpu_set_t cpuset;
@@ -63,15 +65,18 @@ void InsertDataAction::set_thread_affinity(size_t thread_id, bool reverse, const
 
     if (global_.verbose) {
         // Print binding info if verbose mode is enabled
-        LogUtils::debug("{}Thread {} bound to core {}{}",
+        LogUtils::debug("{}Thread {} bound to node {} core {}{}",
             (purpose.empty() ? "" : (purpose + " ")),
             thread_id,
+            node,
             core_id,
             reverse ? " (reverse binding)" : " (forward binding)"
         );
     }
 #else
     (void)thread_id;
+    (void)node;
+    (void)rank;
     (void)reverse;
     (void)purpose;
 #endif
@@ -83,7 +88,7 @@ void InsertDataAction::execute() {
     try {
         // Generate all child table names and split by producer thread count
         TableNameManager name_manager(config_);
-        auto all_names = name_manager.generate_table_names();
+        const auto& all_names = name_manager.generate_table_names();
 
         // Check generated table names
         if (all_names.empty()) {
@@ -131,11 +136,30 @@ void InsertDataAction::execute() {
             max_tables_per_block = std::min(max_tables_per_block, (rows_per_request + rows_per_table - 1) / rows_per_table);
         }
 
+        // With pinned threads, one pool partition per NUMA node
+        MemoryPoolOptions pool_options;
+        pool_options.partitions = config_.thread_affinity ? CpuTopology::instance().node_count() : 1;
+        pool_options.huge_pages = config_.huge_pages;
+        pool_options.prefault = config_.prefault;
+        pool_options.memory_limit = config_.memory_limit;
+        pool_options.producers = producer_thread_count;
+
         auto pool = std::make_unique<MemoryPool>(
             num_blocks, max_tables_per_block, max_rows_per_table,
-            col_instances_, tag_instances_, tables_reuse_data, num_cached_batches
+            col_instances_, tag_instances_, tables_reuse_data, num_cached_batches,
+            pool_options
         );
 
+        if (config_.memory_limit > 0) {
+            LogUtils::info("Memory pool block footprint {} ({} tables x {} rows), {} blocks growing up to {} within memory_limit {}",
+                           StringUtils::format_byte_size(pool->block_footprint()), max_tables_per_block, max_rows_per_table,
+                           pool->block_count(), pool->max_block_count(), StringUtils::format_byte_size(config_.memory_limit));
+        } else {
+            LogUtils::info("Memory pool block footprint {} ({} tables x {} rows), {} blocks, {} in total",
+                           StringUtils::format_byte_size(pool->block_footprint()), max_tables_per_block, max_rows_per_table,
+                           pool->block_count(), StringUtils::format_byte_size(pool->block_footprint() * pool->block_count()));
+        }
+
         if (config_.schema.generation.data_cache.enabled) {
             LogUtils::info("Generation data cache mode enabled with {} cache units.", pool->get_cache_units_count());
 
@@ -193,19 +217,23 @@ void InsertDataAction::execute() {
 
         std::atomic<size_t> active_producers(producer_thread_count);
 
+        std::vector<size_t> producers_on_node(CpuTopology::instance().node_count(), 0);
         for (size_t i = 0; i < producer_thread_count; i++) {
             auto data_manager = std::make_shared<TableDataManager>(*pool, config_, col_instances_, tag_instances_);
             data_managers.push_back(data_manager);
 
-            producer_threads.emplace_back([this, i, &split_names, &pipeline, data_manager, &active_producers, &producer_finished, &sink_plugins] {
+            const size_t node = affinity_node(i, false);
+            const size_t rank = producers_on_node[node]++;
+
+            producer_threads.emplace_back([this, i, node, rank, &split_names, catalog = name_manager.catalog(), &pipeline, data_manager, &active_producers, &producer_finished, &sink_plugins]() mutable {
                 try {
                     if (config_.thread_affinity) {
-                        set_thread_affinity(i, false, "Producer");
+                        set_thread_affinity(i, node, rank, false, "Producer");
                     }
                     if (config_.thread_realtime) {
                         set_realtime_priority();
                     }
-                    producer_thread_function(i, split_names[i], pipeline, data_manager, sink_plugins[0].get());
+                    producer_thread_function(i, split_names[i], std::move(catalog), pipeline, data_manager, sink_plugins[0].get());
                     producer_finished[i].store(true);
                 } catch (const std::exception& e) {
                     throw std::runtime_error("Producer thread " + std::to_string(i) + " failed: " + e.what());
@@ -214,6 +242,11 @@ void InsertDataAction::execute() {
             });
         }
 
+        // Producers hold the catalog until their tags are bound; after that
+        // nothing in this step reads it, so it is freed with the last of them
+        name_manager.release_catalog();
+        TableCatalog::release(config_.schema);
+
         (void)ProcessUtils::get_cpu_usage_percent();
         int64_t wait_seconds = std::min(static_cast<int64_t>(5), static_cast<int64_t>(producer_thread_count));
         std::this_thread::sleep_for(std::chrono::seconds(wait_seconds));
@@ -241,7 +274,7 @@ void InsertDataAction::execute() {
         for (size_t i = 0; i < consumer_thread_count; i++) {
             consumer_threads.emplace_back([this, i, &pipeline, &consumer_running, &sink_plugins, &conn_source, &gc, &startup_latch] {
                 if (config_.thread_affinity) {
-                    set_thread_affinity(i, true, "Consumer");
+                    set_thread_affinity(i, affinity_node(i, true), i / CpuTopology::instance().node_count(), true, "Consumer");
                 }
                 if (config_.thread_realtime) {
                     set_realtime_priority();
@@ -511,7 +544,8 @@ void InsertDataAction::init_cache_units_data(
 
 void InsertDataAction::producer_thread_function(
     size_t producer_id,
-    const std::vector<std::string>& assigned_tables,
+    const TableNameList& assigned_tables,
+    std::shared_ptr<const TableCatalog> catalog,
     DataPipeline<FormatResult>& pipeline,
     std::shared_ptr<TableDataManager> data_manager,
     const ISinkPlugin* plugin)
@@ -522,11 +556,12 @@ void InsertDataAction::producer_thread_function(
     }
 
     // Initialize data manager
-    if (!data_manager->init(assigned_tables)) {
+    if (!data_manager->init(assigned_tables, catalog.get())) {
         LogUtils::error("TableDataManager initialization failed for producer {}", producer_id);
         stop_execution_.store(true);
         return;
     }
+    catalog.reset();
 
     // Data generation loop
     while (!stop_execution_.load()) {
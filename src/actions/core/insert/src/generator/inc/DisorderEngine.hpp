@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GenerationConfig.hpp"
+
+// Out-of-order delivery. A row inside a disorder interval is, with the
+// interval's ratio, delayed by a random latency: it is delivered by the key
+// ts + latency instead of ts, behind the rows with timestamps up to that key.
+// Draws come from the thread-local RandomKernels stream.
+class DisorderEngine {
+public:
+    DisorderEngine() = default;
+    DisorderEngine(const GenerationConfig::DataDisorder& config, const std::string& precision);
+
+    bool enabled() const { return !intervals_.empty(); }
+
+    // Longest latency any interval can draw
+    int64_t max_latency() const;
+
+    // Delivery keys of count rows; delayed[i] is set for rows given a latency
+    void draw_keys(const int64_t* timestamps, size_t count, int64_t* keys, char* delayed) const;
+
+    // Sort rows into delivery order: by key, a delayed row after undelayed rows
+    // with the same key, otherwise in row order
+    static void sort(uint32_t* rows, size_t count, const int64_t* keys, const char* delayed);
+
+private:
+    struct Interval {
+        int64_t start_time;
+        int64_t end_time;
+        double ratio;
+        int64_t latency_range;
+    };
+
+    std::vector<Interval> intervals_;
+};
@@ -4,13 +4,17 @@
 #include <optional>
 #include <memory>
 #include <unordered_map>
-#include <queue>
 #include "InsertDataConfig.hpp"
 #include "RowGenerator.hpp"
+#include "NullGenerator.hpp"
 #include "TimestampGenerator.hpp"
+#include "TimestampUtils.hpp"
 #include "ColumnsCSVReader.hpp"
 #include "TableNameCSVReader.hpp"
 #include "MemoryPool.hpp"
+#include "DisorderEngine.hpp"
+#include "RandomKernels.hpp"
+#include "TableStateStore.hpp"
 
 class RowDataGenerator {
 public:
@@ -23,6 +27,13 @@ public:
     std::optional<RowData> next_row();
     int next_row(MemoryPool::TableBlock& table_block);
 
+    // Generate up to count rows column by column straight into the table block;
+    // only valid when supports_batch() is true. Returns the number of rows written
+    size_t next_rows(MemoryPool::TableBlock& table_block, size_t count);
+
+    // Whether rows can be produced by the columnar batch path
+    bool supports_batch() const;
+
     // Check if there is more data
     bool has_more() const;
 
@@ -32,39 +43,52 @@ public:
     // Reset generator state
     void reset();
 
+    // Whether one generator can serve many tables by swapping their state in
+    // and out: generator source, no disorder and no per-table expression columns
+    static bool shareable(const InsertDataConfig& config, const ColumnConfigInstanceVector& instances);
+
+    // Column model state words each table needs in a TableStateStore
+    size_t state_words() const;
+
+    // Switch to / write back the state of one table of the store
+    void load_state(const TableStateStore& store, size_t table);
+    void save_state(TableStateStore& store, size_t table) const;
+
 private:
-    // Delayed queue element
-    struct DelayedRow {
-        int64_t deliver_timestamp;
-        RowData row;
-        bool operator<(const DelayedRow& other) const {
-            return deliver_timestamp > other.deliver_timestamp;
-        }
-    };
+    // Rows generated per disorder window refill. Delayed rows outlive their
+    // refill, so latencies are not bounded by it
+    static constexpr size_t DISORDER_WINDOW = 1024;
 
-    struct DisorderInterval {
-        int64_t start_time;
-        int64_t end_time;
-        double ratio;
-        int latency_range;
-    };
+    // Counter-mode columns of the draws that belong to no data column
+    static constexpr uint32_t TIMESTAMP_STREAM = UINT32_MAX;
+    static constexpr uint32_t DISORDER_STREAM = UINT32_MAX - 1;
 
     void init_cached_row();
 
     // Initialize cache
     void init_cache();
 
-    // Initialize disorder
-    void init_disorder();
-
     // Initialize raw data source
     void init_raw_source();
 
-    // Apply disorder strategy
-    bool apply_disorder(RowData& row);
+    // Next row of the row path, drawn from the disorder window when enabled
+    RowData* next_raw_row();
 
-    // Process delay queue
-    void process_delay_queue();
+    // Move the rows still held to the front of the disorder window, generate
+    // the next rows behind them and plan the ones deliverable now. The row
+    // path keeps rows as RowData, the batch path in window_columns_
+    bool refill_window();
+    bool refill_column_window();
+    void hold_window_rows();
+    void plan_window(size_t held, size_t fresh, int64_t first_row);
+
+    // Batch path: deliver up to rows rows of the window into the table block
+    size_t next_window_rows(MemoryPool::TableBlock& table_block, size_t start, size_t rows);
+    void reserve_window_columns(size_t rows);
+
+    // Timestamps and columns of rows first_row.. written at start
+    void generate_rows(int64_t* timestamps, MemoryPool::TableBase::Column* columns, size_t start, size_t rows,
+                       int64_t first_row);
 
     // Fetch a row from raw source
     std::optional<std::reference_wrapper<RowData>> fetch_raw_row();
@@ -72,19 +96,26 @@ private:
     // Initialize generator components
     void init_generator();
 
+    // Fill one column of the table block, leaving NULL / NONE rows empty
+    void fill_column(MemoryPool::TableBase::Column& col, size_t col_idx, size_t start, size_t rows);
+
+    // Same, one cell at a time at its counter position (row first_row + i)
+    void fill_column_seeded(MemoryPool::TableBase::Column& col, size_t col_idx, size_t start, size_t rows,
+                            RandomKernels::CounterScope& scope, int64_t first_row);
+
     // Initialize CSV reader
     void init_csv_reader();
 
     // Get data from generator
-    void generate_from_generator();
+    void generate_from_generator(RandomKernels::CounterScope& scope);
 
     // Get data from CSV
-    bool generate_from_csv();
+    bool generate_from_csv(RandomKernels::CounterScope& scope);
 
     const std::vector<RowData>& csv_rows() const;
 
 private:
-    const std::string& table_name_;
+    const std::string table_name_;
     const InsertDataConfig& config_;
     const ColumnsConfig& columns_config_;
     const ColumnConfigInstanceVector& instances_;
@@ -98,6 +129,10 @@ private:
     std::unique_ptr<RowGenerator> row_generator_;
     std::unique_ptr<ColumnsCSVReader> columns_csv_;
     std::unique_ptr<TimestampGenerator> timestamp_generator_;
+    TimestampUtils::PrecisionConverter timestamp_converter_;    // Generator precision -> target
+
+    // NULL / NONE cells per column, only populated when a ratio is configured
+    std::vector<NullGenerator> null_generators_;
 
     // CSV data
     std::vector<RowData> csv_rows_;
@@ -107,14 +142,36 @@ private:
 
     // State management
     int64_t generated_rows_ = 0;
+    int64_t fetched_rows_ = 0;      // Raw rows produced, ahead of generated_rows_ inside a disorder window
     int64_t total_rows_ = 0;
     bool use_generator_ = false;
 
-    // Disorder management
-    std::priority_queue<DelayedRow> delay_queue_;
     std::vector<RowData> cache_;
 
-    std::vector<DisorderInterval> disorder_intervals_;
+    // Counter-mode key of this table, set when generation.seed is configured
+    std::optional<uint64_t> counter_key_;
+
+    // Disorder management: rows are generated into window slots and handed out
+    // in key order once no later row can precede them; the rest are held for
+    // the next refill, so a latency is never cut at a window boundary
+    struct WindowBuffers {
+        std::vector<char> flags;
+        std::vector<char> data;             // Fixed values, or cap bytes per row of var data
+        std::vector<int32_t> lengths;
+        std::vector<size_t> offsets;
+    };
+
+    DisorderEngine disorder_;
+    std::vector<RowData> window_;
+    std::vector<MemoryPool::TableBase::Column> window_columns_;    // Views of window_buffers_
+    std::vector<WindowBuffers> window_buffers_;
+    size_t window_capacity_ = 0;            // Rows the window columns hold
+    std::vector<int64_t> window_timestamps_;
+    std::vector<int64_t> window_keys_;
+    std::vector<char> window_delayed_;
+    std::vector<uint32_t> window_order_;    // Deliverable rows in delivery order
+    std::vector<uint32_t> window_held_;     // Rows kept for the next refill, ascending
+    size_t window_pos_ = 0;
 
     // Timestamp state
     int64_t current_timestamp_ = 0;
@@ -7,35 +7,27 @@
 #include <optional>
 #include <atomic>
 #include "RowDataGenerator.hpp"
+#include "TableStateStore.hpp"
+#include "TableNameList.hpp"
+#include "TableCatalog.hpp"
 #include "InsertDataConfig.hpp"
 #include "RateLimiter.hpp"
 #include "MemoryPool.hpp"
 
 class TableDataManager {
 public:
-    struct TableState {
-        std::string table_name;
-        std::unique_ptr<RowDataGenerator> generator;
-        int64_t rows_generated = 0;         // Total rows generated for this table
-        int64_t interlace_counter = 0;      // Current row count in interlace mode
-        bool completed = false;             // Whether this table is completed
-        const MemoryPool::TableBlock::Tags* tags_ptr = nullptr;
-
-        TableState(const TableState&) = delete;
-        TableState& operator=(const TableState&) = delete;
-
-        TableState(TableState&&) = default;
-        TableState& operator=(TableState&&) = default;
-
-        TableState() = default;
-    };
-
     explicit TableDataManager(MemoryPool& pool,
                               const InsertDataConfig& config,
                               const ColumnConfigInstanceVector& col_instances,
                               const ColumnConfigInstanceVector& tag_instances);
+    ~TableDataManager();
+
+    TableDataManager(const TableDataManager&) = delete;
+    TableDataManager& operator=(const TableDataManager&) = delete;
 
-    // Initialize the table data manager
+    // Initialize the table data manager; table_names is a slice of the
+    // catalog's names when a catalog is given, and tags are taken from it
+    bool init(const TableNameList& table_names, const TableCatalog* catalog = nullptr);
     bool init(const std::vector<std::string>& table_names);
 
     // Get the next batch of data
@@ -48,7 +40,7 @@ public:
     std::string current_table() const;
 
     // Get table states
-    const std::vector<TableState>&  table_states() const;
+    const TableStateStore& table_states() const;
 
     // Acquire tokens for flow control
     void acquire_tokens(int64_t tokens);
@@ -62,21 +54,42 @@ private:
     const InsertDataConfig& config_;
     const ColumnConfigInstanceVector& col_instances_;
     const ColumnConfigInstanceVector& tag_instances_;
-    std::vector<TableState> table_states_;
+    TableStateStore table_states_;
+
+    // One generator for all tables when the columns allow it (their state lives
+    // in table_states_), otherwise one per table
+    std::unique_ptr<RowDataGenerator> shared_generator_;
+    std::vector<std::unique_ptr<RowDataGenerator>> generators_;
     size_t prev_table_index_ = 0;
-    size_t current_table_index_ = 0;            // Current table index
+    size_t current_table_index_ = 0;            // Current table index, always on the active ring
+    size_t previous_active_index_ = 0;          // Ring predecessor of the current table
     size_t active_table_count_ = 0;             // Count of active tables with data available
     int64_t interlace_rows_ = 1;                // Number of rows to generate per table in interlace mode
     size_t sequence_num_ = 0;
+    size_t block_cache_ = MemoryPool::NO_BLOCK_CACHE;   // Blocks this producer filled come back here
+
+    void release_block_cache();
 
     // Generate tag values for a given table
     std::vector<ColumnType> generate_tags_for_table(const std::string& table_name);
 
-    // Get the next table with available data
-    TableState* get_next_active_table();
+    // Whether a table can still produce rows
+    bool table_has_more(size_t table) const;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Get the next table with available data, or npos; tables found dry on
+    // the way are completed
+    size_t get_next_active_table();
+
+    // Calculate number of rows to generate for a table
+    size_t calculate_rows_to_generate(size_t table) const;
+
+    // Generate up to rows rows of a table into its block slot
+    size_t generate_rows(size_t table, MemoryPool::TableBlock& table_block, size_t rows);
 
-    // Calculate number of rows to generate for current table
-    size_t calculate_rows_to_generate(TableState& state) const;
+    // Mark the current table as completed and unlink it from the active ring
+    void complete_current_table();
 
     // Switch to the next table
     void advance_to_next_table();
@@ -6,29 +6,38 @@
 #include <stdexcept>
 #include "InsertDataConfig.hpp"
 #include "TableNameGenerator.hpp"
+#include "TableNameList.hpp"
 #include "TableNameCSVReader.hpp"
+#include "TableCatalog.hpp"
 
 class TableNameManager {
 public:
     explicit TableNameManager(const InsertDataConfig& config);
 
-    // Generate all table names based on config
-    std::vector<std::string> generate_table_names();
+    // Generate all table names based on config; they come from the job's
+    // shared catalog
+    const TableNameList& generate_table_names();
 
-    // Split table names based on thread allocation strategy
-    std::vector<std::vector<std::string>> split_for_threads();
+    // Catalog the names came from, null before generate_table_names()
+    const std::shared_ptr<const TableCatalog>& catalog() const { return catalog_; }
+    // Stop holding the catalog; the names stay valid
+    void release_catalog() { catalog_.reset(); }
+
+    // Split table names based on thread allocation strategy; slices share storage
+    std::vector<TableNameList> split_for_threads();
 
     size_t chunk_size() const { return chunk_size_; }
 
 private:
     const InsertDataConfig& config_;
-    std::vector<std::string> table_names_;
+    std::shared_ptr<const TableCatalog> catalog_;
+    TableNameList table_names_;
     size_t chunk_size_;
 
     // Split methods for different strategies
-    std::vector<std::vector<std::string>> split_by_index_range();
-    std::vector<std::vector<std::string>> split_by_vgroup_binding();
+    std::vector<TableNameList> split_by_index_range();
+    std::vector<TableNameList> split_by_vgroup_binding();
 
     // Helper method to perform equal splits
-    std::vector<std::vector<std::string>> split_equally(size_t thread_count);
+    std::vector<TableNameList> split_equally(size_t thread_count);
 };
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MemoryPool.hpp"
+#include "TableNameList.hpp"
+
+// Generation state of many tables in structure-of-arrays form, indexed by
+// table id. Table id i is name i of the store's TableNameList slice, which
+// shares the list's storage; names are looked up or formatted on demand.
+// Column model state is kept as column_state_words int64 slots per table,
+// laid out back to back. Tables are linked in id order into a circular
+// ring through next_active, from which the manager unlinks finished tables.
+class TableStateStore {
+public:
+    // Read-only view of one table
+    struct View {
+        std::string table_name;
+        int64_t rows_generated;
+        int64_t interlace_counter;
+        bool completed;
+    };
+
+    class const_iterator {
+    public:
+        const_iterator(const TableStateStore& store, size_t index) : store_(&store), index_(index) {}
+
+        View operator*() const { return (*store_)[index_]; }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const TableStateStore* store_;
+        size_t index_;
+    };
+
+    // Drop all tables and reserve room for those of names
+    void reset(const TableNameList& names, bool with_stream_keys);
+
+    // Append the next table of the names, link it at the end of the ring and
+    // return its id
+    size_t add(uint64_t stream_key = 0);
+
+    // Give every table state_words zeroed column state slots
+    void init_column_states(size_t state_words);
+
+    size_t size() const { return rows_generated.size(); }
+    bool empty() const { return rows_generated.empty(); }
+
+    const TableNameList& names() const { return names_; }
+
+    // Name of table; the view may point into buffer
+    std::string_view table_name(size_t table, std::string& buffer) const {
+        return names_.at(table, buffer);
+    }
+    const char* table_name_cstr(size_t table, std::string& buffer) const {
+        return names_.c_str(table, buffer);
+    }
+
+    View operator[](size_t table) const {
+        return View{names_[table], rows_generated[table], interlace_counters[table], completed[table] != 0};
+    }
+
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+    int64_t* column_state(size_t table) {
+        return column_states.data() + table * column_state_words;
+    }
+    const int64_t* column_state(size_t table) const {
+        return column_states.data() + table * column_state_words;
+    }
+
+    std::vector<const MemoryPool::TableBlock::Tags*> tags;
+    std::vector<int64_t> rows_generated;
+    std::vector<int64_t> interlace_counters;
+    std::vector<uint8_t> completed;
+    std::vector<int64_t> timestamp_cursors;     // Next timestamp, generator precision
+    std::vector<uint64_t> stream_keys;          // Counter-mode keys, empty unless seeded
+    std::vector<int64_t> column_states;
+    std::vector<uint32_t> next_active;          // Next table of the active ring
+    size_t column_state_words = 0;
+
+private:
+    TableNameList names_;
+    bool with_stream_keys_ = false;
+};
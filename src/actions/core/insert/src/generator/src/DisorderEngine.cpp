@@ -0,0 +1,64 @@
+#include "DisorderEngine.hpp"
+#include "RandomKernels.hpp"
+#include "TimestampUtils.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr size_t CHUNK = 256;
+}
+
+DisorderEngine::DisorderEngine(const GenerationConfig::DataDisorder& config, const std::string& precision) {
+    if (!config.enabled) return;
+
+    for (const auto& interval : config.intervals) {
+        if (interval.ratio <= 0 || interval.latency_range <= 0) continue;
+        intervals_.push_back(Interval{
+            TimestampUtils::parse_timestamp(interval.time_start, precision),
+            TimestampUtils::parse_timestamp(interval.time_end, precision),
+            std::min(interval.ratio, 1.0),
+            interval.latency_range
+        });
+    }
+}
+
+int64_t DisorderEngine::max_latency() const {
+    int64_t latency = 0;
+    for (const auto& interval : intervals_) {
+        latency = std::max(latency, interval.latency_range - 1);
+    }
+    return latency;
+}
+
+void DisorderEngine::draw_keys(const int64_t* timestamps, size_t count, int64_t* keys, char* delayed) const {
+    std::copy(timestamps, timestamps + count, keys);
+    std::fill(delayed, delayed + count, 0);
+
+    // Coin flips and latencies drawn a chunk at a time
+    double coins[CHUNK];
+    int64_t latencies[CHUNK];
+    for (const auto& interval : intervals_) {
+        for (size_t done = 0; done < count; done += CHUNK) {
+            const size_t n = std::min(CHUNK, count - done);
+            RandomKernels::fill_uniform(coins, n, 0.0, 1.0);
+            RandomKernels::fill_bounded(latencies, n, 0, interval.latency_range - 1);
+
+            for (size_t i = 0; i < n; ++i) {
+                const size_t row = done + i;
+                const int64_t ts = timestamps[row];
+                if (delayed[row] || ts < interval.start_time || ts >= interval.end_time) continue;
+                if (coins[i] < interval.ratio) {
+                    keys[row] = ts + latencies[i];
+                    delayed[row] = 1;
+                }
+            }
+        }
+    }
+}
+
+void DisorderEngine::sort(uint32_t* rows, size_t count, const int64_t* keys, const char* delayed) {
+    std::sort(rows, rows + count, [&](uint32_t a, uint32_t b) {
+        if (keys[a] != keys[b]) return keys[a] < keys[b];
+        if (delayed[a] != delayed[b]) return delayed[a] < delayed[b];
+        return a < b;
+    });
+}
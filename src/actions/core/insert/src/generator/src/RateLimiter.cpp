@@ -8,6 +8,12 @@ RateLimiter::RateLimiter(int64_t rate_limit)
 
 void RateLimiter::acquire(int64_t tokens) {
     using namespace std::chrono;
+
+    // The bucket never holds more than rate_limit_ tokens, serve larger requests in chunks
+    while (rate_limit_ > 0 && tokens > rate_limit_) {
+        acquire(rate_limit_);
+        tokens -= rate_limit_;
+    }
     auto now = steady_clock::now();
     auto elapsed = duration_cast<milliseconds>(now - last_time_).count();
     
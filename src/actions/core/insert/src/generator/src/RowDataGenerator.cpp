@@ -2,9 +2,37 @@
 #include "StringUtils.hpp"
 #include "CSVDataManager.hpp"
 #include <stdexcept>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// Copy rows[i] of from to row start + i of to, appending var data at to's
+// current offset. from and to may be the same column when rows ascend and
+// start is not past them
+static void copy_column_rows(const MemoryPool::TableBase::Column& from, MemoryPool::TableBase::Column& to,
+                             const uint32_t* rows, size_t count, size_t start) {
+    if (from.is_fixed) {
+        const size_t size = from.element_size;
+        const char* src = static_cast<const char*>(from.fixed_data);
+        char* dst = static_cast<char*>(to.fixed_data);
+        for (size_t i = 0; i < count; ++i) {
+            to.is_nulls[start + i] = from.is_nulls[rows[i]];
+            std::memmove(dst + (start + i) * size, src + rows[i] * size, size);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t row = rows[i];
+        const int32_t length = from.lengths[row];
+        const size_t offset = from.var_offsets[row];
+        to.is_nulls[start + i] = from.is_nulls[row];
+        to.lengths[start + i] = length;
+        to.var_offsets[start + i] = to.current_offset;
+        std::memmove(to.reserve_var(length), from.var_data + offset, length);
+        to.current_offset += length;
+    }
+}
 
 
 RowDataGenerator::RowDataGenerator(const std::string& table_name,
@@ -16,7 +44,12 @@ RowDataGenerator::RowDataGenerator(const std::string& table_name,
       columns_config_(config.schema.columns_cfg),
       instances_(instances),
       target_precision_(config.timestamp_precision),
-      use_cache_(use_cache) {
+      use_cache_(use_cache),
+      disorder_(config.schema.generation.data_disorder, config.timestamp_precision) {
+
+    if (const auto& seed = config_.schema.generation.seed) {
+        counter_key_ = RandomKernels::stream_key(*seed, table_name_);
+    }
 
     init_cached_row();
     init_raw_source();
@@ -24,10 +57,6 @@ RowDataGenerator::RowDataGenerator(const std::string& table_name,
     // if (config_.schema.generation.data_cache.enabled) {
     //     init_cache();
     // }
-
-    if (config_.schema.generation.data_disorder.enabled) {
-        init_disorder();
-    }
 }
 
 // Initialize cached row memory
@@ -84,19 +113,6 @@ void RowDataGenerator::init_cache() {
     }
 }
 
-void RowDataGenerator::init_disorder() {
-    // Initialize disorder intervals
-    disorder_intervals_.clear();
-    for (const auto& interval : config_.schema.generation.data_disorder.intervals) {
-        DisorderInterval disorder_interval;
-        disorder_interval.start_time = TimestampUtils::parse_timestamp(interval.time_start, target_precision_);
-        disorder_interval.end_time = TimestampUtils::parse_timestamp(interval.time_end, target_precision_);
-        disorder_interval.ratio = interval.ratio;
-        disorder_interval.latency_range = interval.latency_range;
-        disorder_intervals_.push_back(disorder_interval);
-    }
-}
-
 void RowDataGenerator::init_raw_source() {
     if (columns_config_.source_type == "generator") {
         init_generator();
@@ -122,6 +138,10 @@ void RowDataGenerator::init_raw_source() {
             columns_config_.csv.timestamp_strategy.generator
         );
     }
+    if (timestamp_generator_) {
+        timestamp_converter_ = TimestampUtils::PrecisionConverter(
+            timestamp_generator_->timestamp_precision(), target_precision_);
+    }
 }
 
 void RowDataGenerator::init_generator() {
@@ -130,6 +150,17 @@ void RowDataGenerator::init_generator() {
     // Create row generator
     if (!use_cache_) {
         row_generator_ = std::make_unique<RowGenerator>(table_name_, instances_);
+
+        bool any_nulls = false;
+        std::vector<NullGenerator> null_generators;
+        null_generators.reserve(instances_.size());
+        for (const auto& instance : instances_) {
+            null_generators.emplace_back(instance.config());
+            any_nulls |= null_generators.back().enabled();
+        }
+        if (any_nulls) {
+            null_generators_ = std::move(null_generators);
+        }
     }
 }
 
@@ -180,9 +211,6 @@ std::optional<RowData> RowDataGenerator::next_row() {
         return std::nullopt;
     }
 
-    // Process delay queue
-    process_delay_queue();
-
     // Prefer to get data from cache
     if (!cache_.empty()) {
         auto row = cache_.back();
@@ -191,22 +219,14 @@ std::optional<RowData> RowDataGenerator::next_row() {
         return row;
     }
 
-    // Get data from raw source
-    auto row_opt = fetch_raw_row();
-    if (!row_opt) {
+    RowData* row = next_raw_row();
+    if (!row) {
         return std::nullopt;
     }
 
-    // Update current timeline
-    current_timestamp_ = row_opt->get().timestamp;
-
-    // Apply disorder strategy
-    auto delayed = apply_disorder(*row_opt);
-    if (!delayed) {
-        generated_rows_++;
-    }
-
-    return row_opt;
+    current_timestamp_ = row->timestamp;
+    generated_rows_++;
+    return *row;
 }
 
 int RowDataGenerator::next_row(MemoryPool::TableBlock& table_block) {
@@ -214,9 +234,6 @@ int RowDataGenerator::next_row(MemoryPool::TableBlock& table_block) {
         return 0;
     }
 
-    // Process delay queue
-    process_delay_queue();
-
     // Prefer to get data from cache
     if (!cache_.empty()) {
         auto row = cache_.back();
@@ -228,69 +245,341 @@ int RowDataGenerator::next_row(MemoryPool::TableBlock& table_block) {
         return 1;
     }
 
-    // Get data from raw source
-    auto row_opt = fetch_raw_row();
-    if (!row_opt) {
+    RowData* row = next_raw_row();
+    if (!row) {
         return 0;
     }
 
-    // Update timeline
-    current_timestamp_ = row_opt->get().timestamp;
-
-    // Apply disorder strategy
-    bool delayed = apply_disorder(*row_opt);
-    if (delayed) {
-        return -1;
-    }
-
     // Write directly to memory pool
+    current_timestamp_ = row->timestamp;
     generated_rows_++;
-    table_block.add_row(*row_opt);
+    table_block.add_row(*row);
 
     return 1;
 }
 
-bool RowDataGenerator::apply_disorder(RowData& row) {
-    if (!config_.schema.generation.data_disorder.enabled) {
-        return false;
+RowData* RowDataGenerator::next_raw_row() {
+    if (!disorder_.enabled()) {
+        auto row_opt = fetch_raw_row();
+        return row_opt ? &row_opt->get() : nullptr;
+    }
+
+    while (window_pos_ == window_order_.size()) {
+        if (!refill_window()) {
+            return nullptr;
+        }
+    }
+    return &window_[window_order_[window_pos_++]];
+}
+
+bool RowDataGenerator::refill_window() {
+    // Held rows move to the front; slots take the shape of cached_row_ once and
+    // are swapped with it afterwards, so no row is ever copied
+    const size_t held = window_held_.size();
+    for (size_t i = 0; i < held; ++i) {
+        std::swap(window_[i], window_[window_held_[i]]);
+    }
+    hold_window_rows();
+
+    const size_t fresh = static_cast<size_t>(std::min<int64_t>(DISORDER_WINDOW, total_rows_ - fetched_rows_));
+    if (window_.size() < held + fresh) {
+        window_.resize(held + fresh, cached_row_);
+    }
+    window_timestamps_.resize(held + fresh);
+
+    const int64_t first_row = fetched_rows_;
+    size_t filled = 0;
+    for (; filled < fresh; ++filled) {
+        if (!fetch_raw_row()) break;
+        std::swap(window_[held + filled], cached_row_);
+        window_timestamps_[held + filled] = window_[held + filled].timestamp;
     }
 
-    // Check if data timestamp is in disorder interval
-    for (const auto& interval : disorder_intervals_) {
-        if (row.timestamp >= interval.start_time && row.timestamp < interval.end_time) {
-            // Decide whether to delay by probability
-            if (static_cast<double>(rand()) / RAND_MAX < interval.ratio) {
-                int latency = rand() % interval.latency_range;
-                int64_t deliver_time = row.timestamp + latency;
+    if (filled < fresh) {
+        total_rows_ = fetched_rows_;
+    }
+
+    plan_window(held, filled, first_row);
+    return held + filled > 0;
+}
+
+bool RowDataGenerator::refill_column_window() {
+    const size_t held = window_held_.size();
+    for (auto& col : window_columns_) {
+        col.current_offset = 0;
+        copy_column_rows(col, col, window_held_.data(), held, 0);
+    }
+    hold_window_rows();
+
+    const size_t fresh = static_cast<size_t>(std::min<int64_t>(DISORDER_WINDOW, total_rows_ - fetched_rows_));
+    reserve_window_columns(held + fresh);
+
+    const int64_t first_row = fetched_rows_;
+    if (fresh > 0) {
+        generate_rows(window_timestamps_.data(), use_cache_ ? nullptr : window_columns_.data(), held, fresh, first_row);
+        fetched_rows_ += static_cast<int64_t>(fresh);
+    }
+
+    plan_window(held, fresh, first_row);
+    return held + fresh > 0;
+}
 
-                // Put into delay queue
-                delay_queue_.push(DelayedRow{deliver_time, row});
-                row.timestamp = -1;
-                return true;
+void RowDataGenerator::hold_window_rows() {
+    for (size_t i = 0; i < window_held_.size(); ++i) {
+        const uint32_t row = window_held_[i];
+        window_timestamps_[i] = window_timestamps_[row];
+        window_keys_[i] = window_keys_[row];
+        window_delayed_[i] = window_delayed_[row];
+    }
+}
+
+void RowDataGenerator::plan_window(size_t held, size_t fresh, int64_t first_row) {
+    const size_t rows = held + fresh;
+    window_keys_.resize(std::max(window_keys_.size(), rows));
+    window_delayed_.resize(std::max(window_delayed_.size(), rows));
+
+    if (fresh > 0) {
+        RandomKernels::CounterScope scope(counter_key_);
+        scope.seek(static_cast<uint64_t>(first_row), DISORDER_STREAM);
+        disorder_.draw_keys(window_timestamps_.data() + held, fresh,
+                            window_keys_.data() + held, window_delayed_.data() + held);
+    }
+
+    // Later rows are no earlier than the newest one here, so rows keyed before
+    // it, or at it without a delay, keep their place; the rest wait
+    const bool last = fetched_rows_ >= total_rows_;
+    const int64_t newest = rows > 0 ? window_timestamps_[rows - 1] : 0;
+    window_order_.clear();
+    window_held_.clear();
+    for (uint32_t i = 0; i < rows; ++i) {
+        const int64_t key = window_keys_[i];
+        if (last || key < newest || (key == newest && !window_delayed_[i])) {
+            window_order_.push_back(i);
+        } else {
+            window_held_.push_back(i);
+        }
+    }
+    DisorderEngine::sort(window_order_.data(), window_order_.size(), window_keys_.data(), window_delayed_.data());
+    window_pos_ = 0;
+}
+
+void RowDataGenerator::reserve_window_columns(size_t rows) {
+    window_timestamps_.resize(std::max(window_timestamps_.size(), rows));
+    if (rows <= window_capacity_ || use_cache_) {
+        return;
+    }
+    window_capacity_ = std::max(rows, 2 * window_capacity_);
+
+    // Vectors keep the held rows when they grow; the views are re-pointed
+    if (window_columns_.empty()) {
+        window_columns_.resize(instances_.size());
+        window_buffers_.resize(instances_.size());
+        for (size_t i = 0; i < instances_.size(); ++i) {
+            const auto& config = instances_[i].config();
+            auto& col = window_columns_[i];
+            col.is_fixed = !config.is_var_length();
+            col.element_size = col.is_fixed ? config.get_fixed_type_size() : 0;
+            col.max_length = col.is_fixed ? col.element_size : static_cast<size_t>(config.cap.value());
+        }
+    }
+    for (size_t i = 0; i < window_columns_.size(); ++i) {
+        auto& col = window_columns_[i];
+        auto& buffers = window_buffers_[i];
+        buffers.flags.resize(window_capacity_);
+        col.is_nulls = buffers.flags.data();
+        if (col.is_fixed) {
+            buffers.data.resize(window_capacity_ * col.element_size);
+            col.fixed_data = buffers.data.data();
+        } else {
+            buffers.data.resize(window_capacity_ * col.max_length);
+            buffers.lengths.resize(window_capacity_);
+            buffers.offsets.resize(window_capacity_);
+            col.var_data = buffers.data.data();
+            col.var_capacity = buffers.data.size();
+            col.lengths = buffers.lengths.data();
+            col.var_offsets = buffers.offsets.data();
+        }
+    }
+}
+
+size_t RowDataGenerator::next_window_rows(MemoryPool::TableBlock& table_block, size_t start, size_t rows) {
+    size_t written = 0;
+    while (written < rows) {
+        if (window_pos_ == window_order_.size()) {
+            if (!refill_column_window()) break;
+            continue;
+        }
+
+        const size_t count = std::min(rows - written, window_order_.size() - window_pos_);
+        const uint32_t* order = window_order_.data() + window_pos_;
+        int64_t* timestamps = table_block.timestamps + start + written;
+        for (size_t i = 0; i < count; ++i) {
+            timestamps[i] = window_timestamps_[order[i]];
+        }
+        if (!use_cache_) {
+            for (size_t col_idx = 0; col_idx < window_columns_.size(); ++col_idx) {
+                copy_column_rows(window_columns_[col_idx], table_block.columns[col_idx], order, count, start + written);
             }
         }
+        window_pos_ += count;
+        written += count;
     }
-    return false;
+    return written;
+}
+
+bool RowDataGenerator::supports_batch() const {
+    return use_generator_ && cache_.empty();
 }
 
-void RowDataGenerator::process_delay_queue() {
-    while (!delay_queue_.empty() && delay_queue_.top().deliver_timestamp <= current_timestamp_) {
-        cache_.push_back(delay_queue_.top().row);
-        delay_queue_.pop();
+size_t RowDataGenerator::next_rows(MemoryPool::TableBlock& table_block, size_t count) {
+    const size_t start = table_block.used_rows;
+    size_t rows = std::min({
+        count,
+        static_cast<size_t>(std::max<int64_t>(total_rows_ - generated_rows_, 0)),
+        table_block.max_rows - start
+    });
+    if (rows == 0) {
+        return 0;
+    }
+
+    if (disorder_.enabled()) {
+        rows = next_window_rows(table_block, start, rows);
+    } else {
+        generate_rows(table_block.timestamps, use_cache_ ? nullptr : table_block.columns.data(), start, rows, generated_rows_);
+        fetched_rows_ += static_cast<int64_t>(rows);
+    }
+    if (rows == 0) {
+        return 0;
+    }
+
+    table_block.used_rows += rows;
+    generated_rows_ += rows;
+    current_timestamp_ = table_block.timestamps[start + rows - 1];
+
+    return rows;
+}
+
+void RowDataGenerator::generate_rows(int64_t* timestamps, MemoryPool::TableBase::Column* columns, size_t start, size_t rows,
+                                     int64_t first_row) {
+    RandomKernels::CounterScope scope(counter_key_);
+
+    // Timestamps
+    timestamps += start;
+    if (scope.active()) {
+        for (size_t i = 0; i < rows; ++i) {
+            scope.seek(static_cast<uint64_t>(first_row) + i, TIMESTAMP_STREAM);
+            timestamp_generator_->fill(timestamps + i, 1);
+        }
+    } else {
+        timestamp_generator_->fill(timestamps, rows);
+    }
+    timestamp_converter_.apply(timestamps, rows);
+
+    // In cache mode the block already carries column data, only timestamps are written
+    if (!columns) {
+        return;
+    }
+    for (size_t col_idx = 0; col_idx < instances_.size(); ++col_idx) {
+        if (scope.active()) {
+            fill_column_seeded(columns[col_idx], col_idx, start, rows, scope, first_row);
+        } else {
+            fill_column(columns[col_idx], col_idx, start, rows);
+        }
+    }
+}
+
+void RowDataGenerator::fill_column(MemoryPool::TableBase::Column& col, size_t col_idx, size_t start, size_t rows) {
+    const auto& gen = row_generator_->column_generators()[col_idx];
+    char* flags = col.is_nulls + start;
+
+    // Only rows with a value are generated; they are written packed and then
+    // moved back to front into their row slots
+    size_t values = rows;
+    if (null_generators_.empty()) {
+        std::memset(flags, CELL_VALUE, rows);
+    } else {
+        values = null_generators_[col_idx].fill(flags, rows);
+    }
+
+    if (col.is_fixed) {
+        char* data = static_cast<char*>(col.fixed_data) + start * col.element_size;
+        gen->fill(data, values);
+
+        size_t src = values;
+        for (size_t i = rows; i > src; ) {
+            --i;
+            if (flags[i] == CELL_VALUE) {
+                --src;
+                std::memcpy(data + i * col.element_size, data + src * col.element_size, col.element_size);
+            }
+        }
+    } else {
+        // Generated in pieces whose worst case fits the column's var data in
+        // place, so an arena segment is not reserved at cap bytes per row
+        int32_t* lengths = col.lengths + start;
+        const size_t base = col.current_offset;
+        const size_t max_length = std::max<size_t>(1, col.max_length);
+        for (size_t done = 0; done < values; ) {
+            const size_t count = std::min(values - done, std::max<size_t>(1, col.var_room() / max_length));
+            gen->fill(col.reserve_var(count * col.max_length), lengths + done, col.max_length, count);
+            for (size_t i = 0; i < count; ++i) {
+                col.current_offset += lengths[done + i];
+            }
+            done += count;
+        }
+        col.current_offset = base;
+
+        size_t src = values;
+        for (size_t i = rows; i > 0; ) {
+            --i;
+            lengths[i] = flags[i] == CELL_VALUE ? lengths[--src] : 0;
+        }
+
+        for (size_t i = start; i < start + rows; ++i) {
+            col.var_offsets[i] = col.current_offset;
+            col.current_offset += col.lengths[i];
+        }
+    }
+}
+
+void RowDataGenerator::fill_column_seeded(MemoryPool::TableBase::Column& col, size_t col_idx, size_t start, size_t rows,
+                                          RandomKernels::CounterScope& scope, int64_t first_row) {
+    const auto& gen = row_generator_->column_generators()[col_idx];
+    char* flags = col.is_nulls + start;
+
+    for (size_t i = 0; i < rows; ++i) {
+        scope.seek(static_cast<uint64_t>(first_row) + i, static_cast<uint32_t>(col_idx));
+        flags[i] = null_generators_.empty() ? CELL_VALUE : null_generators_[col_idx].next();
+
+        if (col.is_fixed) {
+            if (flags[i] == CELL_VALUE) {
+                gen->fill(static_cast<char*>(col.fixed_data) + (start + i) * col.element_size, 1);
+            }
+        } else {
+            int32_t length = 0;
+            if (flags[i] == CELL_VALUE) {
+                gen->fill(col.reserve_var(col.max_length), &length, col.max_length, 1);
+            }
+            col.lengths[start + i] = length;
+            col.var_offsets[start + i] = col.current_offset;
+            col.current_offset += length;
+        }
     }
 }
 
 std::optional<std::reference_wrapper<RowData>> RowDataGenerator::fetch_raw_row() {
     try {
+        RandomKernels::CounterScope scope(counter_key_);
         if (use_generator_) {
-            generate_from_generator();
+            generate_from_generator(scope);
         } else {
-            if (!generate_from_csv()) {
+            if (!generate_from_csv(scope)) {
                 total_rows_ = generated_rows_;
                 return std::nullopt;
             }
         }
 
+        fetched_rows_++;
         return cached_row_;
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Error generating row: ") + e.what());
@@ -303,31 +592,111 @@ bool RowDataGenerator::has_more() const {
 
 void RowDataGenerator::reset() {
     generated_rows_ = 0;
+    fetched_rows_ = 0;
     csv_row_index_ = 0;
+    window_order_.clear();
+    window_held_.clear();
+    window_pos_ = 0;
 
     if (timestamp_generator_) {
         timestamp_generator_->reset();
     }
 }
 
-void RowDataGenerator::generate_from_generator() {
+bool RowDataGenerator::shareable(const InsertDataConfig& config, const ColumnConfigInstanceVector& instances) {
+    if (config.schema.columns_cfg.source_type != "generator") {
+        return false;
+    }
+
+    // The disorder window belongs to one table
+    if (DisorderEngine(config.schema.generation.data_disorder, config.timestamp_precision).enabled()) {
+        return false;
+    }
+    return std::none_of(instances.begin(), instances.end(), [](const ColumnConfigInstance& instance) {
+        return instance.config().gen_type == "expression";
+    });
+}
+
+size_t RowDataGenerator::state_words() const {
+    size_t words = 0;
+    if (row_generator_) {
+        for (const auto& gen : row_generator_->column_generators()) {
+            words += gen->state_words();
+        }
+    }
+    return words;
+}
+
+void RowDataGenerator::load_state(const TableStateStore& store, size_t table) {
+    generated_rows_ = store.rows_generated[table];
+    fetched_rows_ = generated_rows_;
+    timestamp_generator_->seek(store.timestamp_cursors[table]);
+    if (!store.stream_keys.empty()) {
+        counter_key_ = store.stream_keys[table];
+    }
+
+    if (row_generator_) {
+        const int64_t* state = store.column_state(table);
+        for (const auto& gen : row_generator_->column_generators()) {
+            gen->load_state(state);
+            state += gen->state_words();
+        }
+    }
+}
+
+void RowDataGenerator::save_state(TableStateStore& store, size_t table) const {
+    store.timestamp_cursors[table] = timestamp_generator_->position();
+
+    if (row_generator_) {
+        int64_t* state = store.column_state(table);
+        for (const auto& gen : row_generator_->column_generators()) {
+            gen->save_state(state);
+            state += gen->state_words();
+        }
+    }
+}
+
+void RowDataGenerator::generate_from_generator(RandomKernels::CounterScope& scope) {
+    const uint64_t row = static_cast<uint64_t>(fetched_rows_);
+
     // Generate timestamp
-    cached_row_.timestamp = TimestampUtils::convert_timestamp_precision(timestamp_generator_->generate(),
-        timestamp_generator_->timestamp_precision(), target_precision_);
+    scope.seek(row, TIMESTAMP_STREAM);
+    cached_row_.timestamp = timestamp_converter_(timestamp_generator_->generate());
 
-    if (!use_cache_) {
-        // Generate column data
-        row_generator_->generate(cached_row_.columns);
+    if (use_cache_) {
+        return;
     }
 
-    return;
+    if (!null_generators_.empty()) {
+        cached_row_.nulls.resize(null_generators_.size());
+    }
+
+    if (scope.active()) {
+        // Cell by cell, each at its own counter position
+        const auto& gens = row_generator_->column_generators();
+        for (size_t i = 0; i < gens.size(); ++i) {
+            scope.seek(row, static_cast<uint32_t>(i));
+            if (!null_generators_.empty()) {
+                cached_row_.nulls[i] = null_generators_[i].next();
+            }
+            cached_row_.columns[i] = gens[i]->generate();
+        }
+        return;
+    }
+
+    // Generate column data
+    row_generator_->generate(cached_row_.columns);
+
+    for (size_t i = 0; i < cached_row_.nulls.size(); ++i) {
+        cached_row_.nulls[i] = null_generators_[i].next();
+    }
 }
 
-bool RowDataGenerator::generate_from_csv() {
+bool RowDataGenerator::generate_from_csv(RandomKernels::CounterScope& scope) {
     const auto& rows = csv_rows();
     if (timestamp_generator_) {
-        cached_row_.timestamp = TimestampUtils::convert_timestamp_precision(timestamp_generator_->generate(),
-            timestamp_generator_->timestamp_precision(), target_precision_);
+        scope.seek(static_cast<uint64_t>(fetched_rows_), TIMESTAMP_STREAM);
+        cached_row_.timestamp = timestamp_converter_(timestamp_generator_->generate());
     } else {
         cached_row_.timestamp = rows[csv_row_index_].timestamp;
     }
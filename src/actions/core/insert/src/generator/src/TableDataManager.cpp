@@ -8,7 +8,8 @@ TableDataManager::TableDataManager(MemoryPool& pool,
                                    const InsertDataConfig& config,
                                    const ColumnConfigInstanceVector& col_instances,
                                    const ColumnConfigInstanceVector& tag_instances)
-    : pool_(pool), config_(config), col_instances_(col_instances), tag_instances_(tag_instances) {
+    : pool_(pool), config_(config), col_instances_(col_instances), tag_instances_(tag_instances),
+      block_cache_(pool.attach_block_cache()) {
 
     // Set interlace rows
     if (config_.schema.generation.interlace_mode.enabled) {
@@ -26,51 +27,77 @@ TableDataManager::TableDataManager(MemoryPool& pool,
 }
 
 bool TableDataManager::init(const std::vector<std::string>& table_names) {
+    return init(TableNameList::intern(table_names));
+}
+
+bool TableDataManager::init(const TableNameList& table_names, const TableCatalog* catalog) {
     if (table_names.empty()) {
         LogUtils::error("TableDataManager initialized with empty table list");
         return false;
     }
 
     active_table_count_ = table_names.size();
-    table_states_.clear();
-    table_states_.reserve(table_names.size());
+    shared_generator_.reset();
+    generators_.clear();
+
+    const auto& seed = config_.schema.generation.seed;
+    const bool shared = RowDataGenerator::shareable(config_, col_instances_);
+    table_states_.reset(table_names, shared && seed.has_value());
 
     try {
-        // Create RowDataGenerator for each table
-        for (const auto& table_name : table_names) {
-            TableState state;
-            try {
-                state.table_name = table_name;
-                state.generator = std::make_unique<RowDataGenerator>(
-                    table_name,
-                    config_,
-                    col_instances_,
-                    pool_.is_cache_mode()
-                );
-                state.rows_generated = 0;
-                state.interlace_counter = 0;
-                state.completed = false;
-
-                if (tag_instances_.size() > 0
-                    && config_.data_format.support_tags
-                    && config_.schema.tags_cfg.source_type == "generator"
-                ) {
-                    std::vector<ColumnType> tag_values = generate_tags_for_table(table_name);
-                    state.tags_ptr = pool_.register_table_tags(table_name, tag_values);
+        const bool with_tags = tag_instances_.size() > 0
+            && config_.data_format.support_tags
+            && config_.schema.tags_cfg.source_type == "generator";
+
+        std::string buffer;
+        for (size_t i = 0; i < table_names.size(); ++i) {
+            const std::string_view table_name = table_names.at(i, buffer);
+            const size_t table = table_states_.add(seed ? RandomKernels::stream_key(*seed, table_name) : 0);
+
+            if (with_tags) {
+                const std::string name(table_name);
+                if (catalog && catalog->has_tags()) {
+                    table_states_.tags[table] = pool_.intern_table_tags(catalog->tags(table_names.offset() + i), name);
+                } else {
+                    std::vector<ColumnType> tag_values = generate_tags_for_table(name);
+                    table_states_.tags[table] = pool_.intern_table_tags(tag_values, name);
                 }
+            }
+        }
 
-                table_states_.push_back(std::move(state));
-            } catch (const std::exception& e) {
-                // std::cerr << "Failed to create RowDataGenerator for table: " << table_name
-                //          << " - " << e.what() << std::endl;
-                // return false;
-                // state.completed = true;
-                LogUtils::error("Failed to create RowDataGenerator for table {}: {}", table_name, e.what());
-                throw;
+        if (shared) {
+            shared_generator_ = std::make_unique<RowDataGenerator>(
+                std::string(table_states_.table_name(0, buffer)),
+                config_,
+                col_instances_,
+                pool_.is_cache_mode()
+            );
+
+            // Every table starts from the generator's initial state
+            table_states_.init_column_states(shared_generator_->state_words());
+            for (size_t table = 0; table < table_states_.size(); ++table) {
+                shared_generator_->save_state(table_states_, table);
+            }
+        } else {
+            generators_.reserve(table_states_.size());
+            for (size_t table = 0; table < table_states_.size(); ++table) {
+                const std::string table_name(table_states_.table_name(table, buffer));
+                try {
+                    generators_.push_back(std::make_unique<RowDataGenerator>(
+                        table_name,
+                        config_,
+                        col_instances_,
+                        pool_.is_cache_mode()
+                    ));
+                } catch (const std::exception& e) {
+                    LogUtils::error("Failed to create RowDataGenerator for table {}: {}", table_name, e.what());
+                    throw;
+                }
             }
         }
 
         current_table_index_ = 0;
+        previous_active_index_ = table_states_.size() - 1;
         return true;
     } catch (const std::exception& e) {
         LogUtils::error("Failed to initialize TableDataManager: {}", e.what());
@@ -100,6 +127,17 @@ const ColumnConfigInstanceVector& TableDataManager::get_column_instances() const
     return col_instances_;
 }
 
+TableDataManager::~TableDataManager() {
+    release_block_cache();
+}
+
+void TableDataManager::release_block_cache() {
+    if (block_cache_ != MemoryPool::NO_BLOCK_CACHE) {
+        pool_.detach_block_cache(block_cache_);
+        block_cache_ = MemoryPool::NO_BLOCK_CACHE;
+    }
+}
+
 std::optional<MemoryPool::MemoryBlock*> TableDataManager::next_multi_batch() {
     // if (!has_more()) {
     //     return std::nullopt;
@@ -113,6 +151,8 @@ std::optional<MemoryPool::MemoryBlock*> TableDataManager::next_multi_batch() {
 
     MemoryPool::MemoryBlock* batch = collect_batch_data(max_rows);
     if (batch == nullptr) {
+        // Done producing: the blocks still cached here go to other producers
+        release_block_cache();
         return std::nullopt;
     }
 
@@ -122,7 +162,7 @@ std::optional<MemoryPool::MemoryBlock*> TableDataManager::next_multi_batch() {
 
 MemoryPool::MemoryBlock* TableDataManager::collect_batch_data(size_t max_rows) {
     // Get memory block from memory pool
-    MemoryPool::MemoryBlock* block = pool_.acquire_block(sequence_num_);
+    MemoryPool::MemoryBlock* block = pool_.acquire_block(sequence_num_, block_cache_);
     // if (!block) {
     //     return nullptr;  // No available memory block
     // }
@@ -133,7 +173,7 @@ MemoryPool::MemoryBlock* TableDataManager::collect_batch_data(size_t max_rows) {
     int64_t end_time = std::numeric_limits<int64_t>::min();
     size_t total_rows = 0;
     size_t table_loops = 0;
-    const size_t max_loops = table_states_.size();
+    const size_t max_loops = active_table_count_;      // One lap of the active ring
     prev_table_index_ = current_table_index_;
 
     while (total_rows < max_rows &&
@@ -142,64 +182,57 @@ MemoryPool::MemoryBlock* TableDataManager::collect_batch_data(size_t max_rows) {
            current_table_index_ >= prev_table_index_ &&
            block->used_tables < block->tables.size())
     {
-        TableState* table_state = get_next_active_table();
-        if (!table_state) break;
+        const size_t table = get_next_active_table();
+        if (table == npos) break;
 
         // Get current table slot
         auto& table_block = block->tables[block->used_tables];
-        table_block.table_name = table_state->table_name.c_str();
-        table_block.tags_ptr = table_state->tags_ptr;
+        table_block.table_name = table_states_.table_name_cstr(table, table_block.name_buffer);
+        table_block.tags_ptr = table_states_.tags[table];
 
         // Calculate number of rows that can be generated
         size_t remaining = max_rows - total_rows;
         size_t rows_to_generate = std::min(
-            calculate_rows_to_generate(*table_state),
+            calculate_rows_to_generate(table),
             std::min(remaining, table_block.max_rows)
         );
 
         // Generate data directly in the memory block
-        for (size_t i = 0; i < rows_to_generate; ++i) {
-            auto row_opt = table_state->generator->next_row(table_block);
-            if (row_opt > 0) {
-                // Update statistics
-                const int64_t ts = table_block.timestamps[table_block.used_rows - 1];
-                start_time = std::min(start_time, ts);
-                end_time = std::max(end_time, ts);
-
-                total_rows++;
-                table_state->rows_generated++;
-                table_state->interlace_counter++;
-            } else if (row_opt == 0) {
-                if (!table_state->completed) {
-                    table_state->completed = true;
-                    if (active_table_count_ > 0) --active_table_count_;
-                }
-                break;
-            } else {
-                --i;
-                continue;
+        const size_t generated = generate_rows(table, table_block, rows_to_generate);
+        if (generated > 0) {
+            const int64_t* ts = table_block.timestamps + table_block.used_rows - generated;
+            for (size_t i = 0; i < generated; ++i) {
+                start_time = std::min(start_time, ts[i]);
+                end_time = std::max(end_time, ts[i]);
             }
 
+            total_rows += generated;
+            table_states_.rows_generated[table] += generated;
+            table_states_.interlace_counters[table] += generated;
+
             // Flow control processing
             if (rate_limiter_) {
-                acquire_tokens(1);
+                acquire_tokens(static_cast<int64_t>(generated));
             }
         }
 
+        // A short slice means the source ran dry
+        if (generated < rows_to_generate) {
+            complete_current_table();
+        }
+
         // If the table has generated data, increase the used table count
         if (table_block.used_rows > 0) {
             block->used_tables++;
         }
 
         // Update table state
-        if (!table_state->completed &&
-            table_state->rows_generated >= config_.schema.generation.rows_per_table) {
-            table_state->completed = true;
-            if (active_table_count_ > 0) --active_table_count_;
+        if (table_states_.rows_generated[table] >= config_.schema.generation.rows_per_table) {
+            complete_current_table();
         }
 
-        if (table_state->completed ||
-            table_state->interlace_counter >= interlace_rows_) {
+        if (table_states_.completed[table] ||
+            table_states_.interlace_counters[table] >= interlace_rows_) {
             advance_to_next_table();
         }
 
@@ -230,67 +263,92 @@ bool TableDataManager::has_more() const {
 
 std::string TableDataManager::current_table() const {
     if (table_states_.empty()) return "";
-    return table_states_[current_table_index_].table_name;
+    std::string buffer;
+    return std::string(table_states_.table_name(current_table_index_, buffer));
 }
 
-const std::vector<TableDataManager::TableState>& TableDataManager::table_states() const {
+const TableStateStore& TableDataManager::table_states() const {
     return table_states_;
 }
 
-TableDataManager::TableState* TableDataManager::get_next_active_table() {
-    if (table_states_.empty()) return nullptr;
-
-    // Loop through tables to find one with available data
-    size_t start_index = current_table_index_;
-
-    do {
-        TableState& state = table_states_[current_table_index_];
+bool TableDataManager::table_has_more(size_t table) const {
+    return !table_states_.completed[table] &&
+           table_states_.rows_generated[table] < config_.schema.generation.rows_per_table &&
+           (shared_generator_ || generators_[table]->has_more());
+}
 
-        // Check if table still has data and is not completed
-        if (!state.completed &&
-            state.rows_generated < config_.schema.generation.rows_per_table &&
-            state.generator->has_more())
-        {
-            return &state;
+size_t TableDataManager::get_next_active_table() {
+    // Completed tables are off the ring, so this only steps over tables whose
+    // source ran dry since they were last visited
+    while (active_table_count_ > 0) {
+        if (table_has_more(current_table_index_)) {
+            return current_table_index_;
         }
+        complete_current_table();
+        advance_to_next_table();
+    }
 
-        // Move to next table
-        current_table_index_ = (current_table_index_ + 1) % table_states_.size();
-    } while (current_table_index_ != start_index);
-
-    return nullptr;
+    return npos;
 }
 
-size_t TableDataManager::calculate_rows_to_generate(TableState& state) const {
+size_t TableDataManager::calculate_rows_to_generate(size_t table) const {
     // Calculate remaining row limit
+    const bool source_has_more = shared_generator_ || generators_[table]->has_more();
     int64_t remaining_rows = std::min(
-        config_.schema.generation.rows_per_table - state.rows_generated,
-        state.generator->has_more() ? std::numeric_limits<int64_t>::max() : 0
+        config_.schema.generation.rows_per_table - table_states_.rows_generated[table],
+        source_has_more ? std::numeric_limits<int64_t>::max() : 0
     );
 
     // Calculate number of rows to generate this time
     int64_t rows_to_generate = std::min(
-        interlace_rows_ - state.interlace_counter,
+        interlace_rows_ - table_states_.interlace_counters[table],
         remaining_rows
     );
 
-    // Consider flow control
-    // if (config_.schema.generation.flow_control.rate_limit > 0) {
-    //     rows_to_generate = std::min(
-    //         rows_to_generate,
-    //         config_.schema.generation.flow_control.rate_limit / static_cast<int>(table_order_.size())
-    //     );
-    // }
-
     return std::max(static_cast<size_t>(1), static_cast<size_t>(rows_to_generate));
 }
 
+size_t TableDataManager::generate_rows(size_t table, MemoryPool::TableBlock& table_block, size_t rows) {
+    // Shared generator: swap the table's state in, fill column by column, write it back
+    if (shared_generator_) {
+        shared_generator_->load_state(table_states_, table);
+        const size_t generated = shared_generator_->next_rows(table_block, rows);
+        shared_generator_->save_state(table_states_, table);
+        return generated;
+    }
+
+    // Columnar path: fill the whole slice in one pass
+    RowDataGenerator& generator = *generators_[table];
+    if (generator.supports_batch()) {
+        return generator.next_rows(table_block, rows);
+    }
+
+    size_t generated = 0;
+    while (generated < rows && generator.next_row(table_block) > 0) {
+        ++generated;
+    }
+    return generated;
+}
+
+void TableDataManager::complete_current_table() {
+    if (table_states_.completed[current_table_index_]) return;
+
+    table_states_.completed[current_table_index_] = 1;
+    if (active_table_count_ > 0) --active_table_count_;
+
+    // Unlink; the table keeps its successor so advance_to_next_table() can step off it
+    table_states_.next_active[previous_active_index_] = table_states_.next_active[current_table_index_];
+}
+
 void TableDataManager::advance_to_next_table() {
     if (table_states_.empty()) return;
 
     // Reset interlace counter for current table
-    table_states_[current_table_index_].interlace_counter = 0;
+    table_states_.interlace_counters[current_table_index_] = 0;
 
-    // Move to next table
-    current_table_index_ = (current_table_index_ + 1) % table_states_.size();
-}
\ No newline at end of file
+    // Move to the next active table
+    if (!table_states_.completed[current_table_index_]) {
+        previous_active_index_ = current_table_index_;
+    }
+    current_table_index_ = table_states_.next_active[current_table_index_];
+}
@@ -5,25 +5,14 @@
 TableNameManager::TableNameManager(const InsertDataConfig& config)
     : config_(config), chunk_size_(1) {}
 
-std::vector<std::string> TableNameManager::generate_table_names() {
+const TableNameList& TableNameManager::generate_table_names() {
     if (!table_names_.empty()) {
         return table_names_;
     }
 
     try {
-        if (config_.schema.tbname.source_type == "generator") {
-            TableNameGenerator generator(config_.schema.tbname.generator);
-            table_names_ = generator.generate();
-        }
-        else if (config_.schema.tbname.source_type == "csv") {
-            TableNameCSVReader csv_reader(config_.schema.tbname.csv);
-            table_names_ = csv_reader.generate();
-        }
-        else {
-            throw std::runtime_error("Unsupported table name source type: " +
-                config_.schema.tbname.source_type);
-        }
-
+        catalog_ = TableCatalog::shared(config_.schema);
+        table_names_ = catalog_->names();
         return table_names_;
     }
     catch (const std::exception& e) {
@@ -31,7 +20,7 @@ std::vector<std::string> TableNameManager::generate_table_names() {
     }
 }
 
-std::vector<std::vector<std::string>> TableNameManager::split_for_threads() {
+std::vector<TableNameList> TableNameManager::split_for_threads() {
     if (table_names_.empty()) {
         generate_table_names();
     }
@@ -48,11 +37,11 @@ std::vector<std::vector<std::string>> TableNameManager::split_for_threads() {
     }
 }
 
-std::vector<std::vector<std::string>> TableNameManager::split_by_index_range() {
+std::vector<TableNameList> TableNameManager::split_by_index_range() {
     return split_equally(config_.schema.generation.generate_threads.value());
 }
 
-std::vector<std::vector<std::string>> TableNameManager::split_equally(size_t thread_count) {
+std::vector<TableNameList> TableNameManager::split_equally(size_t thread_count) {
     if (thread_count == 0) {
         throw std::invalid_argument("Thread count cannot be zero");
     }
@@ -61,7 +50,7 @@ std::vector<std::vector<std::string>> TableNameManager::split_equally(size_t thr
         return {};
     }
 
-    std::vector<std::vector<std::string>> result(thread_count);
+    std::vector<TableNameList> result(thread_count);
 
     // Calculate base size and remainder
     size_t total_size = table_names_.size();
@@ -77,10 +66,8 @@ std::vector<std::vector<std::string>> TableNameManager::split_equally(size_t thr
         size_t chunk_size = base_size + (i < remainder ? 1 : 0);
         chunk_size_ = std::max(chunk_size, chunk_size_);
 
-        // Extract chunk for this thread
-        auto start = table_names_.begin() + current_pos;
-        auto end = start + chunk_size;
-        result[i].insert(result[i].end(), start, end);
+        // Slice for this thread
+        result[i] = table_names_.slice(current_pos, chunk_size);
 
         current_pos += chunk_size;
     }
@@ -88,6 +75,6 @@ std::vector<std::vector<std::string>> TableNameManager::split_equally(size_t thr
     return result;
 }
 
-std::vector<std::vector<std::string>> TableNameManager::split_by_vgroup_binding() {
+std::vector<TableNameList> TableNameManager::split_by_vgroup_binding() {
     throw std::runtime_error("vgroup_binding strategy not implemented yet");
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "TableStateStore.hpp"
+#include <stdexcept>
+
+
+void TableStateStore::reset(const TableNameList& names, bool with_stream_keys) {
+    const size_t capacity = names.size();
+    names_ = names;
+    tags.clear();
+    rows_generated.clear();
+    interlace_counters.clear();
+    completed.clear();
+    timestamp_cursors.clear();
+    stream_keys.clear();
+    column_states.clear();
+    next_active.clear();
+    column_state_words = 0;
+    with_stream_keys_ = with_stream_keys;
+
+    tags.reserve(capacity);
+    rows_generated.reserve(capacity);
+    interlace_counters.reserve(capacity);
+    completed.reserve(capacity);
+    timestamp_cursors.reserve(capacity);
+    next_active.reserve(capacity);
+    if (with_stream_keys) {
+        stream_keys.reserve(capacity);
+    }
+}
+
+size_t TableStateStore::add(uint64_t stream_key) {
+    const size_t table = size();
+    if (table >= UINT32_MAX) {
+        throw std::runtime_error("Too many tables for one TableStateStore");
+    }
+    if (table >= names_.size()) {
+        throw std::runtime_error("TableStateStore has no name for table " + std::to_string(table));
+    }
+
+    tags.push_back(nullptr);
+    rows_generated.push_back(0);
+    interlace_counters.push_back(0);
+    completed.push_back(0);
+    timestamp_cursors.push_back(0);
+    next_active.push_back(0);
+    if (table > 0) {
+        next_active[table - 1] = static_cast<uint32_t>(table);
+    }
+    if (with_stream_keys_) {
+        stream_keys.push_back(stream_key);
+    }
+    return table;
+}
+
+void TableStateStore::init_column_states(size_t state_words) {
+    column_state_words = state_words;
+    column_states.assign(size() * state_words, 0);
+}
@@ -0,0 +1,95 @@
+#include "DisorderEngine.hpp"
+#include <cassert>
+#include <iostream>
+#include <numeric>
+#include <set>
+
+
+GenerationConfig::DataDisorder make_config(int64_t start, int64_t end, double ratio, int latency_range) {
+    GenerationConfig::DataDisorder config;
+    config.enabled = true;
+
+    GenerationConfig::DataDisorder::Interval interval;
+    interval.time_start = start;
+    interval.time_end = end;
+    interval.ratio = ratio;
+    interval.latency_range = latency_range;
+    config.intervals.push_back(interval);
+    return config;
+}
+
+// Delivery order of ts under the engine
+std::vector<uint32_t> plan(const DisorderEngine& engine, const std::vector<int64_t>& ts) {
+    std::vector<int64_t> keys(ts.size());
+    std::vector<char> delayed(ts.size());
+    engine.draw_keys(ts.data(), ts.size(), keys.data(), delayed.data());
+
+    std::vector<uint32_t> order(ts.size());
+    std::iota(order.begin(), order.end(), 0u);
+    DisorderEngine::sort(order.data(), order.size(), keys.data(), delayed.data());
+    return order;
+}
+
+void test_disabled_keeps_order() {
+    GenerationConfig::DataDisorder config = make_config(0, 1000, 1.0, 50);
+    config.enabled = false;
+    DisorderEngine engine(config, "ms");
+    assert(!engine.enabled());
+    assert(engine.max_latency() == 0);
+
+    std::vector<int64_t> ts(100);
+    std::iota(ts.begin(), ts.end(), 0);
+    auto order = plan(engine, ts);
+
+    assert(order.size() == ts.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        assert(order[i] == i);
+    }
+
+    std::cout << "test_disabled_keeps_order passed.\n";
+}
+
+void test_plan_is_bounded_permutation() {
+    const int latency_range = 20;
+    DisorderEngine engine(make_config(1000, 1500, 0.5, latency_range), "ms");
+    assert(engine.enabled());
+    assert(engine.max_latency() == latency_range - 1);
+
+    std::vector<int64_t> ts(1000);
+    std::iota(ts.begin(), ts.end(), 500);
+    auto order = plan(engine, ts);
+
+    // Every row is delivered exactly once
+    std::set<uint32_t> seen(order.begin(), order.end());
+    assert(seen.size() == ts.size());
+    assert(*seen.rbegin() == ts.size() - 1);
+
+    bool found_disorder = false;
+    for (size_t k = 0; k < order.size(); ++k) {
+        const int64_t t = ts[order[k]];
+
+        // Rows outside the interval are never delayed; a row only moves behind
+        // rows at most latency_range - 1 later than itself
+        if (t < 1000 || t >= 1500) {
+            for (size_t j = 0; j < k; ++j) {
+                assert(ts[order[j]] <= t);
+            }
+        } else {
+            for (size_t j = k + 1; j < order.size(); ++j) {
+                assert(ts[order[j]] >= t - (latency_range - 1));
+            }
+        }
+        found_disorder |= k > 0 && t < ts[order[k - 1]];
+    }
+    assert(found_disorder);
+
+    std::cout << "test_plan_is_bounded_permutation passed.\n";
+}
+
+int main() {
+    test_disabled_keeps_order();
+    test_plan_is_bounded_permutation();
+
+    std::cout << "All tests passed.\n";
+    return 0;
+}
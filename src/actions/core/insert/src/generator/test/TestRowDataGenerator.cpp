@@ -1,5 +1,6 @@
 #include "RowDataGenerator.hpp"
 #include "CSVDataManager.hpp"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -181,6 +182,380 @@ void test_generator_with_disorder() {
     std::cout << "test_generator_with_disorder passed.\n";
 }
 
+void test_generator_next_rows_into_block() {
+    ColumnsConfig columns_config;
+    columns_config.source_type = "generator";
+
+    auto& ts_config = columns_config.generator.timestamp_strategy.timestamp_config;
+    ts_config.start_timestamp = Timestamp{1000};
+    ts_config.timestamp_step = 10;
+    ts_config.timestamp_precision = "ms";
+
+    InsertDataConfig config;
+    config.schema.columns = {
+        {"col1", "INT", "random", 1, 100},
+        {"col2", "VARCHAR(6)", "random"}
+    };
+    config.schema.generation.rows_per_table = 7;
+    config.schema.columns_cfg = columns_config;
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+
+    auto instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    ColumnConfigInstanceVector tag_instances;
+    MemoryPool pool(1, 1, 5, instances, tag_instances);
+    RowDataGenerator generator("test_table", config, instances);
+    assert(generator.supports_batch());
+
+    // First batch is capped by the block capacity
+    auto* block = pool.acquire_block();
+    auto& table_block = block->tables[0];
+    size_t rows = generator.next_rows(table_block, 10);
+    (void)rows;
+    assert(rows == 5);
+    assert(table_block.used_rows == 5);
+
+    for (size_t i = 0; i < 5; ++i) {
+        assert(table_block.timestamps[i] == static_cast<int64_t>(1000 + i * 10));
+
+        auto int_cell = table_block.get_column_cell(i, 0);
+        int32_t int_value = std::get<int32_t>(int_cell);
+        (void)int_value;
+        assert(int_value >= 1 && int_value < 100);
+
+        auto str_cell = table_block.get_column_cell(i, 1);
+        const auto& str_value = std::get<std::string>(str_cell);
+        (void)str_value;
+        assert(str_value.size() == 6);
+        assert(table_block.columns[1].var_offsets[i] == i * 6);
+    }
+    block->release();
+
+    // Second batch is capped by rows_per_table
+    block = pool.acquire_block();
+    rows = generator.next_rows(block->tables[0], 10);
+    assert(rows == 2);
+    assert(block->tables[0].timestamps[0] == 1050);
+    assert(!generator.has_more());
+    assert(generator.next_rows(block->tables[0], 10) == 0);
+    block->release();
+
+    std::cout << "test_generator_next_rows_into_block passed.\n";
+}
+
+void test_generator_seeded_is_reproducible() {
+    ColumnsConfig columns_config;
+    columns_config.source_type = "generator";
+
+    auto& ts_config = columns_config.generator.timestamp_strategy.timestamp_config;
+    ts_config.start_timestamp = Timestamp{1000};
+    ts_config.timestamp_step = 10;
+    ts_config.timestamp_jitter = 5;
+    ts_config.timestamp_precision = "ms";
+
+    InsertDataConfig config;
+    config.schema.columns = {
+        {"col1", "INT", "random", 1, 1000000},
+        {"col2", "VARCHAR(8)", "random"}
+    };
+    config.schema.columns[0].null_ratio = 0.2f;
+    config.schema.generation.rows_per_table = 12;
+    config.schema.generation.seed = 42;
+    config.schema.columns_cfg = columns_config;
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+
+    auto instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    ColumnConfigInstanceVector tag_instances;
+
+    // Rows of one table produced in slices of the given size
+    auto collect = [&](const std::string& table_name, size_t slice) {
+        MemoryPool pool(1, 1, 12, instances, tag_instances);
+        RowDataGenerator generator(table_name, config, instances);
+        auto* block = pool.acquire_block();
+        auto& table_block = block->tables[0];
+        while (generator.next_rows(table_block, slice) > 0) {}
+
+        std::vector<std::string> rows;
+        for (size_t i = 0; i < table_block.used_rows; ++i) {
+            std::string row = std::to_string(table_block.timestamps[i]);
+            for (size_t c = 0; c < 2; ++c) {
+                if (table_block.columns[c].is_nulls[i] != CELL_VALUE) {
+                    row += ",null";
+                } else if (c == 0) {
+                    row += "," + std::to_string(std::get<int32_t>(table_block.get_column_cell(i, c)));
+                } else {
+                    row += "," + std::get<std::string>(table_block.get_column_cell(i, c));
+                }
+            }
+            rows.push_back(row);
+        }
+        block->release();
+        return rows;
+    };
+
+    // Same data whatever the slicing, different data per table
+    auto rows = collect("d0", 12);
+    assert(rows.size() == 12);
+    assert(collect("d0", 5) == rows);
+    assert(collect("d0", 1) == rows);
+    assert(collect("d1", 12) != rows);
+
+    // The row path is reproducible too
+    RowDataGenerator first("d0", config, instances);
+    RowDataGenerator second("d0", config, instances);
+    while (auto row = first.next_row()) {
+        auto other = second.next_row();
+        assert(other && other->timestamp == row->timestamp);
+        assert(other->nulls == row->nulls);
+        assert(std::get<int32_t>(other->columns[0]) == std::get<int32_t>(row->columns[0]));
+        assert(std::get<std::string>(other->columns[1]) == std::get<std::string>(row->columns[1]));
+    }
+
+    std::cout << "test_generator_seeded_is_reproducible passed.\n";
+}
+
+void test_generator_seeded_words_reproducible() {
+    ColumnsConfig columns_config;
+    columns_config.source_type = "generator";
+
+    auto& ts_config = columns_config.generator.timestamp_strategy.timestamp_config;
+    ts_config.start_timestamp = Timestamp{1000};
+    ts_config.timestamp_step = 10;
+    ts_config.timestamp_precision = "ms";
+
+    // Two word columns of the same word count, which used to share picks
+    InsertDataConfig config;
+    config.schema.columns = {
+        {"col1", "VARCHAR(24)", "random"},
+        {"col2", "VARCHAR(24)", "random"}
+    };
+    for (auto& column : config.schema.columns) {
+        column.words = {"alpha", "beta", "gamma", "delta", "epsilon"};
+    }
+    config.schema.generation.rows_per_table = 40;
+    config.schema.generation.seed = 11;
+    config.schema.columns_cfg = columns_config;
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+
+    auto instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    ColumnConfigInstanceVector tag_instances;
+
+    auto collect = [&](size_t slice) {
+        MemoryPool pool(1, 1, 40, instances, tag_instances);
+        RowDataGenerator generator("d0", config, instances);
+        auto* block = pool.acquire_block();
+        auto& table_block = block->tables[0];
+        while (generator.next_rows(table_block, slice) > 0) {}
+
+        std::vector<std::string> rows;
+        for (size_t i = 0; i < table_block.used_rows; ++i) {
+            rows.push_back(table_block.get_column_cell_as_string(i, 0) + "|" + table_block.get_column_cell_as_string(i, 1));
+        }
+        block->release();
+        return rows;
+    };
+
+    // Word picks follow the cell, not the slice or the other column
+    auto rows = collect(40);
+    assert(rows.size() == 40);
+    assert(collect(7) == rows);
+    assert(collect(1) == rows);
+
+    std::cout << "test_generator_seeded_words_reproducible passed.\n";
+}
+
+void test_generator_disorder_spans_calls() {
+    ColumnsConfig columns_config;
+    columns_config.source_type = "generator";
+
+    auto& ts_config = columns_config.generator.timestamp_strategy.timestamp_config;
+    ts_config.start_timestamp = Timestamp{1000};
+    ts_config.timestamp_step = 1;
+    ts_config.timestamp_precision = "ms";
+
+    InsertDataConfig config;
+    config.schema.columns = {{"col1", "INT", "random", 1, 100}};
+    config.schema.generation.rows_per_table = 50;
+    config.schema.generation.data_disorder.enabled = true;
+    config.schema.columns_cfg = columns_config;
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+
+    GenerationConfig::DataDisorder::Interval interval;
+    interval.time_start = "1000";
+    interval.time_end = "1100";
+    interval.ratio = 1.0;
+    interval.latency_range = 20;
+    config.schema.generation.data_disorder.intervals.push_back(interval);
+
+    auto instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    ColumnConfigInstanceVector tag_instances;
+    MemoryPool pool(1, 1, 50, instances, tag_instances);
+    RowDataGenerator generator("test_table", config, instances);
+
+    // The disorder window outlives a single call of the batch path
+    assert(generator.supports_batch());
+
+    // One row per call, as with interlace rows = 1
+    auto* block = pool.acquire_block();
+    auto& table_block = block->tables[0];
+    size_t rows = 0;
+    while (generator.next_rows(table_block, 1) > 0) {
+        ++rows;
+    }
+    assert(rows == 50);
+
+    std::vector<int64_t> timestamps(table_block.timestamps, table_block.timestamps + 50);
+    assert(!std::is_sorted(timestamps.begin(), timestamps.end()));
+    std::sort(timestamps.begin(), timestamps.end());
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        assert(timestamps[i] == static_cast<int64_t>(1000 + i));
+    }
+    block->release();
+
+    std::cout << "test_generator_disorder_spans_calls passed.\n";
+}
+
+void test_generator_disorder_long_latency() {
+    ColumnsConfig columns_config;
+    columns_config.source_type = "generator";
+
+    auto& ts_config = columns_config.generator.timestamp_strategy.timestamp_config;
+    ts_config.start_timestamp = Timestamp{1000};
+    ts_config.timestamp_step = 1;
+    ts_config.timestamp_precision = "ms";
+
+    // Latencies of up to 3000 steps, far past one window refill
+    const int latency_range = 3000;
+    const size_t total = 5000;
+    InsertDataConfig config;
+    config.schema.columns = {{"col1", "INT", "random", 1, 100}, {"col2", "VARCHAR(8)", "random"}};
+    config.schema.generation.rows_per_table = total;
+    config.schema.generation.seed = 7;
+    config.schema.generation.data_disorder.enabled = true;
+    config.schema.columns_cfg = columns_config;
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+
+    GenerationConfig::DataDisorder::Interval interval;
+    interval.time_start = "1000";
+    interval.time_end = "6000";
+    interval.ratio = 0.05;
+    interval.latency_range = latency_range;
+    config.schema.generation.data_disorder.intervals.push_back(interval);
+
+    auto instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    ColumnConfigInstanceVector tag_instances;
+
+    auto collect = [&](size_t slice) {
+        MemoryPool pool(1, 1, total, instances, tag_instances);
+        RowDataGenerator generator("d0", config, instances);
+        auto* block = pool.acquire_block();
+        auto& table_block = block->tables[0];
+        while (generator.next_rows(table_block, slice) > 0) {}
+        assert(table_block.used_rows == total);
+
+        std::vector<std::pair<int64_t, std::string>> rows;
+        for (size_t i = 0; i < total; ++i) {
+            rows.emplace_back(table_block.timestamps[i], table_block.get_column_cell_as_string(i, 1));
+        }
+        block->release();
+        return rows;
+    };
+
+    // Seeded delivery does not depend on the slicing
+    auto rows = collect(total);
+    assert(collect(1) == rows);
+    assert(collect(333) == rows);
+
+    // Every row once; no row is overtaken by one latency_range or more
+    // later, and some are overtaken by more than 1024 rows
+    std::vector<int64_t> timestamps;
+    for (const auto& row : rows) {
+        timestamps.push_back(row.first);
+    }
+    std::vector<int64_t> later_min(total + 1, INT64_MAX);
+    for (size_t k = total; k > 0; --k) {
+        later_min[k - 1] = std::min(later_min[k], timestamps[k - 1]);
+    }
+    bool long_delay = false;
+    int64_t latest = INT64_MIN;
+    for (size_t k = 0; k < total; ++k) {
+        assert(later_min[k + 1] >= timestamps[k] - (latency_range - 1));
+        long_delay |= latest - timestamps[k] > 1024;
+        latest = std::max(latest, timestamps[k]);
+    }
+    assert(long_delay);
+    (void)long_delay;
+
+    std::sort(timestamps.begin(), timestamps.end());
+    for (size_t i = 0; i < total; ++i) {
+        assert(timestamps[i] == static_cast<int64_t>(1000 + i));
+    }
+
+    std::cout << "test_generator_disorder_long_latency passed.\n";
+}
+
+void test_generator_next_rows_with_nulls() {
+    ColumnsConfig columns_config;
+    columns_config.source_type = "generator";
+
+    auto& ts_config = columns_config.generator.timestamp_strategy.timestamp_config;
+    ts_config.start_timestamp = Timestamp{1000};
+    ts_config.timestamp_step = 10;
+    ts_config.timestamp_precision = "ms";
+
+    InsertDataConfig config;
+    config.schema.columns = {
+        {"col1", "INT", "random", 1, 100},
+        {"col2", "VARCHAR(6)", "random"}
+    };
+    config.schema.columns[0].null_ratio = 0.3f;
+    config.schema.columns[1].null_ratio = 0.2f;
+    config.schema.columns[1].none_ratio = 0.2f;
+    config.schema.generation.rows_per_table = 1000;
+    config.schema.columns_cfg = columns_config;
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+
+    auto instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    ColumnConfigInstanceVector tag_instances;
+    MemoryPool pool(1, 1, 1000, instances, tag_instances);
+    RowDataGenerator generator("test_table", config, instances);
+
+    auto* block = pool.acquire_block();
+    auto& table_block = block->tables[0];
+    size_t rows = generator.next_rows(table_block, 1000);
+    assert(rows == 1000);
+
+    size_t int_nulls = 0, str_nulls = 0, str_nones = 0;
+    size_t expected_offset = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        char flag = table_block.get_column_flag(i, 0);
+        if (flag == CELL_NULL) {
+            int_nulls++;
+        } else {
+            int32_t value = std::get<int32_t>(table_block.get_column_cell(i, 0));
+            (void)value;
+            assert(value >= 1 && value < 100);
+        }
+
+        // Var data stays contiguous: NULL / NONE rows take no bytes
+        const auto& col = table_block.columns[1];
+        assert(col.var_offsets[i] == expected_offset);
+        flag = table_block.get_column_flag(i, 1);
+        if (flag == CELL_VALUE) {
+            assert(std::get<std::string>(table_block.get_column_cell(i, 1)).size() == 6);
+            expected_offset += 6;
+        } else {
+            assert(col.lengths[i] == 0);
+            (flag == CELL_NULL ? str_nulls : str_nones)++;
+        }
+    }
+    assert(int_nulls > 230 && int_nulls < 370);
+    assert(str_nulls > 140 && str_nulls < 260);
+    assert(str_nones > 140 && str_nones < 260);
+    block->release();
+
+    std::cout << "test_generator_next_rows_with_nulls passed.\n";
+}
+
 void setup_test_csv() {
     CSVDataManager::reset();
     std::ofstream test_file("test_data.csv");
@@ -448,6 +823,12 @@ int main() {
     test_generator_reset();
     test_generator_with_cache();
     test_generator_with_disorder();
+    test_generator_next_rows_into_block();
+    test_generator_seeded_words_reproducible();
+    test_generator_disorder_spans_calls();
+    test_generator_disorder_long_latency();
+    test_generator_seeded_is_reproducible();
+    test_generator_next_rows_with_nulls();
     test_csv_mode_basic();
     test_csv_mode_with_invalid_data();
     test_csv_precision_conversion();
@@ -1,6 +1,11 @@
 #include "TableDataManager.hpp"
+#include "CSVDataManager.hpp"
 #include <cassert>
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <map>
 
 InsertDataConfig create_test_config() {
     InsertDataConfig config;
@@ -37,7 +42,7 @@ void test_init_with_empty_tables() {
     MemoryPool pool(1, 1, 1, col_instances, tag_instances);
     TableDataManager manager(pool, config, col_instances, tag_instances);
 
-    assert(!manager.init({}));
+    assert(!manager.init(TableNameList{}));
     std::cout << "test_init_with_empty_tables passed.\n";
 }
 
@@ -376,6 +381,156 @@ void test_tags_disabled_by_config() {
     std::cout << "test_tags_disabled_by_config passed.\n";
 }
 
+void test_shared_generator_keeps_table_state() {
+    auto config = create_test_config();
+    config.schema.columns_cfg.generator.schema = {
+        {"seq", "BIGINT", "order"}
+    };
+    config.schema.columns_cfg.generator.schema[0].order_min = 100;
+    config.schema.columns_cfg.generator.schema[0].order_max = 1000;
+    config.schema.generation.rows_per_table = 6;
+    config.schema.generation.rows_per_batch = 100;
+    config.schema.generation.interlace_mode.enabled = true;
+    config.schema.generation.interlace_mode.rows = 2;
+    auto col_instances = ColumnConfigInstanceFactory::create(config.schema.columns_cfg.generator.schema);
+    auto tag_instances = ColumnConfigInstanceFactory::create(config.schema.tags_cfg.generator.schema);
+    MemoryPool pool(2, 3, 6, col_instances, tag_instances);
+    TableDataManager manager(pool, config, col_instances, tag_instances);
+
+    assert(manager.init({"d0", "d1", "d2"}));
+    assert(manager.table_states().column_state_words == 1);
+
+    // Interlaced slices must continue each table's own timestamps and sequence
+    std::map<std::string, std::vector<std::pair<int64_t, int64_t>>> rows;
+    while (manager.has_more()) {
+        auto block = manager.next_multi_batch();
+        assert(block);
+        for (size_t t = 0; t < block.value()->used_tables; ++t) {
+            const auto& table = block.value()->tables[t];
+            for (size_t r = 0; r < table.used_rows; ++r) {
+                rows[table.table_name].emplace_back(table.timestamps[r], std::get<int64_t>(table.get_column_cell(r, 0)));
+            }
+        }
+        block.value()->release();
+    }
+
+    assert(rows.size() == 3);
+    for (const auto& [name, values] : rows) {
+        (void)name;
+        assert(values.size() == 6);
+        for (size_t i = 0; i < values.size(); ++i) {
+            assert(values[i].first == 1000 + 10 * static_cast<int64_t>(i));
+            assert(values[i].second == 100 + static_cast<int64_t>(i));
+        }
+    }
+
+    std::cout << "test_shared_generator_keeps_table_state passed.\n";
+}
+
+void test_disorder_with_single_row_interlace() {
+    auto config = create_test_config();
+    config.schema.generation.rows_per_table = 50;
+    config.schema.generation.interlace_mode.enabled = true;
+    config.schema.generation.interlace_mode.rows = 1;
+    config.schema.generation.data_disorder.enabled = true;
+    config.schema.generation.data_disorder.intervals.push_back({1000, 1500, 1.0, 50});
+    auto col_instances = ColumnConfigInstanceFactory::create(config.schema.columns_cfg.generator.schema);
+    auto tag_instances = ColumnConfigInstanceFactory::create(config.schema.tags_cfg.generator.schema);
+    MemoryPool pool(2, 2, 1, col_instances, tag_instances);
+    TableDataManager manager(pool, config, col_instances, tag_instances);
+
+    assert(manager.init({"d0", "d1"}));
+
+    // One row per slice must still be reordered across slices
+    std::map<std::string, std::vector<int64_t>> timestamps;
+    while (manager.has_more()) {
+        auto block = manager.next_multi_batch();
+        assert(block);
+        for (size_t t = 0; t < block.value()->used_tables; ++t) {
+            const auto& table = block.value()->tables[t];
+            for (size_t r = 0; r < table.used_rows; ++r) {
+                timestamps[table.table_name].push_back(table.timestamps[r]);
+            }
+        }
+        block.value()->release();
+    }
+
+    assert(timestamps.size() == 2);
+    for (auto& [name, values] : timestamps) {
+        (void)name;
+        assert(values.size() == 50);
+        assert(!std::is_sorted(values.begin(), values.end()));
+        std::sort(values.begin(), values.end());
+        for (size_t i = 0; i < values.size(); ++i) {
+            assert(values[i] == 1000 + 10 * static_cast<int64_t>(i));
+        }
+    }
+
+    std::cout << "test_disorder_with_single_row_interlace passed.\n";
+}
+
+void test_uneven_tables_leave_the_ring() {
+    CSVDataManager::reset();
+    {
+        std::ofstream file("uneven_tables.csv");
+        file << "table,timestamp,v\n";
+        file << "t1,1000,1\n";
+        file << "t2,1000,1\n";
+        file << "t2,2000,2\n";
+        file << "t2,3000,3\n";
+        file << "t3,1000,1\n";
+        file << "t3,2000,2\n";
+    }
+
+    InsertDataConfig config;
+    config.schema.columns.emplace_back(ColumnConfig{"v", "INT"});
+    config.schema.columns_cfg.source_type = "csv";
+    config.schema.columns_cfg.csv.file_path = "uneven_tables.csv";
+    config.schema.columns_cfg.csv.has_header = true;
+    config.schema.columns_cfg.csv.tbname_index = 0;
+    config.schema.columns_cfg.csv.timestamp_strategy.strategy_type = "csv";
+    config.schema.columns_cfg.csv.timestamp_strategy.csv.timestamp_index = 1;
+    config.schema.columns_cfg.csv.timestamp_strategy.csv.timestamp_precision = "ms";
+    config.schema.columns_cfg.generator.schema = config.schema.columns;
+    config.schema.generation.rows_per_table = 3;
+    config.schema.generation.rows_per_batch = 100;
+    config.schema.generation.interlace_mode.enabled = true;
+    config.schema.generation.interlace_mode.rows = 1;
+    config.timestamp_precision = "ms";
+    config.data_format.support_tags = false;
+
+    auto col_instances = ColumnConfigInstanceFactory::create(config.schema.columns);
+    auto tag_instances = ColumnConfigInstanceFactory::create(config.schema.tags_cfg.generator.schema);
+    MemoryPool pool(2, 3, 3, col_instances, tag_instances);
+    TableDataManager manager(pool, config, col_instances, tag_instances);
+    assert(manager.init({"t1", "t2", "t3"}));
+
+    // Dry tables drop out of the rotation, the others keep their order
+    std::vector<std::string> visits;
+    while (manager.has_more()) {
+        auto block = manager.next_multi_batch();
+        if (!block) break;
+        for (size_t t = 0; t < block.value()->used_tables; ++t) {
+            visits.emplace_back(block.value()->tables[t].table_name);
+        }
+        block.value()->release();
+    }
+
+    const std::vector<std::string> expected = {"t1", "t2", "t3", "t2", "t3", "t2"};
+    (void)expected;
+    assert(visits == expected);
+    assert(!manager.has_more());
+
+    const auto& states = manager.table_states();
+    (void)states;
+    assert(states[0].rows_generated == 1);
+    assert(states[1].rows_generated == 3);
+    assert(states[2].rows_generated == 2);
+
+    std::remove("uneven_tables.csv");
+    std::cout << "test_uneven_tables_leave_the_ring passed.\n";
+}
+
 int main() {
     test_init_with_empty_tables();
     test_init_with_valid_tables();
@@ -388,6 +543,9 @@ int main() {
     test_data_generation_with_flow_control();
     test_data_generation_with_tags();
     test_tags_disabled_by_config();
+    test_shared_generator_keeps_table_state();
+    test_disorder_with_single_row_interlace();
+    test_uneven_tables_leave_the_ring();
 
     std::cout << "All tests passed.\n";
     return 0;
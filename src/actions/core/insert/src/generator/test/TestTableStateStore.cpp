@@ -0,0 +1,114 @@
+#include "TableStateStore.hpp"
+#include <cassert>
+#include <iostream>
+
+void test_add_links_ring() {
+    TableStateStore store;
+    store.reset(TableNameList::sequence("d", 0, 3), false);
+    assert(store.add() == 0);
+    assert(store.add() == 1);
+    assert(store.add() == 2);
+
+    assert(store.size() == 3);
+    assert(store.stream_keys.empty());
+    assert(store.next_active[0] == 1);
+    assert(store.next_active[1] == 2);
+    assert(store.next_active[2] == 0);
+
+    std::cout << "test_add_links_ring passed.\n";
+}
+
+void test_single_table_ring() {
+    TableStateStore store;
+    store.reset(TableNameList::sequence("d", 0, 1), false);
+    store.add();
+    assert(store.next_active[0] == 0);
+
+    std::cout << "test_single_table_ring passed.\n";
+}
+
+void test_column_states_and_keys() {
+    TableStateStore store;
+    store.reset(TableNameList::sequence("d", 0, 2), true);
+    store.add(11);
+    store.add(22);
+    store.init_column_states(2);
+
+    assert(store.stream_keys.size() == 2);
+    assert(store.stream_keys[1] == 22);
+    assert(store.column_states.size() == 4);
+    store.column_state(1)[1] = 7;
+    assert(store.column_states[3] == 7);
+
+    // Reset forgets everything, including whether keys are kept
+    store.reset(TableNameList::sequence("d", 2, 1), false);
+    store.add(33);
+    assert(store.size() == 1);
+    assert(store.stream_keys.empty());
+    assert(store.column_state_words == 0);
+
+    std::cout << "test_column_states_and_keys passed.\n";
+}
+
+void test_views() {
+    TableStateStore store;
+    store.reset(TableNameList::sequence("d", 0, 2), false);
+    store.add();
+    store.add();
+    store.rows_generated[1] = 5;
+    store.completed[1] = 1;
+
+    size_t count = 0;
+    for (const auto& state : store) {
+        (void)state;
+        ++count;
+    }
+    assert(count == 2);
+    assert(store[1].table_name == "d1");
+    assert(store[1].rows_generated == 5);
+    assert(store[1].completed);
+    assert(!store[0].completed);
+
+    std::cout << "test_views passed.\n";
+}
+
+void test_names_from_list() {
+    // A slice of an interned list: names come from the shared arena in place
+    auto names = TableNameList::intern({"a0", "a1", "a2", "a3"}).slice(1, 2);
+    TableStateStore store;
+    store.reset(names, false);
+    store.add();
+    store.add();
+
+    std::string buffer;
+    assert(store.table_name(1, buffer) == "a2");
+    assert(std::string(store.table_name_cstr(0, buffer)) == "a1" && buffer.empty());
+
+    // Sequence names are formatted into the caller's buffer
+    store.reset(TableNameList::sequence("d", 100, 2), false);
+    store.add();
+    store.add();
+    assert(std::string(store.table_name_cstr(1, buffer)) == "d101" && buffer == "d101");
+
+    // No more tables than names
+    bool threw = false;
+    try {
+        store.add();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "test_names_from_list passed.\n";
+}
+
+int main() {
+    test_add_links_ring();
+    test_single_table_ring();
+    test_column_states_and_keys();
+    test_views();
+    test_names_from_list();
+
+    std::cout << "All tests passed.\n";
+    return 0;
+}
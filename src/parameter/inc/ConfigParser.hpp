@@ -3,6 +3,7 @@
 #include "GlobalConfig.hpp"
 #include "ActionConfigVariant.hpp"
 #include "PluginConfigRegistry.hpp"
+#include "StringUtils.hpp"
 #include <string>
 #include <vector>
 #include <optional>
@@ -178,7 +179,7 @@ namespace YAML {
             static const std::set<std::string> valid_keys = {
                 "interlace", "num_cached_batches", "rate_limit", "data_disorder",
                 "concurrency", "rows_per_table", "rows_per_batch", "per_table_rows", "per_batch_rows",
-                "tables_reuse_data"
+                "tables_reuse_data", "seed"
             };
 
             check_unknown_keys(node, valid_keys, "generation");
@@ -268,6 +269,11 @@ namespace YAML {
                 rhs.tables_reuse_data = node["tables_reuse_data"].as<bool>();
             }
 
+            // seed
+            if (node["seed"]) {
+                rhs.seed = node["seed"].as<uint64_t>();
+            }
+
             // num_cached_batches
             bool data_cache_specified = false;
             if (node["num_cached_batches"]) {
@@ -447,16 +453,20 @@ namespace YAML {
                 "name", "type", "primary_key", "count", "gen_type", "props", "null_ratio", "none_ratio"
             };
             static const std::set<std::string> random_allowed = {
-                "distribution", "min", "max", "dec_min", "dec_max", "corpus", "chinese", "values"
+                "distribution", "mean", "stddev", "lambda", "skew", "min", "max", "dec_min", "dec_max",
+                "corpus", "words", "chinese", "values", "weights"
             };
             static const std::set<std::string> order_allowed = {
                 "min", "max"
             };
             static const std::set<std::string> expression_allowed = {
-                "expr"
+                "expr", "per_table"
             };
             static const std::set<std::string> timestamp_allowed = {
-                "precision", "start", "step"
+                "precision", "start", "step", "jitter"
+            };
+            static const std::set<std::string> signal_allowed = {
+                "min", "max", "mean", "stddev", "amplitude", "period", "phase", "noise", "drift", "boundary"
             };
 
             if (!node["name"]) {
@@ -473,9 +483,9 @@ namespace YAML {
             // Valid keys
             std::set<std::string> valid_keys = common_keys;
             if (rhs.type_tag == ColumnTypeTag::BIGINT) {
-                valid_keys = merge_keys<std::string>({common_keys, random_allowed, order_allowed, expression_allowed, timestamp_allowed});
+                valid_keys = merge_keys<std::string>({common_keys, random_allowed, order_allowed, expression_allowed, signal_allowed, timestamp_allowed});
             } else {
-                valid_keys = merge_keys<std::string>({common_keys, random_allowed, order_allowed, expression_allowed});
+                valid_keys = merge_keys<std::string>({common_keys, random_allowed, order_allowed, expression_allowed, signal_allowed});
             }
             check_unknown_keys(node, valid_keys, "columns or tags");
 
@@ -495,6 +505,11 @@ namespace YAML {
                     rhs.ts.generator.timestamp_step = node["step"].as<std::string>();
                     rhs.ts.generator.timestamp_step = TimestampUtils::parse_step(rhs.ts.generator.timestamp_step, rhs.ts.generator.timestamp_precision);
                 }
+                if (node["jitter"]) {
+                    rhs.ts.strategy_type = "generator";
+                    rhs.ts.generator.timestamp_jitter = node["jitter"].as<std::string>();
+                    rhs.ts.generator.timestamp_jitter = TimestampUtils::parse_step(rhs.ts.generator.timestamp_jitter, rhs.ts.generator.timestamp_precision);
+                }
             }
 
             if (node["primary_key"]) rhs.primary_key = node["primary_key"].as<bool>();
@@ -538,9 +553,19 @@ namespace YAML {
 
                 if (node["distribution"]) {
                     rhs.distribution = node["distribution"].as<std::string>();
+                    static const std::set<std::string> distributions = {
+                        "uniform", "normal", "lognormal", "exponential", "zipf"
+                    };
+                    if (distributions.count(*rhs.distribution) == 0) {
+                        throw std::runtime_error("Invalid distribution '" + *rhs.distribution + "' for column: " + rhs.name);
+                    }
                 } else {
                     rhs.distribution = "uniform";
                 }
+                if (node["mean"]) rhs.mean = node["mean"].as<double>();
+                if (node["stddev"]) rhs.stddev = node["stddev"].as<double>();
+                if (node["lambda"]) rhs.lambda = node["lambda"].as<double>();
+                if (node["skew"]) rhs.skew = node["skew"].as<double>();
                 if (node["min"]) {
                     rhs.min = node["min"].as<double>();
                 } else {
@@ -554,6 +579,12 @@ namespace YAML {
                 if (node["dec_min"]) rhs.dec_min = node["dec_min"].as<std::string>();
                 if (node["dec_max"]) rhs.dec_max = node["dec_max"].as<std::string>();
                 if (node["corpus"]) rhs.corpus = node["corpus"].as<std::string>();
+                if (node["words"]) {
+                    rhs.words = node["words"].as<std::vector<std::string>>();
+                    if (rhs.words.empty()) {
+                        throw std::runtime_error("words must contain at least one element for column: " + rhs.name);
+                    }
+                }
                 if (node["chinese"]) rhs.chinese = node["chinese"].as<bool>();
                 if (node["values"]) {
                     if (rhs.type_tag == ColumnTypeTag::BOOL) {
@@ -571,6 +602,15 @@ namespace YAML {
                         throw std::runtime_error("values must contain at least one element for column: " + rhs.name);
                     }
                 }
+                if (node["weights"]) {
+                    if (!node["values"]) {
+                        throw std::runtime_error("weights requires values for column: " + rhs.name);
+                    }
+                    rhs.weights = node["weights"].as<std::vector<double>>();
+                    if (rhs.weights.size() != static_cast<size_t>(rhs.values_count)) {
+                        throw std::runtime_error("weights must have the same size as values for column: " + rhs.name);
+                    }
+                }
             } else if (*rhs.gen_type == "order") {
                 // Detect forbidden keys in order
                 check_unknown_keys(node, merge_keys<std::string>({common_keys, timestamp_allowed, order_allowed}), "columns or tags::order");
@@ -592,6 +632,28 @@ namespace YAML {
                 } else {
                     throw std::runtime_error("Missing required 'expr' for expression type column: " + rhs.name);
                 }
+                if (node["per_table"]) rhs.per_table = node["per_table"].as<bool>();
+            } else if (*rhs.gen_type == "random_walk" || *rhs.gen_type == "sine" || *rhs.gen_type == "seasonal" ||
+                       *rhs.gen_type == "sawtooth" || *rhs.gen_type == "step") {
+                // Detect forbidden keys in signals
+                check_unknown_keys(node, merge_keys<std::string>({common_keys, timestamp_allowed, signal_allowed}), "columns or tags::" + *rhs.gen_type);
+
+                if (!node["min"] || !node["max"]) {
+                    throw std::runtime_error("min and max are required for gen_type " + *rhs.gen_type + " in column: " + rhs.name);
+                }
+                rhs.min = node["min"].as<double>();
+                rhs.max = node["max"].as<double>();
+                if (*rhs.min >= *rhs.max) {
+                    throw std::runtime_error("min value must be less than max value in column: " + rhs.name);
+                }
+                if (node["mean"]) rhs.mean = node["mean"].as<double>();
+                if (node["stddev"]) rhs.stddev = node["stddev"].as<double>();
+                if (node["amplitude"]) rhs.amplitude = node["amplitude"].as<double>();
+                if (node["period"]) rhs.period = node["period"].as<double>();
+                if (node["phase"]) rhs.phase = node["phase"].as<double>();
+                if (node["noise"]) rhs.noise = node["noise"].as<double>();
+                if (node["drift"]) rhs.drift = node["drift"].as<double>();
+                if (node["boundary"]) rhs.boundary = node["boundary"].as<std::string>();
             } else {
                 throw std::runtime_error("Invalid gen_type: " + *rhs.gen_type);
             }
@@ -782,7 +844,7 @@ namespace YAML {
         static bool decode(const Node& node, TimestampGeneratorConfig& rhs) {
             // Detect unknown configuration keys
             static const std::set<std::string> valid_keys = {
-                "start_timestamp", "timestamp_precision", "timestamp_step"
+                "start_timestamp", "timestamp_precision", "timestamp_step", "timestamp_jitter"
             };
             check_unknown_keys(node, valid_keys, "timestamp_strategy");
 
@@ -796,6 +858,10 @@ namespace YAML {
                 rhs.timestamp_step = node["timestamp_step"].as<std::string>();
                 rhs.timestamp_step = TimestampUtils::parse_step(rhs.timestamp_step, rhs.timestamp_precision);
             }
+            if (node["timestamp_jitter"]) {
+                rhs.timestamp_jitter = node["timestamp_jitter"].as<std::string>();
+                rhs.timestamp_jitter = TimestampUtils::parse_step(rhs.timestamp_jitter, rhs.timestamp_precision);
+            }
             return true;
         }
     };
@@ -1550,7 +1616,7 @@ namespace YAML {
     inline const std::set<std::string> insert_common_keys = {
         "schema", "target", "timestamp_precision",
         "concurrency", "queue_capacity", "queue_warmup_ratio", "shared_queue",
-        "thread_affinity", "thread_realtime",
+        "thread_affinity", "thread_realtime", "huge_pages", "prefault", "memory_limit",
         "failure_handling", "time_interval", "checkpoint"
     };
 
@@ -1607,6 +1673,30 @@ namespace YAML {
                 rhs.thread_realtime = node["thread_realtime"].as<bool>();
             }
 
+            if (node["huge_pages"]) {
+                rhs.huge_pages = node["huge_pages"].as<std::string>();
+                if (rhs.huge_pages != "off" && rhs.huge_pages != "transparent" &&
+                    rhs.huge_pages != "2mb" && rhs.huge_pages != "1gb") {
+                    throw std::runtime_error("Invalid huge_pages value: " + rhs.huge_pages);
+                }
+            }
+
+            if (node["prefault"]) {
+                rhs.prefault = node["prefault"].as<bool>();
+            }
+
+            if (node["memory_limit"]) {
+                const auto limit = node["memory_limit"].as<std::string>();
+                try {
+                    rhs.memory_limit = StringUtils::parse_byte_size(limit);
+                } catch (const std::invalid_argument&) {
+                    throw std::runtime_error("Invalid memory_limit value: " + limit);
+                }
+                if (rhs.memory_limit == 0) {
+                    throw std::runtime_error("memory_limit must be greater than zero.");
+                }
+            }
+
             if (node["failure_handling"]) {
                 rhs.failure_handling = node["failure_handling"].as<InsertDataConfig::FailureHandling>();
             }
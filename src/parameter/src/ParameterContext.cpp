@@ -8,6 +8,13 @@
 #include <sstream>
 #include "CheckpointAction.hpp"
 
+// Whether a step's schema override changes the child tables' names or tags, in
+// which case the step stops sharing the job's table catalog
+static bool overrides_tables(const YAML::Node& schema) {
+    return schema["name"] || schema["from_csv"] || schema["tbname"] || schema["tags"]
+        || (schema["generation"] && schema["generation"]["seed"]);
+}
+
 ParameterContext::ParameterContext() {
     register_core_step_parsers();
 }
@@ -99,6 +106,7 @@ void ParameterContext::parse_jobs(const YAML::Node& jobs_node) {
         Job job;
         job.extensions = config_data.global.extensions;
         job.schema = config_data.global.schema;
+        job.schema.catalog = std::make_shared<TableCatalogSlot>();
 
         job.key = job_node.first.as<std::string>(); // Get job identifier
         const auto& job_content = job_node.second;
@@ -270,6 +278,10 @@ void ParameterContext::parse_td_create_super_table_action(Job& job, Step& step)
             create_stb_config.schema.generation = schema["generation"].as<GenerationConfig>();
         }
         create_stb_config.schema.apply();
+
+        if (overrides_tables(schema)) {
+            create_stb_config.schema.catalog = std::make_shared<TableCatalogSlot>();
+        }
     }
 
     // Validate columns and tags
@@ -324,6 +336,10 @@ void ParameterContext::parse_td_create_child_table_action(Job& job, Step& step)
             create_ctb_config.schema.generation = schema["generation"].as<GenerationConfig>();
         }
         create_ctb_config.schema.apply();
+
+        if (overrides_tables(schema)) {
+            create_ctb_config.schema.catalog = std::make_shared<TableCatalogSlot>();
+        }
     }
 
     // Parse batch (optional)
@@ -403,6 +419,10 @@ void ParameterContext::parse_insert_action(Job& job, Step& step, std::string tar
             insert_config.schema.generation = schema["generation"].as<GenerationConfig>();
         }
         insert_config.schema.apply();
+
+        if (overrides_tables(schema)) {
+            insert_config.schema.catalog = std::make_shared<TableCatalogSlot>();
+        }
     }
 
     if (!step.with["timestamp_precision"]) {
@@ -402,6 +402,125 @@ max: 50.0
     assert(col.max.has_value() && *col.max == 50.0);
 }
 
+void test_ColumnConfig_random_distribution_params() {
+    std::string yaml = R"(
+name: brand
+type: varchar(8)
+distribution: zipf
+skew: 1.5
+values: ["a", "b", "c"]
+weights: [5, 3, 2]
+)";
+    YAML::Node node = YAML::Load(yaml);
+    ColumnConfig col = node.as<ColumnConfig>();
+    assert(col.distribution.has_value() && *col.distribution == "zipf");
+    assert(col.skew.has_value() && *col.skew == 1.5);
+    assert(col.weights.size() == 3 && col.weights[0] == 5.0);
+
+    std::string mismatch = R"(
+name: brand
+type: varchar(8)
+values: ["a", "b"]
+weights: [1]
+)";
+    try {
+        YAML::Load(mismatch).as<ColumnConfig>();
+        assert(false && "Should throw for weights/values size mismatch");
+    } catch (const std::exception&) {}
+
+    std::string unknown = R"(
+name: v
+type: int
+distribution: poisson
+)";
+    try {
+        YAML::Load(unknown).as<ColumnConfig>();
+        assert(false && "Should throw for unknown distribution");
+    } catch (const std::exception&) {}
+}
+
+void test_ColumnConfig_random_words() {
+    std::string yaml = R"(
+name: message
+type: varchar(64)
+words: ["disk", "full", "retry"]
+min: 8
+max: 40
+distribution: normal
+)";
+    YAML::Node node = YAML::Load(yaml);
+    ColumnConfig col = node.as<ColumnConfig>();
+    assert(col.words.size() == 3 && col.words[2] == "retry");
+    assert(col.min.has_value() && *col.min == 8);
+    assert(col.max.has_value() && *col.max == 40);
+
+    std::string empty = R"(
+name: message
+type: varchar(64)
+words: []
+)";
+    try {
+        YAML::Load(empty).as<ColumnConfig>();
+        assert(false && "Should throw for an empty word list");
+    } catch (const std::exception&) {}
+}
+
+void test_ColumnConfig_signal() {
+    std::string yaml = R"(
+name: battery_voltage
+type: float
+gen_type: random_walk
+min: 410
+max: 430
+mean: 430
+drift: -0.005
+stddev: 0.003
+boundary: wrap
+)";
+    ColumnConfig col = YAML::Load(yaml).as<ColumnConfig>();
+    assert(col.gen_type == "random_walk");
+    assert(*col.min == 410 && *col.max == 430 && *col.mean == 430);
+    assert(*col.drift == -0.005 && *col.stddev == 0.003);
+    assert(col.boundary == "wrap");
+
+    std::string sine = R"(
+name: temperature
+type: double
+gen_type: sine
+min: 10
+max: 30
+period: 1440
+phase: 0.25
+noise: 0.5
+)";
+    col = YAML::Load(sine).as<ColumnConfig>();
+    assert(*col.period == 1440 && *col.phase == 0.25 && *col.noise == 0.5);
+
+    std::string missing_bounds = R"(
+name: temperature
+type: double
+gen_type: sawtooth
+max: 30
+)";
+    try {
+        YAML::Load(missing_bounds).as<ColumnConfig>();
+        assert(false && "Should throw without min");
+    } catch (const std::runtime_error&) {}
+
+    std::string wrong_key = R"(
+name: temperature
+type: double
+gen_type: step
+min: 0
+max: 1
+values: [1, 2]
+)";
+    try {
+        YAML::Load(wrong_key).as<ColumnConfig>();
+        assert(false && "Should throw for a random key");
+    } catch (const std::runtime_error&) {}
+}
+
 void test_ColumnConfig_order() {
     std::string yaml = R"(
 name: id
@@ -433,6 +552,20 @@ expr: "2*sinusoid(period=10,min=0,max=10)+3"
     assert(col.gen_type.has_value() && *col.gen_type == "expression");
     assert(col.formula.has_value());
     assert(col.formula == "2*sinusoid(period=10,min=0,max=10)+3");
+    assert(!col.per_table.has_value());
+}
+
+void test_ColumnConfig_expression_per_table() {
+    std::string yaml = R"(
+name: vin
+type: varchar(17)
+expr: "({'A', 'B'})[tonumber(string.match(_table, '%d+'))]"
+per_table: true
+)";
+    YAML::Node node = YAML::Load(yaml);
+    ColumnConfig col = node.as<ColumnConfig>();
+    assert(col.gen_type.has_value() && *col.gen_type == "expression");
+    assert(col.per_table.has_value() && *col.per_table);
 }
 
 void test_ColumnConfig_strip_backticks_plain() {
@@ -1161,8 +1294,12 @@ int main() {
     test_DataChannel();
     test_DatabaseInfo();
     test_ColumnConfig_random();
+    test_ColumnConfig_random_distribution_params();
+    test_ColumnConfig_random_words();
+    test_ColumnConfig_signal();
     test_ColumnConfig_order();
     test_ColumnConfig_expression();
+    test_ColumnConfig_expression_per_table();
     test_ColumnConfig_strip_backticks_plain();
     test_ColumnConfig_strip_backticks_unmatched();
     test_ColumnConfig_strip_backticks_none();
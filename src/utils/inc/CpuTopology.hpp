@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+// NUMA layout of the machine's CPUs. On Linux it is read from sysfs; elsewhere,
+// or when sysfs has no node information, every CPU is on a single node 0.
+class CpuTopology {
+public:
+    // Topology of this machine, read once
+    static const CpuTopology& instance();
+
+    // Parse a sysfs CPU list such as "0-3,8,10-11"
+    static std::vector<int> parse_cpu_list(const std::string& list);
+
+    // One CPU list per node; empty nodes are dropped
+    explicit CpuTopology(std::vector<std::vector<int>> nodes);
+
+    size_t node_count() const { return nodes_.size(); }
+    const std::vector<int>& cpus(size_t node) const { return nodes_[node % nodes_.size()]; }
+
+    // Node of a CPU, 0 when unknown
+    size_t node_of_cpu(int cpu) const;
+
+    // Node the calling thread is running on
+    size_t current_node() const;
+
+    // rank-th CPU of a node, counted from its last CPU when reverse; wraps
+    // around when the node has fewer CPUs
+    int cpu_for(size_t node, size_t rank, bool reverse = false) const;
+
+    // Restrict the calling thread to the CPUs of a node
+    bool bind_to_node(size_t node) const;
+
+private:
+    std::vector<std::vector<int>> nodes_;
+    std::vector<size_t> cpu_nodes_;         // Node of each CPU id
+};
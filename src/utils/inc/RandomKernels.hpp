@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// Block random number kernels for columnar generation.
+// Each thread owns 8 interleaved xoshiro128+ lanes; the raw stream is produced
+// with AVX2 or NEON when available and a portable scalar loop otherwise.
+// A CounterScope switches the thread to a seeded, counter-based stream.
+namespace RandomKernels {
+
+    // Name of the kernel selected at runtime: "avx2", "neon" or "scalar"
+    const char* active_isa();
+
+    // Raw 32-bit random words
+    void fill_u32(uint32_t* out, size_t count);
+
+    // Uniform integers in [lo, hi] (inclusive), multiply-shift bounded
+    void fill_bounded(int8_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(uint8_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(int16_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(uint16_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(int32_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(uint32_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(int64_t* out, size_t count, int64_t lo, int64_t hi);
+    void fill_bounded(uint64_t* out, size_t count, uint64_t lo, uint64_t hi);
+
+    // Uniform reals in [lo, hi)
+    void fill_uniform(float* out, size_t count, float lo, float hi);
+    void fill_uniform(double* out, size_t count, double lo, double hi);
+
+    // Fair coin flips
+    void fill_bool(bool* out, size_t count);
+
+    // 64-bit masks whose bits are set independently with probability p
+    // (p is quantized to 1/65536)
+    void fill_mask(uint64_t* out, size_t count, double p);
+
+    // Next raw word, for draws of a single value
+    uint32_t next_u32();
+
+    // Next real in [0, 1) with 53 random bits, built from two words
+    double next_unit();
+
+    // UniformRandomBitGenerator over next_u32(), for std distributions
+    struct WordEngine {
+        using result_type = uint32_t;
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT32_MAX; }
+        result_type operator()() const { return next_u32(); }
+    };
+
+    // Shared engine for single draws, e.g. std distributions over a value list
+    inline WordEngine word_engine;
+
+    // Counter-based mode (Philox4x32-10). While a CounterScope is alive on a
+    // thread, every draw above is a pure function of (key, row, column, draw
+    // index): seek() selects the cell and restarts its draws, so any row can be
+    // regenerated on any thread in any order.
+    class CounterScope {
+    public:
+        // Inactive (thread lane streams are used) when key is empty
+        explicit CounterScope(std::optional<uint64_t> key);
+        ~CounterScope();
+
+        CounterScope(const CounterScope&) = delete;
+        CounterScope& operator=(const CounterScope&) = delete;
+
+        bool active() const { return active_; }
+        void seek(uint64_t row, uint32_t column);
+
+        // Raw words at the current position; count must be a multiple of 4
+        void fill(uint32_t* out, size_t count);
+        uint32_t next();
+
+    private:
+        uint32_t key_[2] = {};
+        uint32_t counter_[4] = {};      // draw, column, row low, row high
+        uint32_t buffer_[4] = {};
+        unsigned buffered_ = 0;
+        CounterScope* previous_ = nullptr;
+        bool active_ = false;
+    };
+
+    // Whether a CounterScope is active on this thread
+    bool counter_mode();
+
+    // Key of a named stream (e.g. a table) under a run seed
+    uint64_t stream_key(uint64_t seed, std::string_view name);
+}
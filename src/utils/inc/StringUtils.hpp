@@ -15,4 +15,13 @@ public:
 
     static std::u16string utf8_to_u16string(const std::string& str);
     static std::string u16string_to_utf8(const std::u16string& str);
+
+    // Encode straight into dest; stops before a character that would not fit
+    static size_t u16string_to_utf8(const std::u16string& str, char* dest, size_t max_len);
+
+    // "8GB", "512 MiB", "65536": a count with an optional B/KB/MB/GB/TB suffix
+    // (binary multiples, case-insensitive); throws std::invalid_argument
+    static size_t parse_byte_size(const std::string& str);
+    // Largest unit that keeps the value at least 1, e.g. "1.50 GB"
+    static std::string format_byte_size(size_t bytes);
 };
\ No newline at end of file
@@ -4,9 +4,27 @@
 #include <chrono>
 #include <variant>
 #include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 
 class TimestampUtils {
 public:
+    // Precision conversion resolved once, applied per value without lookups
+    class PrecisionConverter {
+    public:
+        PrecisionConverter() = default;
+        PrecisionConverter(const std::string& from_precision, const std::string& to_precision);
+
+        bool identity() const { return multiplier_ == 1 && divisor_ == 1; }
+
+        int64_t operator()(int64_t ts) const { return (ts * multiplier_) / divisor_; }
+        void apply(int64_t* values, size_t count) const;
+
+    private:
+        int64_t multiplier_ = 1;
+        int64_t divisor_ = 1;
+    };
+
     static int64_t get_precision_multiplier(const std::string& precision);
 
     static std::tuple<int64_t, int64_t> get_precision_factor(
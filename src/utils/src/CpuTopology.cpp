@@ -0,0 +1,133 @@
+#include "CpuTopology.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+static std::string read_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+static std::vector<std::vector<int>> detect_nodes() {
+    std::vector<std::vector<int>> nodes;
+
+#if defined(__linux__)
+    const std::string root = "/sys/devices/system/node/";
+    for (int node : CpuTopology::parse_cpu_list(read_line(root + "online"))) {
+        nodes.push_back(CpuTopology::parse_cpu_list(read_line(root + "node" + std::to_string(node) + "/cpulist")));
+    }
+#endif
+
+    const bool known = std::any_of(nodes.begin(), nodes.end(), [](const std::vector<int>& cpus) {
+        return !cpus.empty();
+    });
+    if (!known) {
+        unsigned int num_cores = std::thread::hardware_concurrency();
+        if (num_cores == 0) num_cores = 1;
+
+        nodes.assign(1, {});
+        for (unsigned int cpu = 0; cpu < num_cores; ++cpu) {
+            nodes[0].push_back(static_cast<int>(cpu));
+        }
+    }
+    return nodes;
+}
+
+const CpuTopology& CpuTopology::instance() {
+    static const CpuTopology topology(detect_nodes());
+    return topology;
+}
+
+std::vector<int> CpuTopology::parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        const auto dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                const int first = std::stoi(range.substr(0, dash));
+                const int last = std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (const std::exception&) {
+            // Blank or malformed entry
+        }
+    }
+    return cpus;
+}
+
+CpuTopology::CpuTopology(std::vector<std::vector<int>> nodes) {
+    for (auto& cpus : nodes) {
+        if (!cpus.empty()) {
+            nodes_.push_back(std::move(cpus));
+        }
+    }
+    if (nodes_.empty()) {
+        nodes_.push_back({0});
+    }
+
+    for (size_t node = 0; node < nodes_.size(); ++node) {
+        for (int cpu : nodes_[node]) {
+            if (cpu < 0) continue;
+            if (static_cast<size_t>(cpu) >= cpu_nodes_.size()) {
+                cpu_nodes_.resize(cpu + 1, 0);
+            }
+            cpu_nodes_[cpu] = node;
+        }
+    }
+}
+
+size_t CpuTopology::node_of_cpu(int cpu) const {
+    if (cpu < 0 || static_cast<size_t>(cpu) >= cpu_nodes_.size()) {
+        return 0;
+    }
+    return cpu_nodes_[cpu];
+}
+
+size_t CpuTopology::current_node() const {
+    if (nodes_.size() == 1) {
+        return 0;
+    }
+#if defined(__linux__)
+    return node_of_cpu(sched_getcpu());
+#else
+    return 0;
+#endif
+}
+
+int CpuTopology::cpu_for(size_t node, size_t rank, bool reverse) const {
+    const auto& list = cpus(node);
+    const size_t index = rank % list.size();
+    return reverse ? list[list.size() - 1 - index] : list[index];
+}
+
+bool CpuTopology::bind_to_node(size_t node) const {
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int cpu : cpus(node)) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuset);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
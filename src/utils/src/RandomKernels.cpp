@@ -0,0 +1,403 @@
+#include "RandomKernels.hpp"
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RANDOM_KERNELS_X86 1
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace RandomKernels {
+namespace {
+    constexpr size_t LANES = 8;
+    constexpr size_t CHUNK = 256;   // Raw words produced per kernel call
+
+    // 8 interleaved xoshiro128+ generators, stored lane-major for SIMD loads
+    struct alignas(32) LaneState {
+        uint32_t s0[LANES];
+        uint32_t s1[LANES];
+        uint32_t s2[LANES];
+        uint32_t s3[LANES];
+
+        LaneState() {
+            std::random_device rd;
+            uint64_t seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+
+            // splitmix64 expands the seed into independent lane states
+            auto next = [&seed]() {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            };
+
+            for (size_t l = 0; l < LANES; ++l) {
+                uint64_t a = next();
+                uint64_t b = next();
+                s0[l] = static_cast<uint32_t>(a);
+                s1[l] = static_cast<uint32_t>(a >> 32);
+                s2[l] = static_cast<uint32_t>(b);
+                s3[l] = static_cast<uint32_t>(b >> 32) | 1u;  // state must not be all zero
+            }
+        }
+    };
+
+    thread_local LaneState lane_state;
+    thread_local CounterScope* counter_scope = nullptr;
+
+    uint64_t splitmix64(uint64_t x) {
+        uint64_t z = x + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+    void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+            const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+            const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c1 = static_cast<uint32_t>(p1);
+            c3 = static_cast<uint32_t>(p0);
+            c0 = n0;
+            c2 = n2;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    using RawKernel = void(*)(LaneState&, uint32_t*, size_t);
+
+    // count must be a multiple of LANES
+    void raw_scalar(LaneState& st, uint32_t* out, size_t count) {
+        for (size_t i = 0; i < count; i += LANES) {
+            for (size_t l = 0; l < LANES; ++l) {
+                out[i + l] = st.s0[l] + st.s3[l];
+                const uint32_t t = st.s1[l] << 9;
+                st.s2[l] ^= st.s0[l];
+                st.s3[l] ^= st.s1[l];
+                st.s1[l] ^= st.s2[l];
+                st.s0[l] ^= st.s3[l];
+                st.s2[l] ^= t;
+                st.s3[l] = (st.s3[l] << 11) | (st.s3[l] >> 21);
+            }
+        }
+    }
+
+#ifdef RANDOM_KERNELS_X86
+    __attribute__((target("avx2")))
+    void raw_avx2(LaneState& st, uint32_t* out, size_t count) {
+        __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s0));
+        __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s1));
+        __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s2));
+        __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(st.s3));
+
+        for (size_t i = 0; i < count; i += LANES) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(s0, s3));
+            const __m256i t = _mm256_slli_epi32(s1, 9);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+        }
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(st.s0), s0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(st.s1), s1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(st.s2), s2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(st.s3), s3);
+    }
+#endif
+
+#ifdef __ARM_NEON
+    void raw_neon(LaneState& st, uint32_t* out, size_t count) {
+        uint32x4_t s0[2] = { vld1q_u32(st.s0), vld1q_u32(st.s0 + 4) };
+        uint32x4_t s1[2] = { vld1q_u32(st.s1), vld1q_u32(st.s1 + 4) };
+        uint32x4_t s2[2] = { vld1q_u32(st.s2), vld1q_u32(st.s2 + 4) };
+        uint32x4_t s3[2] = { vld1q_u32(st.s3), vld1q_u32(st.s3 + 4) };
+
+        for (size_t i = 0; i < count; i += LANES) {
+            for (int h = 0; h < 2; ++h) {
+                vst1q_u32(out + i + h * 4, vaddq_u32(s0[h], s3[h]));
+                const uint32x4_t t = vshlq_n_u32(s1[h], 9);
+                s2[h] = veorq_u32(s2[h], s0[h]);
+                s3[h] = veorq_u32(s3[h], s1[h]);
+                s1[h] = veorq_u32(s1[h], s2[h]);
+                s0[h] = veorq_u32(s0[h], s3[h]);
+                s2[h] = veorq_u32(s2[h], t);
+                s3[h] = vorrq_u32(vshlq_n_u32(s3[h], 11), vshrq_n_u32(s3[h], 21));
+            }
+        }
+
+        for (int h = 0; h < 2; ++h) {
+            vst1q_u32(st.s0 + h * 4, s0[h]);
+            vst1q_u32(st.s1 + h * 4, s1[h]);
+            vst1q_u32(st.s2 + h * 4, s2[h]);
+            vst1q_u32(st.s3 + h * 4, s3[h]);
+        }
+    }
+#endif
+
+    struct KernelInfo {
+        RawKernel kernel;
+        const char* isa;
+    };
+
+    const KernelInfo& kernel_info() {
+        static const KernelInfo info = []() -> KernelInfo {
+#ifdef RANDOM_KERNELS_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return {raw_avx2, "avx2"};
+            }
+#endif
+#ifdef __ARM_NEON
+            return {raw_neon, "neon"};
+#endif
+            return {raw_scalar, "scalar"};
+        }();
+        return info;
+    }
+
+    // count raw words from the active stream; count must be a multiple of LANES
+    void draw_raw(uint32_t* raw, size_t count) {
+        if (counter_scope) {
+            counter_scope->fill(raw, count);
+        } else {
+            kernel_info().kernel(lane_state, raw, count);
+        }
+    }
+
+    // Feed the raw stream to body(raw, first_index, n) in CHUNK sized pieces
+    template<typename F>
+    void for_each_chunk(size_t count, F&& body) {
+        alignas(32) uint32_t raw[CHUNK];
+
+        for (size_t done = 0; done < count; ) {
+            const size_t n = std::min(CHUNK, count - done);
+            draw_raw(raw, (n + LANES - 1) / LANES * LANES);
+            body(raw, done, n);
+            done += n;
+        }
+    }
+
+    // Buffered words for next_u32() outside counter mode
+    struct WordBuffer {
+        alignas(32) uint32_t words[CHUNK];
+        size_t pos = CHUNK;
+    };
+
+    thread_local WordBuffer word_buffer;
+
+    // Types up to 32 bits: the span always fits, one word per value
+    template<typename T>
+    void bounded_narrow(T* out, size_t count, int64_t lo, int64_t hi) {
+        if (hi < lo) {
+            throw std::invalid_argument("RandomKernels: empty integer range");
+        }
+        const uint64_t span = static_cast<uint64_t>(hi - lo) + 1;
+
+        for_each_chunk(count, [&](const uint32_t* raw, size_t first, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                const uint64_t offset = (static_cast<uint64_t>(raw[i]) * span) >> 32;
+                out[first + i] = static_cast<T>(lo + static_cast<int64_t>(offset));
+            }
+        });
+    }
+
+    // 64-bit types: two words per value, 128-bit multiply-shift
+    void bounded_wide(uint64_t* out, size_t count, uint64_t lo, uint64_t span_minus_one) {
+        for_each_chunk(count * 2, [&](const uint32_t* raw, size_t first, size_t n) {
+            for (size_t i = 0; i + 1 < n; i += 2) {
+                const uint64_t x = (static_cast<uint64_t>(raw[i]) << 32) | raw[i + 1];
+                uint64_t offset = x;
+                if (span_minus_one != UINT64_MAX) {
+                    offset = static_cast<uint64_t>(
+                        (static_cast<unsigned __int128>(x) * (span_minus_one + 1)) >> 64);
+                }
+                out[(first + i) / 2] = lo + offset;
+            }
+        });
+    }
+}
+
+const char* active_isa() {
+    return kernel_info().isa;
+}
+
+void fill_u32(uint32_t* out, size_t count) {
+    for_each_chunk(count, [out](const uint32_t* raw, size_t first, size_t n) {
+        std::copy(raw, raw + n, out + first);
+    });
+}
+
+void fill_bounded(int8_t* out, size_t count, int64_t lo, int64_t hi) { bounded_narrow(out, count, lo, hi); }
+void fill_bounded(uint8_t* out, size_t count, int64_t lo, int64_t hi) { bounded_narrow(out, count, lo, hi); }
+void fill_bounded(int16_t* out, size_t count, int64_t lo, int64_t hi) { bounded_narrow(out, count, lo, hi); }
+void fill_bounded(uint16_t* out, size_t count, int64_t lo, int64_t hi) { bounded_narrow(out, count, lo, hi); }
+void fill_bounded(int32_t* out, size_t count, int64_t lo, int64_t hi) { bounded_narrow(out, count, lo, hi); }
+void fill_bounded(uint32_t* out, size_t count, int64_t lo, int64_t hi) { bounded_narrow(out, count, lo, hi); }
+
+void fill_bounded(int64_t* out, size_t count, int64_t lo, int64_t hi) {
+    if (hi < lo) {
+        throw std::invalid_argument("RandomKernels: empty integer range");
+    }
+    const uint64_t span_minus_one = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    bounded_wide(reinterpret_cast<uint64_t*>(out), count, static_cast<uint64_t>(lo), span_minus_one);
+}
+
+void fill_bounded(uint64_t* out, size_t count, uint64_t lo, uint64_t hi) {
+    if (hi < lo) {
+        throw std::invalid_argument("RandomKernels: empty integer range");
+    }
+    bounded_wide(out, count, lo, hi - lo);
+}
+
+void fill_uniform(float* out, size_t count, float lo, float hi) {
+    const float scale = hi - lo;
+    for_each_chunk(count, [&](const uint32_t* raw, size_t first, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[first + i] = lo + scale * (static_cast<float>(raw[i] >> 8) * 0x1.0p-24f);
+        }
+    });
+}
+
+void fill_uniform(double* out, size_t count, double lo, double hi) {
+    const double scale = hi - lo;
+    for_each_chunk(count * 2, [&](const uint32_t* raw, size_t first, size_t n) {
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            const uint64_t bits = (static_cast<uint64_t>(raw[i]) << 21) ^ (raw[i + 1] >> 11);
+            out[(first + i) / 2] = lo + scale * (static_cast<double>(bits & ((1ULL << 53) - 1)) * 0x1.0p-53);
+        }
+    });
+}
+
+void fill_bool(bool* out, size_t count) {
+    for_each_chunk(count, [out](const uint32_t* raw, size_t first, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[first + i] = (raw[i] >> 31) != 0;
+        }
+    });
+}
+
+void fill_mask(uint64_t* out, size_t count, double p) {
+    const uint32_t q = p <= 0 ? 0u : (p >= 1 ? 65536u : static_cast<uint32_t>(std::lround(p * 65536.0)));
+    if (q == 0 || q >= 65536) {
+        std::fill(out, out + count, q == 0 ? uint64_t{0} : ~uint64_t{0});
+        return;
+    }
+
+    // Combine one random word per bit of q, least significant first:
+    // a set bit ORs (probability moves to 1/2 + p/2), a clear bit ANDs (p/2)
+    const int lowest = __builtin_ctz(q);
+    const size_t per_mask = static_cast<size_t>(16 - lowest) * 2;
+    const size_t group = CHUNK / per_mask;
+
+    alignas(32) uint32_t raw[CHUNK];
+
+    for (size_t done = 0; done < count; ) {
+        const size_t n = std::min(group, count - done);
+        draw_raw(raw, (n * per_mask + LANES - 1) / LANES * LANES);
+
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t* r = raw + i * per_mask;
+            uint64_t mask = 0;
+            for (int bit = lowest; bit < 16; ++bit, r += 2) {
+                const uint64_t word = (static_cast<uint64_t>(r[0]) << 32) | r[1];
+                mask = ((q >> bit) & 1) ? (mask | word) : (mask & word);
+            }
+            out[done + i] = mask;
+        }
+        done += n;
+    }
+}
+
+uint32_t next_u32() {
+    if (counter_scope) {
+        return counter_scope->next();
+    }
+
+    WordBuffer& buffer = word_buffer;
+    if (buffer.pos == CHUNK) {
+        kernel_info().kernel(lane_state, buffer.words, CHUNK);
+        buffer.pos = 0;
+    }
+    return buffer.words[buffer.pos++];
+}
+
+double next_unit() {
+    const uint64_t hi = next_u32();
+    const uint64_t lo = next_u32();
+    const uint64_t bits = (hi << 21) ^ (lo >> 11);
+    return static_cast<double>(bits) * 0x1.0p-53;
+}
+
+CounterScope::CounterScope(std::optional<uint64_t> key) {
+    if (!key) return;
+
+    key_[0] = static_cast<uint32_t>(*key);
+    key_[1] = static_cast<uint32_t>(*key >> 32);
+    previous_ = counter_scope;
+    counter_scope = this;
+    active_ = true;
+}
+
+CounterScope::~CounterScope() {
+    if (active_) {
+        counter_scope = previous_;
+    }
+}
+
+void CounterScope::seek(uint64_t row, uint32_t column) {
+    counter_[0] = 0;
+    counter_[1] = column;
+    counter_[2] = static_cast<uint32_t>(row);
+    counter_[3] = static_cast<uint32_t>(row >> 32);
+    buffered_ = 0;
+}
+
+void CounterScope::fill(uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 4) {
+        philox4x32(counter_, key_, out + i);
+        ++counter_[0];
+    }
+}
+
+uint32_t CounterScope::next() {
+    if (buffered_ == 0) {
+        philox4x32(counter_, key_, buffer_);
+        ++counter_[0];
+        buffered_ = 4;
+    }
+    return buffer_[4 - buffered_--];
+}
+
+bool counter_mode() {
+    return counter_scope != nullptr;
+}
+
+uint64_t stream_key(uint64_t seed, std::string_view name) {
+    // FNV-1a keeps keys stable across platforms and standard libraries
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+    }
+    return splitmix64(seed ^ splitmix64(hash));
+}
+
+}
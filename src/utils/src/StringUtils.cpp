@@ -6,6 +6,8 @@
 #include <iconv.h>
 #include <stdexcept>
 #include <vector>
+#include <limits>
+#include <cstdio>
 
 std::string StringUtils::to_lower(const std::string& str) {
     std::string lower_str = str;
@@ -37,10 +39,121 @@ void StringUtils::remove_all_spaces(std::string& str) {
         str.end());
 }
 
-// iconv-based utf8 to u16string
+size_t StringUtils::parse_byte_size(const std::string& str) {
+    std::string text = str;
+    trim(text);
+
+    size_t digits = 0;
+    while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) {
+        ++digits;
+    }
+    if (digits == 0 || digits > 19) {
+        throw std::invalid_argument("Invalid byte size: " + str);
+    }
+    const unsigned long long value = std::stoull(text.substr(0, digits));
+
+    std::string unit = to_upper(text.substr(digits));
+    trim(unit);
+    if (unit.size() == 3 && unit[1] == 'I' && unit[2] == 'B') {
+        unit.erase(1, 1);
+    } else if (unit.size() == 2 && unit[1] == 'B') {
+        // KB, MB, ...
+    } else if (unit.size() == 1 && unit != "B") {
+        unit += 'B';
+    }
+
+    static const char* const units[] = {"B", "KB", "MB", "GB", "TB"};
+    for (size_t shift = 0; shift < std::size(units); ++shift) {
+        if (unit == units[shift] || (shift == 0 && unit.empty())) {
+            const unsigned long long multiple = 1ULL << (10 * shift);
+            if (value > std::numeric_limits<size_t>::max() / multiple) {
+                throw std::invalid_argument("Byte size out of range: " + str);
+            }
+            return static_cast<size_t>(value * multiple);
+        }
+    }
+    throw std::invalid_argument("Invalid byte size unit: " + str);
+}
+
+std::string StringUtils::format_byte_size(size_t bytes) {
+    static const char* const units[] = {"B", "KB", "MB", "GB", "TB"};
+    size_t unit = 0;
+    double value = static_cast<double>(bytes);
+    while (value >= 1024.0 && unit + 1 < std::size(units)) {
+        value /= 1024.0;
+        ++unit;
+    }
+
+    char buffer[32];
+    if (unit == 0) {
+        std::snprintf(buffer, sizeof(buffer), "%zu B", bytes);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2f %s", value, units[unit]);
+    }
+    return buffer;
+}
+
+namespace {
+    // iconv descriptor opened once per thread and reset before each use
+    class IconvConverter {
+    public:
+        IconvConverter(const char* to, const char* from) : cd_(iconv_open(to, from)) {}
+        ~IconvConverter() {
+            if (valid()) iconv_close(cd_);
+        }
+
+        IconvConverter(const IconvConverter&) = delete;
+        IconvConverter& operator=(const IconvConverter&) = delete;
+
+        bool valid() const { return cd_ != (iconv_t)-1; }
+
+        size_t convert(char** inbuf, size_t* inbytesleft, char** outbuf, size_t* outbytesleft) {
+            iconv(cd_, nullptr, nullptr, nullptr, nullptr);
+            return iconv(cd_, inbuf, inbytesleft, outbuf, outbytesleft);
+        }
+
+    private:
+        iconv_t cd_;
+    };
+
+    bool is_ascii(const std::string& str) {
+        for (unsigned char c : str) {
+            if (c >= 0x80) return false;
+        }
+        return true;
+    }
+
+    // Bytes of the UTF-8 encoding of str[i] (and its low surrogate), 0 if malformed
+    size_t utf8_size(const std::u16string& str, size_t i, char32_t& cp) {
+        const char16_t unit = str[i];
+        if (unit < 0x80) {
+            cp = unit;
+            return 1;
+        }
+        if (unit < 0x800) {
+            cp = unit;
+            return 2;
+        }
+        if (unit < 0xD800 || unit > 0xDFFF) {
+            cp = unit;
+            return 3;
+        }
+        if (unit <= 0xDBFF && i + 1 < str.size() && str[i + 1] >= 0xDC00 && str[i + 1] <= 0xDFFF) {
+            cp = 0x10000 + ((static_cast<char32_t>(unit) - 0xD800) << 10) + (str[i + 1] - 0xDC00);
+            return 4;
+        }
+        return 0;
+    }
+}
+
+// utf8 to u16string through a cached iconv descriptor, ASCII widened directly
 std::u16string StringUtils::utf8_to_u16string(const std::string& str) {
-    iconv_t cd = iconv_open("UTF-16LE", "UTF-8");
-    if (cd == (iconv_t)-1) {
+    if (is_ascii(str)) {
+        return std::u16string(str.begin(), str.end());
+    }
+
+    thread_local IconvConverter converter("UTF-16LE", "UTF-8");
+    if (!converter.valid()) {
         throw std::runtime_error("iconv_open failed for UTF-8 to UTF-16LE");
     }
 
@@ -50,8 +163,7 @@ std::u16string StringUtils::utf8_to_u16string(const std::string& str) {
     char* inbuf = const_cast<char*>(str.data());
     char* outptr = outbuf.data();
 
-    size_t res = iconv(cd, &inbuf, &inbytesleft, &outptr, &outbytesleft);
-    iconv_close(cd);
+    size_t res = converter.convert(&inbuf, &inbytesleft, &outptr, &outbytesleft);
 
     if (res == (size_t)-1) {
         throw std::runtime_error("iconv conversion failed (utf8_to_u16string)");
@@ -62,25 +174,47 @@ std::u16string StringUtils::utf8_to_u16string(const std::string& str) {
     return result;
 }
 
-// iconv-based u16string to utf8
 std::string StringUtils::u16string_to_utf8(const std::u16string& str) {
-    iconv_t cd = iconv_open("UTF-8", "UTF-16LE");
-    if (cd == (iconv_t)-1) {
-        throw std::runtime_error("iconv_open failed for UTF-16LE to UTF-8");
-    }
-
-    size_t inbytesleft = str.size() * 2;
-    size_t outbytesleft = inbytesleft * 2 + 1;
-    std::vector<char> outbuf(outbytesleft);
-    char* inbuf = reinterpret_cast<char*>(const_cast<char16_t*>(str.data()));
-    char* outptr = outbuf.data();
+    std::string result(str.size() * 3, '\0');
+    result.resize(u16string_to_utf8(str, result.data(), result.size()));
+    return result;
+}
 
-    size_t res = iconv(cd, &inbuf, &inbytesleft, &outptr, &outbytesleft);
-    iconv_close(cd);
+size_t StringUtils::u16string_to_utf8(const std::u16string& str, char* dest, size_t max_len) {
+    size_t written = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        char32_t cp;
+        const size_t size = utf8_size(str, i, cp);
+        if (size == 0) {
+            throw std::runtime_error("invalid UTF-16 surrogate (u16string_to_utf8)");
+        }
+        if (written + size > max_len) {
+            break;
+        }
 
-    if (res == (size_t)-1) {
-        throw std::runtime_error("iconv conversion failed (u16string_to_utf8)");
+        char* out = dest + written;
+        switch (size) {
+            case 1:
+                out[0] = static_cast<char>(cp);
+                break;
+            case 2:
+                out[0] = static_cast<char>(0xC0 | (cp >> 6));
+                out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                break;
+            case 3:
+                out[0] = static_cast<char>(0xE0 | (cp >> 12));
+                out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+                break;
+            default:
+                out[0] = static_cast<char>(0xF0 | (cp >> 18));
+                out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+                ++i;
+                break;
+        }
+        written += size;
     }
-
-    return std::string(outbuf.data(), outptr - outbuf.data());
-}
\ No newline at end of file
+    return written;
+}
@@ -37,6 +37,28 @@ std::tuple<int64_t, int64_t> TimestampUtils::get_precision_factor(
     return {from_factor, to_factor};
 }
 
+TimestampUtils::PrecisionConverter::PrecisionConverter(
+    const std::string& from_precision,
+    const std::string& to_precision) {
+
+    auto [from_factor, to_factor] = get_precision_factor(from_precision, to_precision);
+
+    // Factors are powers of 1000, so one side always reduces to 1
+    const int64_t common = std::min(from_factor, to_factor);
+    multiplier_ = from_factor / common;
+    divisor_ = to_factor / common;
+}
+
+void TimestampUtils::PrecisionConverter::apply(int64_t* values, size_t count) const {
+    if (identity()) return;
+
+    if (divisor_ == 1) {
+        for (size_t i = 0; i < count; ++i) values[i] *= multiplier_;
+    } else {
+        for (size_t i = 0; i < count; ++i) values[i] = (values[i] * multiplier_) / divisor_;
+    }
+}
+
 int64_t TimestampUtils::convert_timestamp_precision(
     int64_t ts,
     const std::string& from_precision,
@@ -0,0 +1,43 @@
+#include "CpuTopology.hpp"
+#include <cassert>
+#include <iostream>
+
+void test_parse_cpu_list() {
+    assert(CpuTopology::parse_cpu_list("0-3,8,10-11") == (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    assert(CpuTopology::parse_cpu_list("5") == std::vector<int>{5});
+    assert(CpuTopology::parse_cpu_list("").empty());
+    std::cout << "test_parse_cpu_list passed\n";
+}
+
+void test_two_nodes() {
+    CpuTopology topology({{0, 1, 2, 3}, {}, {4, 5, 6, 7}});
+    assert(topology.node_count() == 2);
+    assert(topology.node_of_cpu(2) == 0);
+    assert(topology.node_of_cpu(6) == 1);
+    assert(topology.node_of_cpu(99) == 0);
+
+    assert(topology.cpu_for(1, 0) == 4);
+    assert(topology.cpu_for(1, 5) == 5);
+    assert(topology.cpu_for(1, 0, true) == 7);
+    assert(topology.cpu_for(0, 1, true) == 2);
+    std::cout << "test_two_nodes passed\n";
+}
+
+void test_machine_topology() {
+    const auto& topology = CpuTopology::instance();
+    assert(topology.node_count() >= 1);
+    assert(topology.current_node() < topology.node_count());
+    for (size_t node = 0; node < topology.node_count(); ++node) {
+        assert(!topology.cpus(node).empty());
+    }
+    std::cout << "test_machine_topology passed, nodes = " << topology.node_count() << "\n";
+}
+
+int main() {
+    test_parse_cpu_list();
+    test_two_nodes();
+    test_machine_topology();
+
+    std::cout << "All CpuTopology tests passed!\n";
+    return 0;
+}
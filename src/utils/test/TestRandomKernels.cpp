@@ -0,0 +1,222 @@
+#include "RandomKernels.hpp"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+void test_active_isa() {
+    std::string isa = RandomKernels::active_isa();
+    (void)isa;
+    assert(isa == "avx2" || isa == "neon" || isa == "scalar");
+    std::cout << "test_active_isa passed (" << isa << ").\n";
+}
+
+void test_fill_u32_odd_count() {
+    // Count that is not a multiple of the lane width
+    std::vector<uint32_t> buffer(1003, 0);
+    RandomKernels::fill_u32(buffer.data(), buffer.size());
+
+    std::set<uint32_t> distinct(buffer.begin(), buffer.end());
+    assert(distinct.size() > 990);
+    std::cout << "test_fill_u32_odd_count passed.\n";
+}
+
+template<typename T>
+void check_bounded(int64_t lo, int64_t hi) {
+    std::vector<T> buffer(5000);
+    RandomKernels::fill_bounded(buffer.data(), buffer.size(), lo, hi);
+
+    bool saw_lo = false;
+    bool saw_hi = false;
+    for (auto v : buffer) {
+        assert(static_cast<int64_t>(v) >= lo && static_cast<int64_t>(v) <= hi);
+        saw_lo |= (static_cast<int64_t>(v) == lo);
+        saw_hi |= (static_cast<int64_t>(v) == hi);
+    }
+    (void)saw_lo;
+    (void)saw_hi;
+    assert(saw_lo && saw_hi);
+}
+
+void test_fill_bounded_narrow_types() {
+    check_bounded<int8_t>(-5, 5);
+    check_bounded<uint8_t>(0, 255);
+    check_bounded<int16_t>(-100, 100);
+    check_bounded<uint16_t>(10, 20);
+    check_bounded<int32_t>(1, 9);
+    check_bounded<uint32_t>(0, 1);
+    check_bounded<int64_t>(-3, 3);
+    std::cout << "test_fill_bounded_narrow_types passed.\n";
+}
+
+void test_fill_bounded_full_ranges() {
+    std::vector<int32_t> i32(1000);
+    RandomKernels::fill_bounded(i32.data(), i32.size(),
+        std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+    bool negative = false;
+    bool positive = false;
+    for (auto v : i32) {
+        negative |= v < 0;
+        positive |= v > 0;
+    }
+    (void)negative;
+    (void)positive;
+    assert(negative && positive);
+
+    std::vector<uint64_t> u64(1000);
+    RandomKernels::fill_bounded(u64.data(), u64.size(), 0, std::numeric_limits<uint64_t>::max());
+    bool high = false;
+    for (auto v : u64) {
+        high |= v > std::numeric_limits<uint32_t>::max();
+    }
+    (void)high;
+    assert(high);
+
+    std::vector<int64_t> i64(1000);
+    const int64_t lo = std::numeric_limits<int64_t>::min() / 2;
+    const int64_t hi = std::numeric_limits<int64_t>::max() / 2;
+    RandomKernels::fill_bounded(i64.data(), i64.size(), lo, hi);
+    for (auto v : i64) {
+        (void)v;
+        assert(v >= lo && v <= hi);
+    }
+    std::cout << "test_fill_bounded_full_ranges passed.\n";
+}
+
+void test_fill_bounded_empty_range() {
+    std::vector<int32_t> buffer(4);
+    try {
+        RandomKernels::fill_bounded(buffer.data(), buffer.size(), 10, 9);
+        assert(false && "Expected exception for empty range");
+    } catch (const std::invalid_argument&) {
+    }
+    std::cout << "test_fill_bounded_empty_range passed.\n";
+}
+
+void test_fill_uniform_float() {
+    std::vector<float> buffer(10000);
+    RandomKernels::fill_uniform(buffer.data(), buffer.size(), -2.0f, 2.0f);
+
+    double sum = 0;
+    for (auto v : buffer) {
+        assert(v >= -2.0f && v < 2.0f);
+        sum += v;
+    }
+    double mean = sum / buffer.size();
+    (void)mean;
+    assert(mean > -0.1 && mean < 0.1);
+    std::cout << "test_fill_uniform_float passed.\n";
+}
+
+void test_fill_uniform_double() {
+    std::vector<double> buffer(10001);
+    RandomKernels::fill_uniform(buffer.data(), buffer.size(), 100.0, 200.0);
+
+    double sum = 0;
+    for (auto v : buffer) {
+        assert(v >= 100.0 && v < 200.0);
+        sum += v;
+    }
+    double mean = sum / buffer.size();
+    (void)mean;
+    assert(mean > 148.0 && mean < 152.0);
+    std::cout << "test_fill_uniform_double passed.\n";
+}
+
+void test_fill_bool() {
+    std::vector<char> raw(10000);
+    bool* buffer = reinterpret_cast<bool*>(raw.data());
+    RandomKernels::fill_bool(buffer, raw.size());
+
+    size_t trues = 0;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        assert(raw[i] == 0 || raw[i] == 1);
+        trues += buffer[i] ? 1 : 0;
+    }
+    (void)trues;
+    assert(trues > 4500 && trues < 5500);
+    std::cout << "test_fill_bool passed.\n";
+}
+
+void test_fill_mask() {
+    std::vector<uint64_t> masks(1000);
+
+    RandomKernels::fill_mask(masks.data(), masks.size(), 0.0);
+    for (auto m : masks) { (void)m; assert(m == 0); }
+
+    RandomKernels::fill_mask(masks.data(), masks.size(), 1.0);
+    for (auto m : masks) { (void)m; assert(m == ~uint64_t{0}); }
+
+    for (double p : {0.05, 0.25, 0.7}) {
+        RandomKernels::fill_mask(masks.data(), masks.size(), p);
+        size_t bits = 0;
+        for (auto m : masks) bits += __builtin_popcountll(m);
+        double ratio = static_cast<double>(bits) / (masks.size() * 64);
+        (void)ratio;
+        assert(ratio > p - 0.01 && ratio < p + 0.01);
+    }
+
+    std::cout << "test_fill_mask passed.\n";
+}
+
+void test_counter_mode() {
+    // Philox4x32-10 known answer: counter 0, key 0
+    {
+        RandomKernels::CounterScope scope(uint64_t{0});
+        assert(scope.active());
+        assert(RandomKernels::counter_mode());
+        scope.seek(0, 0);
+        uint32_t words[4];
+        RandomKernels::fill_u32(words, 4);
+        assert(words[0] == 0x6627e8d5u && words[1] == 0xe169c58du);
+        assert(words[2] == 0xbc57ac4cu && words[3] == 0x9b00dbd8u);
+    }
+    assert(!RandomKernels::counter_mode());
+
+    // Draws depend only on (key, row, column), not on what ran before
+    auto draw = [](uint64_t key, uint64_t row, uint32_t column) {
+        RandomKernels::CounterScope scope(key);
+        scope.seek(row, column);
+        std::vector<int32_t> values(10);
+        RandomKernels::fill_bounded(values.data(), values.size(), 0, 1000000);
+        values.push_back(static_cast<int32_t>(RandomKernels::next_u32()));
+        return values;
+    };
+
+    const uint64_t key = RandomKernels::stream_key(42, "d0");
+    auto first = draw(key, 7, 3);
+    draw(key, 8, 3);
+    assert(draw(key, 7, 3) == first);
+    assert(draw(key, 8, 3) != first);
+    assert(draw(key, 7, 4) != first);
+    assert(draw(RandomKernels::stream_key(42, "d1"), 7, 3) != first);
+    assert(draw(RandomKernels::stream_key(43, "d0"), 7, 3) != first);
+
+    // An empty key leaves the thread streams in place
+    {
+        RandomKernels::CounterScope scope(std::nullopt);
+        assert(!scope.active());
+        assert(!RandomKernels::counter_mode());
+    }
+
+    std::cout << "test_counter_mode passed.\n";
+}
+
+int main() {
+    test_active_isa();
+    test_fill_u32_odd_count();
+    test_fill_bounded_narrow_types();
+    test_fill_bounded_full_ranges();
+    test_fill_bounded_empty_range();
+    test_fill_uniform_float();
+    test_fill_uniform_double();
+    test_fill_bool();
+    test_fill_mask();
+    test_counter_mode();
+
+    std::cout << "All tests passed.\n";
+    return 0;
+}
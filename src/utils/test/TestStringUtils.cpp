@@ -0,0 +1,137 @@
+#include "StringUtils.hpp"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+void test_case_and_trim() {
+    assert(StringUtils::to_lower("AbC") == "abc");
+    assert(StringUtils::to_upper("AbC") == "ABC");
+
+    std::string s = "  a b \t";
+    StringUtils::trim(s);
+    assert(s == "a b");
+    StringUtils::remove_all_spaces(s);
+    assert(s == "ab");
+
+    std::cout << "test_case_and_trim passed." << std::endl;
+}
+
+void test_utf16_round_trip() {
+    const std::string ascii = "sensor-01";
+    assert(StringUtils::utf8_to_u16string(ascii) == u"sensor-01");
+    assert(StringUtils::u16string_to_utf8(u"sensor-01") == ascii);
+
+    const std::string mixed = "北京 Beijing é 😀";
+    std::u16string wide = StringUtils::utf8_to_u16string(mixed);
+    assert(wide == u"北京 Beijing é 😀");
+    assert(StringUtils::u16string_to_utf8(wide) == mixed);
+
+    assert(StringUtils::utf8_to_u16string("").empty());
+    assert(StringUtils::u16string_to_utf8(u"").empty());
+
+    std::cout << "test_utf16_round_trip passed." << std::endl;
+}
+
+void test_utf8_in_place() {
+    char buffer[16];
+
+    // Whole characters only: 5 bytes fit "a北" but not the next 3-byte character
+    size_t len = StringUtils::u16string_to_utf8(u"a北京", buffer, 5);
+    (void)len;
+    assert(len == 4);
+    assert(std::string(buffer, len) == "a北");
+
+    len = StringUtils::u16string_to_utf8(u"😀", buffer, 3);
+    assert(len == 0);
+    len = StringUtils::u16string_to_utf8(u"😀", buffer, 4);
+    assert(len == 4);
+
+    std::cout << "test_utf8_in_place passed." << std::endl;
+}
+
+void test_invalid_input() {
+    bool caught = false;
+    try {
+        StringUtils::utf8_to_u16string(std::string("\xff\xfe", 2));
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+
+    caught = false;
+    try {
+        std::u16string lone(1, static_cast<char16_t>(0xD800));
+        StringUtils::u16string_to_utf8(lone);
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    assert(caught);
+    (void)caught;
+
+    // The cached converter recovers after a failed call
+    assert(StringUtils::utf8_to_u16string("北京") == u"北京");
+
+    std::cout << "test_invalid_input passed." << std::endl;
+}
+
+void test_concurrent_conversion() {
+    std::vector<std::thread> threads;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &ok]() {
+            const std::string text = "温度-" + std::to_string(t);
+            for (int i = 0; i < 1000; ++i) {
+                if (StringUtils::u16string_to_utf8(StringUtils::utf8_to_u16string(text)) != text) return;
+            }
+            ok[t] = 1;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int v : ok) {
+        (void)v;
+        assert(v == 1);
+    }
+
+    std::cout << "test_concurrent_conversion passed." << std::endl;
+}
+
+void test_byte_size() {
+    assert(StringUtils::parse_byte_size("65536") == 65536);
+    assert(StringUtils::parse_byte_size("8GB") == (size_t(8) << 30));
+    assert(StringUtils::parse_byte_size("512 MiB") == (size_t(512) << 20));
+    assert(StringUtils::parse_byte_size(" 4k ") == 4096);
+    assert(StringUtils::parse_byte_size("1tb") == (size_t(1) << 40));
+    assert(StringUtils::parse_byte_size("100B") == 100);
+
+    for (const char* bad : {"", "GB", "-1GB", "8PB", "1.5GB", "99999999999TB"}) {
+        bool caught = false;
+        try {
+            StringUtils::parse_byte_size(bad);
+        } catch (const std::invalid_argument&) {
+            caught = true;
+        }
+        assert(caught);
+        (void)caught;
+    }
+
+    assert(StringUtils::format_byte_size(100) == "100 B");
+    assert(StringUtils::format_byte_size(1536) == "1.50 KB");
+    assert(StringUtils::format_byte_size(size_t(8) << 30) == "8.00 GB");
+
+    std::cout << "test_byte_size passed." << std::endl;
+}
+
+int main() {
+    test_case_and_trim();
+    test_utf16_round_trip();
+    test_utf8_in_place();
+    test_invalid_input();
+    test_concurrent_conversion();
+    test_byte_size();
+
+    std::cout << "All StringUtils tests passed." << std::endl;
+    return 0;
+}
@@ -147,6 +147,26 @@ void test_precision_conversion() {
     std::cout << "test_precision_conversion passed\n";
 }
 
+void test_precision_converter() {
+    TimestampUtils::PrecisionConverter same("ms", "ms");
+    assert(same.identity());
+    assert(same(1234) == 1234);
+
+    TimestampUtils::PrecisionConverter up("ms", "ns");
+    assert(!up.identity());
+    assert(up(1000) == TimestampUtils::convert_timestamp_precision(1000, "ms", "ns"));
+
+    TimestampUtils::PrecisionConverter down("us", "ms");
+    int64_t values[] = {1999, 2000, -1500};
+    down.apply(values, 3);
+    assert(values[0] == 1 && values[1] == 2);
+    assert(values[2] == TimestampUtils::convert_timestamp_precision(-1500, "us", "ms"));
+
+    TimestampUtils::PrecisionConverter none;
+    assert(none.identity());
+    std::cout << "test_precision_converter passed\n";
+}
+
 void test_parse_timestamp_iso_utc_z() {
     int64_t result = TimestampUtils::parse_timestamp("2023-01-01T00:00:00Z", "s");
 #if defined(_WIN32)
@@ -262,6 +282,7 @@ int main() {
     test_parse_timestamp_iso_string();
     test_precision_multiplier();
     test_precision_conversion();
+    test_precision_converter();
     test_parse_timestamp_iso_utc_z();
     test_parse_timestamp_invalid_inputs();
     test_parse_step_basic();